@@ -0,0 +1,158 @@
+#ifndef DMIF_TRACE_CPP
+#define DMIF_TRACE_CPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "LogHelper.cpp"
+#include "../src/ndnSIM/ndn-cxx/src/name.hpp"
+using namespace std;
+
+class DmifTraceEvent {
+public:
+	enum {
+		InterestCsMiss = 1,   // Interest entered onContentStoreMiss
+		DirectiveNotForUs = 2, // Directive Interest addressed to another node
+		PitHitDrop = 3,       // Interest already pending
+		ModeNotSetDrop = 4,   // Interest without a forwarding mode
+		ModeSet = 5,          // forwarding mode chosen after the DMIF FIB lookup
+		OutgoingInterest = 6,
+		IncomingData = 7,
+		OutgoingData = 8,
+		FibMatch = 9,         // DMIF FIB lookup found (name, forwarderId)
+		FibMiss = 10
+	};
+};
+
+/**
+ * Fixed-width DMIF trace record, written in host byte order.
+ * Decode with tools/dmif-trace-decode.py.
+ */
+struct DmifTraceRecord {
+	int64_t time;         // simulation time, nanoseconds
+	uint64_t nameHash;    // std::hash<ndn::Name>
+	uint64_t faceId;
+	uint32_t nodeId;
+	uint32_t forwarderId;
+	uint8_t event;        // DmifTraceEvent
+	uint8_t mode;         // ForwardingMode
+	uint8_t reserved[6];
+};
+
+static_assert(sizeof(DmifTraceRecord) == 40, "DmifTraceRecord layout is part of the file format");
+
+/**
+ * Append-buffered binary trace of DMIF forwarding decisions.
+ *
+ * Disabled unless the DMIF_TRACE environment variable names an output file or
+ * Open() is called. The file starts with a 16-byte header (magic "DMIFTR01",
+ * record size, reserved) followed by DmifTraceRecord entries. Records are
+ * buffered and written when the buffer is full, on Simulator::Destroy and at
+ * process exit.
+ */
+class DmifTrace {
+public:
+	static DmifTrace& Get() {
+		static DmifTrace trace;
+		return trace;
+	}
+
+	~DmifTrace() {
+		Close();
+	}
+
+	bool IsEnabled() const {
+		return m_enabled;
+	}
+
+	void Open(const std::string& fileName) {
+		Close();
+
+		m_file.open(fileName, fstream::out | fstream::binary | fstream::trunc);
+		if (!m_file.is_open())
+			return;
+
+		char header[16] = "DMIFTR01";
+		uint32_t recordSize = sizeof(DmifTraceRecord);
+		std::memcpy(header + 8, &recordSize, sizeof(recordSize));
+		m_file.write(header, sizeof(header));
+		m_enabled = true;
+	}
+
+	void Close() {
+		Flush();
+		if (m_file.is_open())
+			m_file.close();
+		m_enabled = false;
+	}
+
+	static void Record(uint8_t event, uint8_t mode, uint32_t forwarderId,
+			const ndn::Name& name, uint64_t faceId) {
+		DmifTrace& trace = Get();
+		if (!trace.m_enabled)
+			return;
+
+		trace.Append(event, mode, forwarderId, std::hash<ndn::Name>()(name), faceId);
+	}
+
+	void Flush() {
+		if (m_records.empty())
+			return;
+
+		if (m_file.is_open()) {
+			m_file.write(reinterpret_cast<const char*>(m_records.data()),
+					m_records.size() * sizeof(DmifTraceRecord));
+			m_file.flush();
+		}
+		m_records.clear();
+	}
+
+private:
+	DmifTrace() {
+		m_records.reserve(CAPACITY);
+
+		const char* fileName = std::getenv("DMIF_TRACE");
+		if (fileName != nullptr && *fileName != '\0')
+			Open(fileName);
+	}
+
+	void Append(uint8_t event, uint8_t mode, uint32_t forwarderId, uint64_t nameHash,
+			uint64_t faceId) {
+		if (!m_flushScheduled) {
+			m_flushScheduled = true;
+			ns3::Simulator::ScheduleDestroy(&DmifTrace::FlushOnDestroy);
+		}
+
+		DmifTraceRecord record;
+		std::memset(&record, 0, sizeof(record));
+		record.time = ns3::Simulator::Now().GetNanoSeconds();
+		record.nameHash = nameHash;
+		record.faceId = faceId;
+		record.nodeId = static_cast<uint32_t>(LogHelper::GetNodeId());
+		record.forwarderId = forwarderId;
+		record.event = event;
+		record.mode = mode;
+		m_records.push_back(record);
+
+		if (m_records.size() >= CAPACITY)
+			Flush();
+	}
+
+	static void FlushOnDestroy() {
+		DmifTrace& trace = Get();
+		trace.Flush();
+		trace.m_flushScheduled = false;
+	}
+
+private:
+	static const size_t CAPACITY = 65536;
+
+	bool m_enabled = false;
+	bool m_flushScheduled = false;
+	fstream m_file;
+	std::vector<DmifTraceRecord> m_records;
+};
+#endif
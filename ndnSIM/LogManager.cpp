@@ -3,163 +3,106 @@
 
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <string>
+#include <vector>
 #include "LogHelper.cpp"
+#include "LogSink.cpp"
 using namespace std;
 
+/**
+ * Leveled logging with the node id prefix. The expression is only evaluated
+ * when the level is compiled in and enabled at runtime for the current node
+ * and component, so disabled call sites never build their strings:
+ *
+ *   DMIF_LOG_DEBUG("forwarder.cpp", "onIncomingData.name:" << data.getName());
+ */
+#define DMIF_LOG(level, component, expression)                                   \
+	do {                                                                         \
+		if ((level) <= DMIF_LOG_MAX_LEVEL &&                                     \
+				LogSink::Get().IsEnabled((level), (component))) {                \
+			std::ostringstream dmifLogStream;                                    \
+			dmifLogStream << "NodeId=" << LogHelper::GetNodeId() << ": "         \
+					<< (component) << "->" << expression;                        \
+			LogSink::Get().Write(dmifLogStream.str());                           \
+		}                                                                        \
+	} while (false)
+
+#define DMIF_LOG_ERROR(component, expression) DMIF_LOG(LogLevel::Error, component, expression)
+#define DMIF_LOG_WARN(component, expression) DMIF_LOG(LogLevel::Warn, component, expression)
+#define DMIF_LOG_INFO(component, expression) DMIF_LOG(LogLevel::Info, component, expression)
+#define DMIF_LOG_DEBUG(component, expression) DMIF_LOG(LogLevel::Debug, component, expression)
+#define DMIF_LOG_TRACE(component, expression) DMIF_LOG(LogLevel::Trace, component, expression)
+
 class LogManager {
 public:
 	//Logging without NodeID
-	static void AddLog(std::string message) {
-		std::string fileName = "./CppLogs.txt";
-		fstream myfile;
-		myfile.open(fileName, fstream::app);
-		if (myfile.is_open()) {
-			myfile << message << endl;
-			myfile.close();
-		}
-	}
-	static void AddLog(std::string message, int number) {
-		std::string fileName = "./CppLogs.txt";
-		fstream myfile;
-		myfile.open(fileName, fstream::app);
-		if (myfile.is_open()) {
-			myfile << message << ":" << number << endl;
-			myfile.close();
-		}
-	}
-	static void AddLog(std::string message, uint32_t number) {
-		std::string fileName = "./CppLogs.txt";
-		fstream myfile;
-		myfile.open(fileName, fstream::app);
-		if (myfile.is_open()) {
-			myfile << message << ":" << number << endl;
-			myfile.close();
-		}
-	}
-	static void AddLog(std::string message, bool number) {
-		std::string fileName = "./CppLogs.txt";
-		fstream myfile;
-		myfile.open(fileName, fstream::app);
-		if (myfile.is_open()) {
-			myfile << message << ":" << number << endl;
-			myfile.close();
-		}
-	}
-	static void AddLog(std::string message, std::string value) {
-		std::string fileName = "./CppLogs.txt";
-		fstream myfile;
-		myfile.open(fileName, fstream::app);
-		if (myfile.is_open()) {
-			myfile << message << ":" << value << endl;
-			myfile.close();
-		}
+	template<typename Message>
+	static void AddLog(const Message& message) {
+		if (!IsEnabled(message))
+			return;
+
+		std::ostringstream line;
+		line << message;
+		LogSink::Get().Write(line.str());
 	}
-	static void AddLog(std::string message, std::vector<std::string> value) {
-		std::string fileName = "./CppLogs.txt";
-		fstream myfile;
-		myfile.open(fileName, fstream::app);
-		if (myfile.is_open()) {
-			std::string temp = "";
-			for(unsigned int i = 0; i < (unsigned)value.size(); i++)
-				temp += value[i];
-
-			myfile << message << ":" << temp << endl;
-			myfile.close();
-		}
+
+	template<typename Message, typename Value>
+	static void AddLog(const Message& message, const Value& value) {
+		if (!IsEnabled(message))
+			return;
+
+		std::ostringstream line;
+		line << message << ":";
+		Append(line, value);
+		LogSink::Get().Write(line.str());
 	}
 
 	//Logging with NodeID
-	static void AddLogWithNodeId(std::string message) {
-		std::string fileName = "./CppLogs.txt";
-		fstream myfile;
-		myfile.open(fileName, fstream::app);
-		if (myfile.is_open()) {
-			myfile << "NodeId=" << LogHelper::GetNodeId() << ": " << message<< endl;
-			myfile.close();
-		}
-	}
-	static void AddLogWithNodeId(std::string message, int number) {
-		std::string fileName = "./CppLogs.txt";
-		fstream myfile;
-		myfile.open(fileName, fstream::app);
-		if (myfile.is_open()) {
-			myfile << "NodeId=" << LogHelper::GetNodeId() << ": " << message << ":" << number << endl;
-			myfile.close();
-		}
-	}
-	static void AddLogWithNodeId(std::string message, uint32_t number) {
-		std::string fileName = "./CppLogs.txt";
-		fstream myfile;
-		myfile.open(fileName, fstream::app);
-		if (myfile.is_open()) {
-			myfile << "NodeId=" << LogHelper::GetNodeId() << ": " << message << ":" << number << endl;
-			myfile.close();
-		}
+	template<typename Message>
+	static void AddLogWithNodeId(const Message& message) {
+		if (!IsEnabled(message))
+			return;
+
+		std::ostringstream line;
+		line << "NodeId=" << LogHelper::GetNodeId() << ": " << message;
+		LogSink::Get().Write(line.str());
 	}
-	static void AddLogWithNodeId(std::string message, uint64_t number) {
-		std::string fileName = "./CppLogs.txt";
-		fstream myfile;
-		myfile.open(fileName, fstream::app);
-		if (myfile.is_open()) {
-			myfile << "NodeId=" << LogHelper::GetNodeId() << ": " << message << ":" << number << endl;
-			myfile.close();
-		}
+
+	template<typename Message, typename Value>
+	static void AddLogWithNodeId(const Message& message, const Value& value) {
+		if (!IsEnabled(message))
+			return;
+
+		std::ostringstream line;
+		line << "NodeId=" << LogHelper::GetNodeId() << ": " << message << ":";
+		Append(line, value);
+		LogSink::Get().Write(line.str());
 	}
-	static void AddLogWithNodeId(std::string message, uint8_t* number) {
-		std::string fileName = "./CppLogs.txt";
-		fstream myfile;
-		myfile.open(fileName, fstream::app);
-		if (myfile.is_open()) {
-			myfile << "NodeId=" << LogHelper::GetNodeId() << ": " << message << ":" << number << endl;
-			myfile.close();
-		}
+
+	//Writes buffered lines to the log file; also done on Simulator::Destroy and at exit
+	static void Flush() {
+		LogSink::Get().Flush();
 	}
-	static void AddLogWithNodeId(std::string message, bool number) {
-		std::string fileName = "./CppLogs.txt";
-		fstream myfile;
-		myfile.open(fileName, fstream::app);
-		if (myfile.is_open()) {
-			myfile << "NodeId=" << LogHelper::GetNodeId() << ": " << message << ":" << number << endl;
-			myfile.close();
-		}
+
+private:
+	// the AddLog* family logs at Debug level
+	template<typename Message>
+	static bool IsEnabled(const Message& message) {
+		if (LogLevel::Debug > DMIF_LOG_MAX_LEVEL)
+			return false;
+
+		return LogSink::Get().IsEnabledForMessage(LogLevel::Debug, message);
 	}
-	static void AddLogWithNodeId(std::string message, std::string value) {
-		std::string fileName = "./CppLogs.txt";
-		fstream myfile;
-		myfile.open(fileName, fstream::app);
-		if (myfile.is_open()) {
-			myfile << "NodeId=" << LogHelper::GetNodeId() << ": " << message << ":" << value << endl;
-			myfile.close();
-		}
+
+	template<typename Value>
+	static void Append(std::ostream& os, const Value& value) {
+		os << value;
 	}
-	static void AddLogWithNodeId(std::string message, std::vector<std::string> value) {
-		std::string fileName = "./CppLogs.txt";
-		fstream myfile;
-		myfile.open(fileName, fstream::app);
-		if (myfile.is_open()) {
-			std::string temp = "";
-			for(unsigned int i = 0; i < (unsigned)value.size(); i++)
-				temp += value[i];
-
-			myfile << "NodeId=" << LogHelper::GetNodeId() << ": " << message << ":" << temp << endl;
-			myfile.close();
-		}
+
+	static void Append(std::ostream& os, const std::vector<std::string>& value) {
+		for (unsigned int i = 0; i < (unsigned)value.size(); i++)
+			os << value[i];
 	}
-	/*Sample code to log with current time
-	#include <time.h>
-	#include <chrono>
-	static void AddLog(std::string message) {
-			std::string fileName = "./CppLogs.txt";
-			fstream myfile;
-			myfile.open(fileName, fstream::app);
-			if (myfile.is_open()) {
-				auto time = std::chrono::system_clock::now();
-				std::time_t currentTime = std::chrono::system_clock::to_time_t(time);
-				myfile << message << " | " << std::ctime(&currentTime);
-				myfile<<"NodeId="<<LogHelper::GetNodeId()<<": "<<message<<endl;
-				myfile.close();
-			}
-		} */
 };
 #endif
@@ -0,0 +1,250 @@
+#ifndef LOG_SINK_CPP
+#define LOG_SINK_CPP
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include "LogHelper.cpp"
+using namespace std;
+
+class LogLevel {
+public:
+	enum {
+		None = 0,
+		Error = 1,
+		Warn = 2,
+		Info = 3,
+		Debug = 4,
+		Trace = 5
+	};
+};
+
+// Call sites above this level are removed by the compiler; their
+// arguments are never evaluated. Override with -DDMIF_LOG_MAX_LEVEL=<n>.
+#ifndef DMIF_LOG_MAX_LEVEL
+#define DMIF_LOG_MAX_LEVEL 5
+#endif
+
+/**
+ * Per-process buffered log sink used by LogManager.
+ *
+ * Lines are appended to an in-memory buffer and written to the log file only
+ * when the buffer is full, when the simulation is destroyed, or when the
+ * process exits. The runtime level and the node/component filters are read
+ * once from the DMIF_LOG environment variable, e.g.
+ *
+ *   DMIF_LOG="level=info:nodes=0,4,7:components=forwarder.cpp,bf-controller.cpp:file=./CppLogs.txt:buffer=1048576"
+ *
+ * Every field is optional; without DMIF_LOG everything up to Debug is written
+ * to ./CppLogs.txt as before.
+ */
+class LogSink {
+public:
+	static LogSink& Get() {
+		static LogSink sink;
+		return sink;
+	}
+
+	~LogSink() {
+		Flush();
+	}
+
+	bool IsEnabled(int level, const char* component) {
+		if (level > m_level)
+			return false;
+
+		if (!m_nodes.empty() && m_nodes.count(LogHelper::GetNodeId()) == 0)
+			return false;
+
+		if (!m_components.empty() && component != nullptr && m_components.count(component) == 0)
+			return false;
+
+		return true;
+	}
+
+	// legacy messages are prefixed with "<component>->"; the prefix is matched
+	// in place, so filtered-out messages are never copied or formatted
+	bool IsEnabledForMessage(int level, const char* message) {
+		if (!IsEnabled(level, nullptr))
+			return false;
+
+		if (m_components.empty())
+			return true;
+
+		const char* end = std::strstr(message, "->");
+		return HasComponent(message, end != nullptr ? end - message : std::strlen(message));
+	}
+
+	bool IsEnabledForMessage(int level, const std::string& message) {
+		if (!IsEnabled(level, nullptr))
+			return false;
+
+		if (m_components.empty())
+			return true;
+
+		return HasComponent(message.data(), std::min(message.find("->"), message.size()));
+	}
+
+	template<typename Message>
+	bool IsEnabledForMessage(int level, const Message& message) {
+		if (!IsEnabled(level, nullptr))
+			return false;
+
+		if (m_components.empty())
+			return true;
+
+		std::ostringstream os;
+		os << message;
+		return IsEnabledForMessage(level, os.str());
+	}
+
+	void Write(const std::string& line) {
+		ScheduleFlushOnDestroy();
+
+		m_buffer.append(line);
+		m_buffer.push_back('\n');
+		if (m_buffer.size() >= m_capacity)
+			Flush();
+	}
+
+	void Flush() {
+		if (m_buffer.empty())
+			return;
+
+		if (!m_file.is_open())
+			m_file.open(m_fileName, fstream::app);
+
+		if (m_file.is_open()) {
+			m_file.write(m_buffer.data(), m_buffer.size());
+			m_file.flush();
+		}
+		m_buffer.clear();
+	}
+
+	void SetLevel(int level) {
+		m_level = level;
+	}
+
+	int GetLevel() const {
+		return m_level;
+	}
+
+	void EnableNode(int nodeId) {
+		m_nodes.insert(nodeId);
+	}
+
+	void EnableComponent(const std::string& component) {
+		m_components.insert(component);
+	}
+
+	void ClearFilters() {
+		m_nodes.clear();
+		m_components.clear();
+	}
+
+	void SetFileName(const std::string& fileName) {
+		Flush();
+		m_file.close();
+		m_fileName = fileName;
+	}
+
+	void SetBufferSize(size_t capacity) {
+		m_capacity = capacity;
+		m_buffer.reserve(m_capacity);
+	}
+
+private:
+	LogSink() {
+		const char* config = std::getenv("DMIF_LOG");
+		if (config != nullptr)
+			Configure(config);
+
+		m_buffer.reserve(m_capacity);
+	}
+
+	void Configure(const std::string& config) {
+		std::istringstream fields(config);
+		std::string field;
+		while (std::getline(fields, field, ':')) {
+			size_t pos = field.find('=');
+			if (pos == std::string::npos)
+				continue;
+
+			std::string key = field.substr(0, pos);
+			std::string value = field.substr(pos + 1);
+			if (key == "level")
+				m_level = ParseLevel(value);
+			else if (key == "file")
+				m_fileName = value;
+			else if (key == "buffer")
+				m_capacity = std::strtoul(value.c_str(), nullptr, 10);
+			else if (key == "nodes" || key == "components") {
+				std::istringstream items(value);
+				std::string item;
+				while (std::getline(items, item, ',')) {
+					if (item.empty())
+						continue;
+					if (key == "nodes")
+						m_nodes.insert(std::atoi(item.c_str()));
+					else
+						m_components.insert(item);
+				}
+			}
+		}
+	}
+
+	bool HasComponent(const char* component, size_t length) const {
+		for (const std::string& enabled : m_components) {
+			if (enabled.size() == length && enabled.compare(0, length, component, length) == 0)
+				return true;
+		}
+		return false;
+	}
+
+	static int ParseLevel(const std::string& value) {
+		if (value == "none")
+			return LogLevel::None;
+		if (value == "error")
+			return LogLevel::Error;
+		if (value == "warn")
+			return LogLevel::Warn;
+		if (value == "info")
+			return LogLevel::Info;
+		if (value == "debug")
+			return LogLevel::Debug;
+		if (value == "trace" || value == "all")
+			return LogLevel::Trace;
+		return std::atoi(value.c_str());
+	}
+
+	void ScheduleFlushOnDestroy() {
+		if (m_flushScheduled)
+			return;
+
+		m_flushScheduled = true;
+		ns3::Simulator::ScheduleDestroy(&LogSink::FlushOnDestroy);
+	}
+
+	static void FlushOnDestroy() {
+		LogSink& sink = Get();
+		sink.Flush();
+		// the next simulation run in this process registers again
+		sink.m_flushScheduled = false;
+	}
+
+private:
+	int m_level = LogLevel::Debug;
+	std::set<int> m_nodes;
+	std::set<std::string> m_components;
+	std::string m_fileName = "./CppLogs.txt";
+	size_t m_capacity = 1 << 20;
+	std::string m_buffer;
+	fstream m_file;
+	bool m_flushScheduled = false;
+};
+#endif
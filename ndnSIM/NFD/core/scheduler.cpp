@@ -32,17 +32,26 @@ namespace nfd {
 namespace scheduler {
 
 static boost::thread_specific_ptr<Scheduler> g_scheduler;
+static Scheduler::Backend g_backend = Scheduler::Backend::SIMULATOR;
 
 Scheduler&
 getGlobalScheduler()
 {
   if (g_scheduler.get() == nullptr) {
-    g_scheduler.reset(new Scheduler(*static_cast<boost::asio::io_service*>(nullptr)));
+    g_scheduler.reset(new Scheduler(*static_cast<boost::asio::io_service*>(nullptr), g_backend));
+    // events must not outlive the simulation, and a new simulation starts with a new scheduler
+    ns3::Simulator::ScheduleDestroy(&resetGlobalScheduler);
   }
 
   return *g_scheduler;
 }
 
+void
+setGlobalSchedulerBackend(Scheduler::Backend backend)
+{
+  g_backend = backend;
+}
+
 EventId
 schedule(time::nanoseconds after, const EventCallback& event)
 {
@@ -52,7 +61,11 @@ schedule(time::nanoseconds after, const EventCallback& event)
 void
 cancel(const EventId& eventId)
 {
-  getGlobalScheduler().cancelEvent(eventId);
+  // events of a scheduler that was reset with the simulator are gone already
+  if (g_scheduler.get() == nullptr) {
+    return;
+  }
+  g_scheduler->cancelEvent(eventId);
 }
 
 void
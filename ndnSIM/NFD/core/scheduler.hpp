@@ -51,9 +51,31 @@ schedule(time::nanoseconds after, const EventCallback& event);
 void
 cancel(const EventId& eventId);
 
+/** \brief the scheduler shared by NFD in this thread
+ *
+ *  It is created on first use, and reset when the simulator is destroyed.
+ */
 Scheduler&
 getGlobalScheduler();
 
+/** \brief destroy the global scheduler of this thread, cancelling its events
+ *
+ *  A new one is created on next use.
+ */
+void
+resetGlobalScheduler();
+
+/** \brief choose how the global scheduler keeps its events
+ *
+ *  Takes effect when the global scheduler is next created, i.e. before the first event of a
+ *  simulation is scheduled. The default is Scheduler::Backend::SIMULATOR.
+ *  Scheduler::Backend::TIMER_WHEEL makes scheduling and cancelling cheaper with many PIT
+ *  timers, but NFD timers are then no longer ordered against other ns-3 events that
+ *  expire at the same simulation time.
+ */
+void
+setGlobalSchedulerBackend(Scheduler::Backend backend);
+
 /** \brief cancels an event automatically upon destruction
  */
 class ScopedEventId : noncopyable
@@ -90,6 +90,11 @@ public: // upper interface connected to forwarding
   void
   sendData(const Data& data);
 
+  /** \brief sends Data on Face, with the fields of \p delivery in place of its tags
+   */
+  void
+  sendData(const Data& data, const DataDelivery& delivery);
+
   /** \brief sends Nack on Face
    */
   void
@@ -223,6 +228,12 @@ Face::sendData(const Data& data)
   m_service->sendData(data);
 }
 
+inline void
+Face::sendData(const Data& data, const DataDelivery& delivery)
+{
+  m_service->sendData(data, delivery);
+}
+
 inline void
 Face::sendNack(const lp::Nack& nack)
 {
@@ -25,9 +25,11 @@
 
 #include "generic-link-service.hpp"
 
+#include <ndn-cxx/dmif-header.hpp>
 #include <ndn-cxx/lp/tags.hpp>
 
 #include <cmath>
+#include <cstring>
 
 namespace nfd {
 namespace face {
@@ -44,6 +46,7 @@ GenericLinkService::Options::Options()
   , baseCongestionMarkingInterval(time::milliseconds(100)) // Interval from RFC 8289 (CoDel)
   , defaultCongestionThreshold(65536) // This default value works well for a queue capacity of 200KiB
   , allowSelfLearning(false)
+  , allowDmifUnicast(false)
 {
 }
 
@@ -80,7 +83,7 @@ GenericLinkService::requestIdlePacket()
 }
 
 void
-GenericLinkService::sendLpPacket(lp::Packet&& pkt)
+GenericLinkService::sendLpPacket(lp::Packet&& pkt, Transport::EndpointId endpoint)
 {
   const ssize_t mtu = this->getTransport()->getMtu();
 
@@ -93,6 +96,7 @@ GenericLinkService::sendLpPacket(lp::Packet&& pkt)
   }
 
   Transport::Packet tp(pkt.wireEncode());
+  tp.remoteEndpoint = endpoint;
   if (mtu != MTU_UNLIMITED && tp.packet.size() > static_cast<size_t>(mtu)) {
     ++this->nOutOverMtu;
     NFD_LOG_FACE_WARN("attempted to send packet over MTU limit");
@@ -108,15 +112,15 @@ GenericLinkService::doSendInterest(const Interest& interest)
 
   encodeLpFields(interest, lpPacket);
 
-  this->sendNetPacket(std::move(lpPacket), true);
+  this->sendNetPacket(std::move(lpPacket), true, findDmifEndpoint(interest));
 }
 
 void
-GenericLinkService::doSendData(const Data& data)
+GenericLinkService::doSendData(const Data& data, const DataDelivery& delivery)
 {
   lp::Packet lpPacket(data.wireEncode());
 
-  encodeLpFields(data, lpPacket);
+  encodeLpFields(data, delivery, lpPacket);
 
   this->sendNetPacket(std::move(lpPacket), false);
 }
@@ -134,11 +138,17 @@ GenericLinkService::doSendNack(const lp::Nack& nack)
 
 void
 GenericLinkService::encodeLpFields(const ndn::PacketBase& netPkt, lp::Packet& lpPacket)
+{
+  encodeLpFields(netPkt, DataDelivery::fromTags(netPkt), lpPacket);
+}
+
+void
+GenericLinkService::encodeLpFields(const ndn::PacketBase& netPkt, const DataDelivery& delivery,
+                                   lp::Packet& lpPacket)
 {
   if (m_options.allowLocalFields) {
-    shared_ptr<lp::IncomingFaceIdTag> incomingFaceIdTag = netPkt.getTag<lp::IncomingFaceIdTag>();
-    if (incomingFaceIdTag != nullptr) {
-      lpPacket.add<lp::IncomingFaceIdField>(*incomingFaceIdTag);
+    if (delivery.incomingFaceId) {
+      lpPacket.add<lp::IncomingFaceIdField>(*delivery.incomingFaceId);
     }
   }
 
@@ -159,9 +169,8 @@ GenericLinkService::encodeLpFields(const ndn::PacketBase& netPkt, lp::Packet& lp
     }
   }
 
-  shared_ptr<lp::HopCountTag> hopCountTag = netPkt.getTag<lp::HopCountTag>();
-  if (hopCountTag != nullptr) {
-    lpPacket.add<lp::HopCountTagField>(*hopCountTag);
+  if (delivery.hopCount) {
+    lpPacket.add<lp::HopCountTagField>(*delivery.hopCount);
   }
   else {
     lpPacket.add<lp::HopCountTagField>(0);
@@ -169,7 +178,7 @@ GenericLinkService::encodeLpFields(const ndn::PacketBase& netPkt, lp::Packet& lp
 }
 
 void
-GenericLinkService::sendNetPacket(lp::Packet&& pkt, bool isInterest)
+GenericLinkService::sendNetPacket(lp::Packet&& pkt, bool isInterest, Transport::EndpointId endpoint)
 {
   std::vector<lp::Packet> frags;
   ssize_t mtu = this->getTransport()->getMtu();
@@ -221,10 +230,39 @@ GenericLinkService::sendNetPacket(lp::Packet&& pkt, bool isInterest)
   }
 
   for (lp::Packet& frag : frags) {
-    this->sendLpPacket(std::move(frag));
+    this->sendLpPacket(std::move(frag), endpoint);
+  }
+}
+
+/****** DMIF ******/
+Transport::EndpointId
+GenericLinkService::findDmifEndpoint(const Interest& interest) const
+{
+  if (!m_options.allowDmifUnicast || interest.getForwardingMode() != ForwardingMode::Directive) {
+    return 0;
   }
+
+  auto it = m_dmifNeighbors.find(interest.getForwarderId());
+  return it == m_dmifNeighbors.end() ? 0 : it->second;
 }
 
+void
+GenericLinkService::learnDmifNeighbor(const Block& netPkt, Transport::EndpointId endpoint)
+{
+  if (endpoint == 0 || netPkt.type() != tlv::Data) {
+    return;
+  }
+
+  // only the ForwarderId is read; decodeData reuses the parsed elements
+  netPkt.parse();
+  uint32_t forwarderId = 0;
+  if (!ndn::dmif::peekForwarderId(netPkt, forwarderId)) {
+    return;
+  }
+  m_dmifNeighbors[forwarderId] = endpoint;
+}
+/****** DMIF ******/
+
 void
 GenericLinkService::assignSequence(lp::Packet& pkt)
 {
@@ -317,6 +355,9 @@ GenericLinkService::doReceivePacket(Transport::Packet&& packet)
     std::tie(isReassembled, netPkt, firstPkt) = m_reassembler.receiveFragment(packet.remoteEndpoint,
                                                                               pkt);
     if (isReassembled) {
+      if (m_options.allowDmifUnicast) {
+        this->learnDmifNeighbor(netPkt, packet.remoteEndpoint);
+      }
       this->decodeNetPacket(netPkt, firstPkt);
     }
   }
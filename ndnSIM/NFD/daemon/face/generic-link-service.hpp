@@ -140,6 +140,13 @@ public:
     /** \brief enables self-learning forwarding support
      */
     bool allowSelfLearning;
+
+    /** \brief sends Directive-mode DMIF Interests only to the neighbor named by their ForwarderId
+     *
+     *  The remote endpoint of each neighbor is learned from the ForwarderId of Data it sends.
+     *  Interests for a neighbor not learned yet, and all other packets, go to the whole link.
+     */
+    bool allowDmifUnicast;
   };
 
   /** \brief counters provided by GenericLinkService
@@ -170,9 +177,10 @@ PROTECTED_WITH_TESTS_ELSE_PRIVATE: // send path
 
   /** \brief send an LpPacket fragment
    *  \param pkt LpPacket to send
+   *  \param endpoint remote endpoint to send to; 0 sends to the whole link
    */
   void
-  sendLpPacket(lp::Packet&& pkt);
+  sendLpPacket(lp::Packet&& pkt, Transport::EndpointId endpoint = 0);
 
   /** \brief send Interest
    */
@@ -182,7 +190,7 @@ PROTECTED_WITH_TESTS_ELSE_PRIVATE: // send path
   /** \brief send Data
    */
   void
-  doSendData(const Data& data) override;
+  doSendData(const Data& data, const DataDelivery& delivery) override;
 
   /** \brief send Nack
    */
@@ -197,12 +205,28 @@ private: // send path
   void
   encodeLpFields(const ndn::PacketBase& netPkt, lp::Packet& lpPacket);
 
+  /** \brief encode link protocol fields onto an outgoing LpPacket
+   *  \param netPkt network-layer packet to extract tags from
+   *  \param delivery IncomingFaceId and HopCount, which are not taken from tags
+   *  \param lpPacket LpPacket to add link protocol fields to
+   */
+  void
+  encodeLpFields(const ndn::PacketBase& netPkt, const DataDelivery& delivery,
+                 lp::Packet& lpPacket);
+
   /** \brief send a complete network layer packet
    *  \param pkt LpPacket containing a complete network layer packet
    *  \param isInterest whether the network layer packet is an Interest
+   *  \param endpoint remote endpoint to send all fragments to; 0 sends to the whole link
    */
   void
-  sendNetPacket(lp::Packet&& pkt, bool isInterest);
+  sendNetPacket(lp::Packet&& pkt, bool isInterest, Transport::EndpointId endpoint = 0);
+
+  /** \brief remote endpoint of the neighbor a Directive-mode Interest is addressed to
+   *  \return 0 if the Interest is not Directive or its ForwarderId has not been learned
+   */
+  Transport::EndpointId
+  findDmifEndpoint(const Interest& interest) const;
 
   /** \brief assign a sequence number to an LpPacket
    */
@@ -227,6 +251,11 @@ private: // receive path
   void
   doReceivePacket(Transport::Packet&& packet) override;
 
+  /** \brief remember @p endpoint as the neighbor named by the ForwarderId of Data @p netPkt
+   */
+  void
+  learnDmifNeighbor(const Block& netPkt, Transport::EndpointId endpoint);
+
   /** \brief decode incoming network-layer packet
    *  \param netPkt reassembled network-layer packet
    *  \param firstPkt LpPacket of first fragment
@@ -279,6 +308,8 @@ PROTECTED_WITH_TESTS_ELSE_PRIVATE:
   LpReassembler m_reassembler;
   LpReliability m_reliability;
   lp::Sequence m_lastSeqNo;
+  /// DMIF: ForwarderId => remote endpoint of that neighbor
+  std::unordered_map<uint32_t, Transport::EndpointId> m_dmifNeighbors;
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /// CongestionMark TLV-TYPE (3 octets) + CongestionMark TLV-LENGTH (1 octet) + sizeof(uint64_t)
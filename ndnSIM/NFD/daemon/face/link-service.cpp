@@ -27,11 +27,28 @@
 #include "face.hpp"
 #include "../src/ndnSIM/LogManager.cpp"
 
+#include <ndn-cxx/lp/tags.hpp>
+
 namespace nfd {
 namespace face {
 
 NFD_LOG_INIT("LinkService");
 
+DataDelivery
+DataDelivery::fromTags(const ndn::PacketBase& pkt)
+{
+  DataDelivery delivery;
+  shared_ptr<lp::IncomingFaceIdTag> incomingFaceIdTag = pkt.getTag<lp::IncomingFaceIdTag>();
+  if (incomingFaceIdTag != nullptr) {
+    delivery.incomingFaceId = incomingFaceIdTag->get();
+  }
+  shared_ptr<lp::HopCountTag> hopCountTag = pkt.getTag<lp::HopCountTag>();
+  if (hopCountTag != nullptr) {
+    delivery.hopCount = hopCountTag->get();
+  }
+  return delivery;
+}
+
 LinkService::LinkService()
   : m_face(nullptr)
   , m_transport(nullptr)
@@ -69,6 +86,12 @@ LinkService::sendInterest(const Interest& interest)
 
 void
 LinkService::sendData(const Data& data)
+{
+  sendData(data, DataDelivery::fromTags(data));
+}
+
+void
+LinkService::sendData(const Data& data, const DataDelivery& delivery)
 {
 	LogManager::AddLogWithNodeId("link-service.cpp->sendData.start");
   BOOST_ASSERT(m_transport != nullptr);
@@ -76,7 +99,7 @@ LinkService::sendData(const Data& data)
 
   ++this->nOutData;
 
-  doSendData(data);
+  doSendData(data, delivery);
 
   afterSendData(data);
   LogManager::AddLogWithNodeId("link-service.cpp->sendData.completed");
@@ -35,6 +35,27 @@ namespace face {
 
 class Face;
 
+/** \brief fields of one transmission of a Data packet
+ *
+ *  A Data in the ContentStore is shared by every transmission of it, so the fields that differ
+ *  between transmissions are carried next to the packet instead of as tags on it.
+ */
+struct DataDelivery
+{
+  /** \brief fields carried as IncomingFaceIdTag and HopCountTag by \p pkt
+   */
+  static DataDelivery
+  fromTags(const ndn::PacketBase& pkt);
+
+  /** \brief face on which the Data was received, or FACEID_CONTENT_STORE
+   */
+  ndn::optional<uint64_t> incomingFaceId;
+
+  /** \brief HopCountTag of the Data as received, none if it did not cross a link
+   */
+  ndn::optional<uint64_t> hopCount;
+};
+
 /** \brief counters provided by LinkService
  *  \note The type name 'LinkServiceCounters' is implementation detail.
  *        Use 'LinkService::Counters' in public API.
@@ -118,12 +139,18 @@ public: // upper interface to be used by forwarding
   void
   sendInterest(const Interest& interest);
 
-  /** \brief send Data
+  /** \brief send Data, with the fields of its tags
    *  \pre setTransport has been called
    */
   void
   sendData(const Data& data);
 
+  /** \brief send Data, with the fields of \p delivery in place of its tags
+   *  \pre setTransport has been called
+   */
+  void
+  sendData(const Data& data, const DataDelivery& delivery);
+
   /** \brief send Nack
    *  \pre setTransport has been called
    */
@@ -197,9 +224,11 @@ private: // upper interface to be overridden in subclass (send path entrypoint)
   doSendInterest(const Interest& interest) = 0;
 
   /** \brief performs LinkService specific operations to send a Data
+   *
+   *  IncomingFaceId and HopCount are taken from \p delivery, not from the tags of \p data.
    */
   virtual void
-  doSendData(const Data& data) = 0;
+  doSendData(const Data& data, const DataDelivery& delivery) = 0;
 
   /** \brief performs LinkService specific operations to send a Nack
    */
@@ -88,18 +88,24 @@ LpReassembler::receiveFragment(Transport::EndpointId remoteEndpoint, const lp::P
   Key key = std::make_tuple(remoteEndpoint, messageIdentifier);
 
   // add to PartialPacket
-  PartialPacket& pp = m_partialPackets[key];
-  if (pp.fragCount == 0) { // new PartialPacket
+  auto now = time::steady_clock::now();
+  auto ppIt = m_partialPackets.find(key);
+  if (ppIt == m_partialPackets.end()) { // new PartialPacket
+    ppIt = m_partialPackets.emplace(key, PartialPacket()).first;
+    PartialPacket& pp = ppIt->second;
     pp.fragCount = fragCount;
     pp.nReceivedFragments = 0;
     pp.fragments.resize(fragCount);
-  }
-  else {
-    if (fragCount != pp.fragCount) {
-      NFD_LOG_FACE_WARN("reassembly error, FragCount changed: DROP");
-      return FALSE_RETURN;
+    pp.dropTime = now + m_options.reassemblyTimeout;
+    if (this->enqueueDropTimeout(pp.dropTime, key)) {
+      this->scheduleDropTimer();
     }
   }
+  PartialPacket& pp = ppIt->second;
+  if (fragCount != pp.fragCount) {
+    NFD_LOG_FACE_WARN("reassembly error, FragCount changed: DROP");
+    return FALSE_RETURN;
+  }
 
   if (pp.fragments[fragIndex].has<lp::SequenceField>()) {
     NFD_LOG_FACE_TRACE("fragment already received: DROP");
@@ -111,24 +117,21 @@ LpReassembler::receiveFragment(Transport::EndpointId remoteEndpoint, const lp::P
 
   // check complete condition
   if (pp.nReceivedFragments == pp.fragCount) {
-    Block reassembled = doReassembly(key);
+    Block reassembled = doReassembly(pp);
     lp::Packet firstFrag(std::move(pp.fragments[0]));
-    m_partialPackets.erase(key);
+    m_partialPackets.erase(ppIt);
     return std::make_tuple(true, reassembled, firstFrag);
   }
 
-  // set drop timer
-  pp.dropTimer = scheduler::schedule(m_options.reassemblyTimeout,
-                                     bind(&LpReassembler::timeoutPartialPacket, this, key));
+  // extend drop timeout; the pending entry in m_dropQueue is moved when it expires
+  pp.dropTime = now + m_options.reassemblyTimeout;
 
   return FALSE_RETURN;
 }
 
 Block
-LpReassembler::doReassembly(const Key& key)
+LpReassembler::doReassembly(const PartialPacket& pp)
 {
-  PartialPacket& pp = m_partialPackets[key];
-
   size_t payloadSize = std::accumulate(pp.fragments.begin(), pp.fragments.end(), 0,
     [&] (size_t sum, const lp::Packet& pkt) -> size_t {
       ndn::Buffer::const_iterator fragBegin, fragEnd;
@@ -148,16 +151,62 @@ LpReassembler::doReassembly(const Key& key)
   return Block(&*(fragBuffer.cbegin()), std::distance(fragBuffer.cbegin(), fragBuffer.cend()));
 }
 
+bool
+LpReassembler::enqueueDropTimeout(time::steady_clock::TimePoint dropTime, const Key& key)
+{
+  // timeouts are normally enqueued in order, unless Options::reassemblyTimeout was shortened
+  auto pos = m_dropQueue.end();
+  if (!m_dropQueue.empty() && m_dropQueue.back().first > dropTime) {
+    pos = std::upper_bound(m_dropQueue.begin(), m_dropQueue.end(), dropTime,
+      [] (time::steady_clock::TimePoint t, const DropQueue::value_type& entry) {
+        return t < entry.first;
+      });
+  }
+
+  bool isEarliest = pos == m_dropQueue.begin();
+  m_dropQueue.emplace(pos, dropTime, key);
+  return isEarliest;
+}
+
 void
-LpReassembler::timeoutPartialPacket(const Key& key)
+LpReassembler::scheduleDropTimer()
 {
-  auto it = m_partialPackets.find(key);
-  if (it == m_partialPackets.end()) {
+  if (m_dropQueue.empty()) {
+    m_dropTimer.cancel();
     return;
   }
 
-  this->beforeTimeout(std::get<0>(key), it->second.nReceivedFragments);
-  m_partialPackets.erase(it);
+  auto after = m_dropQueue.front().first - time::steady_clock::now();
+  m_dropTimer = scheduler::schedule(std::max(time::nanoseconds::zero(),
+                                             time::duration_cast<time::nanoseconds>(after)),
+                                    bind(&LpReassembler::onDropTimerExpired, this));
+}
+
+void
+LpReassembler::onDropTimerExpired()
+{
+  auto now = time::steady_clock::now();
+  while (!m_dropQueue.empty() && m_dropQueue.front().first <= now) {
+    Key key = m_dropQueue.front().second;
+    m_dropQueue.pop_front();
+
+    auto it = m_partialPackets.find(key);
+    if (it == m_partialPackets.end()) {
+      // reassembled before timeout
+      continue;
+    }
+
+    if (it->second.dropTime > now) {
+      // more fragments were received since this entry was enqueued
+      this->enqueueDropTimeout(it->second.dropTime, key);
+      continue;
+    }
+
+    this->beforeTimeout(std::get<0>(key), it->second.nReceivedFragments);
+    m_partialPackets.erase(it);
+  }
+
+  this->scheduleDropTimer();
 }
 
 std::ostream&
@@ -32,6 +32,11 @@
 
 #include <ndn-cxx/lp/packet.hpp>
 
+#include <boost/functional/hash.hpp>
+
+#include <deque>
+#include <unordered_map>
+
 namespace nfd {
 namespace face {
 
@@ -111,7 +116,7 @@ private:
     std::vector<lp::Packet> fragments;
     size_t fragCount; ///< total fragments
     size_t nReceivedFragments; ///< number of received fragments
-    scheduler::ScopedEventId dropTimer;
+    time::steady_clock::TimePoint dropTime; ///< when the partial packet times out
   };
 
   /** \brief index key for PartialPackets
@@ -121,15 +126,38 @@ private:
     lp::Sequence // message identifier (sequence of the first fragment)
   > Key;
 
+  /** \brief pending drop timeouts, ordered by time
+   *
+   *  A partial packet is enqueued once, when created. When its entry reaches the head of the
+   *  queue and the partial packet has received more fragments since, it is enqueued again
+   *  at its current drop time instead of being dropped.
+   */
+  typedef std::deque<std::pair<time::steady_clock::TimePoint, Key>> DropQueue;
+
   Block
-  doReassembly(const Key& key);
+  doReassembly(const PartialPacket& pp);
 
+  /** \brief enqueue a drop timeout
+   *  \return whether the timeout became the earliest one
+   */
+  bool
+  enqueueDropTimeout(time::steady_clock::TimePoint dropTime, const Key& key);
+
+  /** \brief schedule the drop timer at the earliest pending timeout
+   */
+  void
+  scheduleDropTimer();
+
+  /** \brief drop partial packets whose timeout has expired
+   */
   void
-  timeoutPartialPacket(const Key& key);
+  onDropTimerExpired();
 
 private:
   Options m_options;
-  std::map<Key, PartialPacket> m_partialPackets;
+  std::unordered_map<Key, PartialPacket, boost::hash<Key>> m_partialPackets;
+  DropQueue m_dropQueue;
+  scheduler::ScopedEventId m_dropTimer;
   const LinkService* m_linkService;
 };
 
@@ -34,6 +34,8 @@ LpReliability::LpReliability(const LpReliability::Options& options, GenericLinkS
   : m_options(options)
   , m_linkService(linkService)
   , m_firstUnackedFrag(m_unackedFrags.begin())
+  , m_nRtoTimersStarted(0)
+  , m_rtoTimerExpiry(time::steady_clock::TimePoint::max())
   , m_lastTxSeqNo(-1) // set to "-1" to start TxSequence numbers at 0
   , m_isIdleAckTimerRunning(false)
 {
@@ -65,7 +67,6 @@ LpReliability::handleOutgoing(std::vector<lp::Packet>& frags, lp::Packet&& pkt,
 {
   BOOST_ASSERT(m_options.isEnabled);
 
-  auto unackedFragsIt = m_unackedFrags.begin();
   auto sendTime = time::steady_clock::now();
 
   auto netPkt = make_shared<NetPkt>(std::move(pkt), isInterest);
@@ -76,14 +77,10 @@ LpReliability::handleOutgoing(std::vector<lp::Packet>& frags, lp::Packet&& pkt,
     lp::Sequence txSeq = assignTxSequence(frag);
 
     // Store LpPacket for future retransmissions
-    unackedFragsIt = m_unackedFrags.emplace_hint(unackedFragsIt,
-                                                 std::piecewise_construct,
-                                                 std::forward_as_tuple(txSeq),
-                                                 std::forward_as_tuple(frag));
+    auto unackedFragsIt = m_unackedFrags.emplace(txSeq, frag);
     unackedFragsIt->second.sendTime = sendTime;
-    unackedFragsIt->second.rtoTimer =
-      scheduler::schedule(m_rto.computeRto(), bind(&LpReliability::onLpPacketLost, this, unackedFragsIt));
     unackedFragsIt->second.netPkt = netPkt;
+    this->startRtoTimer(txSeq);
 
     if (m_unackedFrags.size() == 1) {
       m_firstUnackedFrag = m_unackedFrags.begin();
@@ -102,6 +99,7 @@ LpReliability::processIncomingPacket(const lp::Packet& pkt)
   auto now = time::steady_clock::now();
 
   // Extract and parse Acks
+  std::vector<UnackedFrags::iterator> ackedFrags;
   for (lp::Sequence ackSeq : pkt.list<lp::AckField>()) {
     auto fragIt = m_unackedFrags.find(ackSeq);
     if (fragIt == m_unackedFrags.end()) {
@@ -110,26 +108,41 @@ LpReliability::processIncomingPacket(const lp::Packet& pkt)
     }
     auto& frag = fragIt->second;
 
-    // Cancel the RTO timer for the acknowledged fragment
-    frag.rtoTimer.cancel();
-
     if (frag.retxCount == 0) {
       // This sequence had no retransmissions, so use it to calculate the RTO
       m_rto.addMeasurement(time::duration_cast<RttEstimator::Duration>(now - frag.sendTime));
     }
 
-    // Look for frags with TxSequence numbers < ackSeq (allowing for wraparound) and consider them
-    // lost if a configurable number of Acks containing greater TxSequence numbers have been
-    // received.
-    auto lostLpPackets = findLostLpPackets(fragIt);
+    ackedFrags.push_back(fragIt);
+  }
 
-    // Remove the fragment from the map of unacknowledged fragments and from its associated network
-    // packet. Potentially increment the start of the window.
-    onLpPacketAcknowledged(fragIt);
+  if (!ackedFrags.empty()) {
+    // Sort the Acks by position in the window (allowing for wraparound) and drop duplicates
+    lp::Sequence windowStart = m_firstUnackedFrag->first;
+    std::sort(ackedFrags.begin(), ackedFrags.end(),
+      [windowStart] (UnackedFrags::iterator a, UnackedFrags::iterator b) {
+        return a->first - windowStart < b->first - windowStart;
+      });
+    ackedFrags.erase(std::unique(ackedFrags.begin(), ackedFrags.end()), ackedFrags.end());
+
+    // Look for frags with TxSequence numbers < acknowledged ones (allowing for wraparound) and
+    // consider them lost if a configurable number of Acks containing greater TxSequence numbers
+    // have been received.
+    auto lostLpPackets = findLostLpPackets(ackedFrags);
+
+    // Remove the fragments from the unacknowledged fragments and from their associated network
+    // packets. Potentially increment the start of the window.
+    for (UnackedFrags::iterator fragIt : ackedFrags) {
+      this->onLpPacketAcknowledged(fragIt);
+    }
 
     // Resend or fail fragments considered lost. Potentially increment the start of the window.
-    for (UnackedFrags::iterator txSeqIt : lostLpPackets) {
-      this->onLpPacketLost(txSeqIt);
+    for (lp::Sequence txSeq : lostLpPackets) {
+      auto txSeqIt = m_unackedFrags.find(txSeq);
+      // a fragment is gone if an earlier lost fragment of the same network packet was given up on
+      if (txSeqIt != m_unackedFrags.end()) {
+        this->onLpPacketLost(txSeqIt);
+      }
     }
   }
 
@@ -206,25 +219,89 @@ LpReliability::stopIdleAckTimer()
   m_isIdleAckTimerRunning = false;
 }
 
-std::vector<LpReliability::UnackedFrags::iterator>
-LpReliability::findLostLpPackets(LpReliability::UnackedFrags::iterator ackIt)
+void
+LpReliability::startRtoTimer(lp::Sequence txSeq)
+{
+  auto expiry = time::steady_clock::now() + m_rto.computeRto();
+  m_rtoQueue.push({expiry, m_nRtoTimersStarted++, txSeq});
+
+  if (expiry < m_rtoTimerExpiry) {
+    this->scheduleRtoTimer();
+  }
+}
+
+void
+LpReliability::scheduleRtoTimer()
+{
+  // discard timeouts of fragments that are no longer unacknowledged under that TxSequence
+  while (!m_rtoQueue.empty() && m_unackedFrags.count(m_rtoQueue.top().txSeq) == 0) {
+    m_rtoQueue.pop();
+  }
+
+  if (m_rtoQueue.empty()) {
+    m_rtoTimer.cancel();
+    m_rtoTimerExpiry = time::steady_clock::TimePoint::max();
+    return;
+  }
+
+  auto expiry = m_rtoQueue.top().expiry;
+  if (expiry == m_rtoTimerExpiry) {
+    return;
+  }
+
+  m_rtoTimerExpiry = expiry;
+  m_rtoTimer = scheduler::schedule(std::max(time::nanoseconds::zero(),
+                                            time::duration_cast<time::nanoseconds>(
+                                              expiry - time::steady_clock::now())),
+                                   bind(&LpReliability::onRtoTimerExpired, this));
+}
+
+void
+LpReliability::onRtoTimerExpired()
 {
-  std::vector<UnackedFrags::iterator> lostLpPackets;
+  m_rtoTimerExpiry = time::steady_clock::TimePoint::max();
 
-  for (auto it = m_firstUnackedFrag; ; ++it) {
+  auto now = time::steady_clock::now();
+  std::vector<lp::Sequence> expired;
+  while (!m_rtoQueue.empty() && m_rtoQueue.top().expiry <= now) {
+    expired.push_back(m_rtoQueue.top().txSeq);
+    m_rtoQueue.pop();
+  }
+
+  for (lp::Sequence txSeq : expired) {
+    auto txSeqIt = m_unackedFrags.find(txSeq);
+    if (txSeqIt != m_unackedFrags.end()) {
+      this->onLpPacketLost(txSeqIt);
+    }
+  }
+
+  this->scheduleRtoTimer();
+}
+
+std::vector<lp::Sequence>
+LpReliability::findLostLpPackets(const std::vector<UnackedFrags::iterator>& ackedFrags)
+{
+  std::vector<lp::Sequence> lostLpPackets;
+
+  size_t nGreaterSeqAcks = ackedFrags.size();
+  auto nextAck = ackedFrags.begin();
+  for (lp::Sequence txSeq = m_firstUnackedFrag->first; nextAck != ackedFrags.end(); ++txSeq) {
+    auto it = m_unackedFrags.find(txSeq);
     if (it == m_unackedFrags.end()) {
-      it = m_unackedFrags.begin();
+      continue;
     }
 
-    if (it->first == ackIt->first) {
-      break;
+    if (it == *nextAck) {
+      --nGreaterSeqAcks;
+      ++nextAck;
+      continue;
     }
 
     auto& unackedFrag = it->second;
-    unackedFrag.nGreaterSeqAcks++;
+    unackedFrag.nGreaterSeqAcks += nGreaterSeqAcks;
 
     if (unackedFrag.nGreaterSeqAcks >= m_options.seqNumLossThreshold) {
-      lostLpPackets.push_back(it);
+      lostLpPackets.push_back(txSeq);
     }
   }
 
@@ -237,7 +314,6 @@ LpReliability::onLpPacketLost(UnackedFrags::iterator txSeqIt)
   BOOST_ASSERT(m_unackedFrags.count(txSeqIt->first) > 0);
 
   auto& txFrag = txSeqIt->second;
-  txFrag.rtoTimer.cancel();
   auto netPkt = txFrag.netPkt;
 
   // Check if maximum number of retransmissions exceeded
@@ -268,13 +344,7 @@ LpReliability::onLpPacketLost(UnackedFrags::iterator txSeqIt)
     netPkt->didRetx = true;
 
     // Move fragment to new TxSequence mapping
-    auto newTxFragIt = m_unackedFrags.emplace_hint(
-      m_firstUnackedFrag != m_unackedFrags.end() && m_firstUnackedFrag->first > newTxSeq
-        ? m_firstUnackedFrag
-        : m_unackedFrags.end(),
-      std::piecewise_construct,
-      std::forward_as_tuple(newTxSeq),
-      std::forward_as_tuple(txFrag.pkt));
+    auto newTxFragIt = m_unackedFrags.emplace(newTxSeq, txFrag.pkt);
     auto& newTxFrag = newTxFragIt->second;
     newTxFrag.retxCount = txFrag.retxCount + 1;
     newTxFrag.netPkt = netPkt;
@@ -290,8 +360,7 @@ LpReliability::onLpPacketLost(UnackedFrags::iterator txSeqIt)
     m_linkService->sendLpPacket(lp::Packet(newTxFrag.pkt));
 
     // Start RTO timer for this sequence
-    newTxFrag.rtoTimer = scheduler::schedule(m_rto.computeRto(),
-                                          bind(&LpReliability::onLpPacketLost, this, newTxFragIt));
+    this->startRtoTimer(newTxSeq);
   }
 }
 
@@ -322,21 +391,16 @@ LpReliability::onLpPacketAcknowledged(UnackedFrags::iterator fragIt)
 void
 LpReliability::deleteUnackedFrag(UnackedFrags::iterator fragIt)
 {
-  lp::Sequence firstUnackedTxSeq = m_firstUnackedFrag->first;
-  lp::Sequence currentTxSeq = fragIt->first;
-  auto nextFragIt = m_unackedFrags.erase(fragIt);
-
-  if (!m_unackedFrags.empty() && firstUnackedTxSeq == currentTxSeq) {
-    // If "first" fragment in send window (allowing for wraparound), increment window begin
-    if (nextFragIt == m_unackedFrags.end()) {
-      m_firstUnackedFrag = m_unackedFrags.begin();
-    }
-    else {
-      m_firstUnackedFrag = nextFragIt;
-    }
-  }
-  else if (m_unackedFrags.empty()) {
-    m_firstUnackedFrag = m_unackedFrags.end();
+  // If "first" fragment in send window (allowing for wraparound), the window begin is advanced
+  // to the next remaining fragment, or to end() if none remains
+  m_unackedFrags.erase(fragIt);
+  m_firstUnackedFrag = m_unackedFrags.begin();
+
+  if (m_unackedFrags.empty()) {
+    // all pending timeouts are stale
+    m_rtoQueue = RtoQueue();
+    m_rtoTimer.cancel();
+    m_rtoTimerExpiry = time::steady_clock::TimePoint::max();
   }
 }
 
@@ -348,6 +412,72 @@ LpReliability::UnackedFrag::UnackedFrag(lp::Packet pkt)
 {
 }
 
+LpReliability::UnackedFrags::UnackedFrags()
+  : m_firstTxSeq(0)
+  , m_size(0)
+  , m_pool(sizeof(value_type))
+{
+}
+
+LpReliability::UnackedFrags::~UnackedFrags()
+{
+  for (iterator it : m_slots) {
+    if (it != nullptr) {
+      it->~value_type();
+    }
+  }
+}
+
+LpReliability::UnackedFrag&
+LpReliability::UnackedFrags::at(lp::Sequence txSeq) const
+{
+  iterator it = this->find(txSeq);
+  if (it == nullptr) {
+    BOOST_THROW_EXCEPTION(std::out_of_range("TxSequence is not unacknowledged"));
+  }
+  return it->second;
+}
+
+LpReliability::UnackedFrags::iterator
+LpReliability::UnackedFrags::emplace(lp::Sequence txSeq, const lp::Packet& pkt)
+{
+  if (m_slots.empty()) {
+    m_firstTxSeq = txSeq;
+  }
+
+  lp::Sequence offset = txSeq - m_firstTxSeq;
+  BOOST_ASSERT(offset >= m_slots.size());
+  m_slots.resize(offset + 1, nullptr);
+
+  void* mem = m_pool.malloc();
+  if (mem == nullptr) {
+    BOOST_THROW_EXCEPTION(std::bad_alloc());
+  }
+  iterator it = new (mem) value_type(std::piecewise_construct,
+                                     std::forward_as_tuple(txSeq),
+                                     std::forward_as_tuple(pkt));
+  m_slots.back() = it;
+  ++m_size;
+  return it;
+}
+
+void
+LpReliability::UnackedFrags::erase(iterator it)
+{
+  lp::Sequence offset = it->first - m_firstTxSeq;
+  BOOST_ASSERT(offset < m_slots.size() && m_slots[offset] == it);
+
+  it->~value_type();
+  m_pool.free(it);
+  m_slots[offset] = nullptr;
+  --m_size;
+
+  while (!m_slots.empty() && m_slots.front() == nullptr) {
+    m_slots.pop_front();
+    ++m_firstTxSeq;
+  }
+}
+
 LpReliability::NetPkt::NetPkt(lp::Packet&& pkt, bool isInterest)
   : pkt(std::move(pkt))
   , isInterest(isInterest)
@@ -32,6 +32,9 @@
 #include <ndn-cxx/lp/packet.hpp>
 #include <ndn-cxx/lp/sequence.hpp>
 
+#include <boost/pool/pool.hpp>
+
+#include <deque>
 #include <queue>
 
 namespace nfd {
@@ -105,9 +108,140 @@ public:
   piggyback(lp::Packet& pkt, ssize_t mtu);
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
-  class UnackedFrag;
   class NetPkt;
-  using UnackedFrags = std::map<lp::Sequence, UnackedFrag>;
+
+  /** \brief contains a sent fragment that has not been acknowledged and associated data
+   */
+  class UnackedFrag
+  {
+  public:
+    explicit
+    UnackedFrag(lp::Packet pkt);
+
+  public:
+    lp::Packet pkt;
+    time::steady_clock::TimePoint sendTime;
+    size_t retxCount;
+    size_t nGreaterSeqAcks; //!< number of Acks received for sequences greater than this fragment
+    shared_ptr<NetPkt> netPkt;
+  };
+
+  /** \brief unacknowledged fragments indexed by TxSequence
+   *
+   *  TxSequence numbers are assigned consecutively, so the fragments in the send window are kept
+   *  in a ring of slots covering the TxSequence range from the start of the window to the last
+   *  assigned TxSequence, and looked up by their offset from the start of the window. Emptied slots
+   *  at the start of the window are released as the window advances. Fragments themselves are
+   *  allocated from a pool and do not move, so iterators stay valid until the fragment is erased.
+   */
+  class UnackedFrags : noncopyable
+  {
+  public:
+    using value_type = std::pair<const lp::Sequence, UnackedFrag>;
+    using iterator = value_type*;
+
+    UnackedFrags();
+
+    ~UnackedFrags();
+
+    size_t
+    size() const
+    {
+      return m_size;
+    }
+
+    bool
+    empty() const
+    {
+      return m_size == 0;
+    }
+
+    /** \return the fragment at the start of the window, or end() if empty
+     */
+    iterator
+    begin() const
+    {
+      return m_slots.empty() ? nullptr : m_slots.front();
+    }
+
+    iterator
+    end() const
+    {
+      return nullptr;
+    }
+
+    iterator
+    find(lp::Sequence txSeq) const
+    {
+      lp::Sequence offset = txSeq - m_firstTxSeq;
+      return offset < m_slots.size() ? m_slots[offset] : nullptr;
+    }
+
+    size_t
+    count(lp::Sequence txSeq) const
+    {
+      return this->find(txSeq) == nullptr ? 0 : 1;
+    }
+
+    /** \throw std::out_of_range no fragment with this TxSequence
+     */
+    UnackedFrag&
+    at(lp::Sequence txSeq) const;
+
+    /** \brief insert a fragment at the end of the window
+     *  \pre txSeq follows all TxSequence numbers in the window
+     */
+    iterator
+    emplace(lp::Sequence txSeq, const lp::Packet& pkt);
+
+    /** \brief erase a fragment, advancing the start of the window past emptied slots
+     *  \param it iterator to an UnackedFrag, must be dereferencable
+     */
+    void
+    erase(iterator it);
+
+  private:
+    std::deque<iterator> m_slots; ///< fragments by TxSequence offset, nullptr for erased ones
+    lp::Sequence m_firstTxSeq; ///< TxSequence of m_slots.front()
+    size_t m_size;
+    boost::pool<> m_pool;
+  };
+
+  /** \brief contains a network-layer packet with unacknowledged fragments
+   */
+  class NetPkt
+  {
+  public:
+    NetPkt(lp::Packet&& pkt, bool isInterest);
+
+  public:
+    std::vector<UnackedFrags::iterator> unackedFrags;
+    lp::Packet pkt;
+    bool isInterest;
+    bool didRetx;
+  };
+
+  /** \brief a retransmission timeout of a fragment
+   *
+   *  Timeouts of all fragments are kept in one queue and served by a single scheduler event.
+   *  An entry whose TxSequence is no longer unacknowledged (the fragment was acknowledged,
+   *  retransmitted under a new TxSequence, or given up on) is discarded when it reaches the
+   *  head of the queue.
+   */
+  struct RtoEntry
+  {
+    time::steady_clock::TimePoint expiry;
+    uint64_t order; ///< breaks ties in expiry, so that timeouts fire in the order they were set
+    lp::Sequence txSeq;
+
+    bool
+    operator>(const RtoEntry& other) const
+    {
+      return std::tie(expiry, order) > std::tie(other.expiry, other.order);
+    }
+  };
+
+  using RtoQueue = std::priority_queue<RtoEntry, std::vector<RtoEntry>, std::greater<RtoEntry>>;
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /** \brief assign TxSequence number to a fragment
@@ -132,13 +266,35 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   stopIdleAckTimer();
 
+  /** \brief start the retransmission timeout of a fragment
+   *
+   *  The timeout is computed from the current RTO estimate.
+   */
+  void
+  startRtoTimer(lp::Sequence txSeq);
+
+  /** \brief schedule the retransmission timer at the earliest pending timeout, if not already
+   */
+  void
+  scheduleRtoTimer();
+
+  /** \brief declare lost all fragments whose retransmission timeout has expired
+   */
+  void
+  onRtoTimerExpired();
+
   /** \brief find and mark as lost fragments where a configurable number of Acks
    *         (\p m_options.seqNumLossThreshold) have been received for greater TxSequence numbers
-   *  \param ackIt iterator pointing to acknowledged fragment
-   *  \return vector containing iterators to fragments marked lost by this mechanism
+   *  \param ackedFrags iterators to fragments acknowledged by an incoming packet,
+   *                    sorted by position in the window
+   *  \return TxSequence numbers of fragments marked lost by this mechanism
+   *
+   *  The window is scanned once for all Acks of the packet: each unacknowledged fragment
+   *  before the last acknowledged one is credited with the number of Acks for greater
+   *  TxSequence numbers.
    */
-  std::vector<UnackedFrags::iterator>
-  findLostLpPackets(UnackedFrags::iterator ackIt);
+  std::vector<lp::Sequence>
+  findLostLpPackets(const std::vector<UnackedFrags::iterator>& ackedFrags);
 
   /** \brief resend (or give up on) a lost fragment
    */
@@ -165,38 +321,6 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   deleteUnackedFrag(UnackedFrags::iterator fragIt);
 
-PUBLIC_WITH_TESTS_ELSE_PRIVATE:
-  /** \brief contains a sent fragment that has not been acknowledged and associated data
-   */
-  class UnackedFrag
-  {
-  public:
-    explicit
-    UnackedFrag(lp::Packet pkt);
-
-  public:
-    lp::Packet pkt;
-    scheduler::ScopedEventId rtoTimer;
-    time::steady_clock::TimePoint sendTime;
-    size_t retxCount;
-    size_t nGreaterSeqAcks; //!< number of Acks received for sequences greater than this fragment
-    shared_ptr<NetPkt> netPkt;
-  };
-
-  /** \brief contains a network-layer packet with unacknowledged fragments
-   */
-  class NetPkt
-  {
-  public:
-    NetPkt(lp::Packet&& pkt, bool isInterest);
-
-  public:
-    std::vector<UnackedFrags::iterator> unackedFrags;
-    lp::Packet pkt;
-    bool isInterest;
-    bool didRetx;
-  };
-
 public:
   /// TxSequence TLV-TYPE (3 octets) + TxSequence TLV-LENGTH (1 octet) + sizeof(lp::Sequence)
   static constexpr size_t RESERVED_HEADER_SPACE = 3 + 1 + sizeof(lp::Sequence);
@@ -207,10 +331,14 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   UnackedFrags m_unackedFrags;
   /** An iterator that points to the first unacknowledged fragment in the current window. The window
    *  can wrap around so that the beginning of the window is at a TxSequence greater than other
-   *  fragments in the window. When the window is moved past the last item in the iterator, the
-   *  first fragment in the map will become the start of the window.
+   *  fragments in the window.
    */
   UnackedFrags::iterator m_firstUnackedFrag;
+  RtoQueue m_rtoQueue;
+  uint64_t m_nRtoTimersStarted;
+  scheduler::ScopedEventId m_rtoTimer;
+  /// expiry of the scheduled retransmission timer, or TimePoint::max() if not scheduled
+  time::steady_clock::TimePoint m_rtoTimerExpiry;
   std::queue<lp::Sequence> m_ackQueue;
   lp::Sequence m_lastTxSeqNo;
   scheduler::ScopedEventId m_idleAckTimer;
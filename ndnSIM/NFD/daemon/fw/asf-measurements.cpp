@@ -64,25 +64,124 @@ RttStats::computeSrtt(Rtt previousSrtt, Rtt currentRtt)
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-FaceInfo::FaceInfo()
-  : m_isTimeoutScheduled(false)
-  , m_nSilentTimeouts(0)
+const time::nanoseconds FaceInfoTable::SWEEP_INTERVAL = time::seconds(30);
+
+static const time::steady_clock::TimePoint NO_EXPIRY = time::steady_clock::TimePoint::max();
+
+FaceInfoTable::FaceInfoTable()
+  : m_isSweepScheduled(false)
 {
 }
 
-FaceInfo::~FaceInfo()
+FaceInfoTable::~FaceInfoTable()
 {
-  cancelTimeoutEvent();
-  scheduler::cancel(m_measurementExpirationId);
+  for (const scheduler::EventId& id : m_timeoutEvent) {
+    scheduler::cancel(id);
+  }
+}
+
+FaceInfoTable::Row
+FaceInfoTable::insert(NamespaceInfo& ns, FaceId faceId)
+{
+  Row row = static_cast<Row>(m_faceId.size());
+  m_faceId.push_back(faceId);
+  m_namespace.push_back(&ns);
+  m_expiry.push_back(NO_EXPIRY);
+  m_rttStats.emplace_back();
+  m_nSilentTimeouts.push_back(0);
+  m_isTimeoutScheduled.push_back(0);
+  m_timeoutEvent.emplace_back();
+  m_lastInterestName.emplace_back();
+
+  if (!m_isSweepScheduled) {
+    scheduleSweep();
+  }
+  return row;
 }
 
+void
+FaceInfoTable::reset(Row row)
+{
+  scheduler::cancel(m_timeoutEvent[row]);
+  m_expiry[row] = NO_EXPIRY;
+  m_rttStats[row] = RttStats();
+  m_nSilentTimeouts[row] = 0;
+  m_isTimeoutScheduled[row] = 0;
+  m_timeoutEvent[row] = scheduler::EventId();
+  m_lastInterestName[row] = Name();
+}
+
+void
+FaceInfoTable::erase(Row row)
+{
+  BOOST_ASSERT(row < size());
+  NamespaceInfo& ns = *m_namespace[row];
+  ns.m_rows.erase(ns.findRow(m_faceId[row]));
+  scheduler::cancel(m_timeoutEvent[row]);
+
+  Row last = static_cast<Row>(size() - 1);
+  if (row != last) {
+    m_faceId[row] = m_faceId[last];
+    m_namespace[row] = m_namespace[last];
+    m_expiry[row] = m_expiry[last];
+    m_rttStats[row] = m_rttStats[last];
+    m_nSilentTimeouts[row] = m_nSilentTimeouts[last];
+    m_isTimeoutScheduled[row] = m_isTimeoutScheduled[last];
+    m_timeoutEvent[row] = std::move(m_timeoutEvent[last]);
+    m_lastInterestName[row] = std::move(m_lastInterestName[last]);
+
+    NamespaceInfo& movedNs = *m_namespace[row];
+    movedNs.findRow(m_faceId[row])->second = row;
+  }
+
+  m_faceId.pop_back();
+  m_namespace.pop_back();
+  m_expiry.pop_back();
+  m_rttStats.pop_back();
+  m_nSilentTimeouts.pop_back();
+  m_isTimeoutScheduled.pop_back();
+  m_timeoutEvent.pop_back();
+  m_lastInterestName.pop_back();
+}
+
+size_t
+FaceInfoTable::sweep(time::steady_clock::TimePoint now)
+{
+  size_t nErased = 0;
+  // rows are visited backwards, so that the row moved into an erased row has been visited
+  for (size_t row = m_expiry.size(); row-- > 0;) {
+    if (m_expiry[row] <= now) {
+      erase(static_cast<Row>(row));
+      ++nErased;
+    }
+  }
+  return nErased;
+}
+
+void
+FaceInfoTable::scheduleSweep()
+{
+  m_isSweepScheduled = true;
+  m_sweepEvent = scheduler::schedule(SWEEP_INTERVAL, [this] {
+    m_isSweepScheduled = false;
+    size_t nErased = sweep(time::steady_clock::now());
+    NFD_LOG_TRACE("Swept " << nErased << " expired FaceInfo, " << size() << " remaining");
+    if (size() > 0) {
+      scheduleSweep();
+    }
+  });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void
 FaceInfo::setTimeoutEvent(const scheduler::EventId& id, const Name& interestName)
 {
-  if (!m_isTimeoutScheduled) {
-    m_timeoutEventId = id;
-    m_isTimeoutScheduled = true;
-    m_lastInterestName = interestName;
+  if (!isTimeoutScheduled()) {
+    m_table->m_timeoutEvent[m_row] = id;
+    m_table->m_isTimeoutScheduled[m_row] = 1;
+    m_table->m_lastInterestName[m_row] = interestName;
   }
   else {
     BOOST_THROW_EXCEPTION(FaceInfo::Error("Tried to schedule a timeout for a face that already has a timeout scheduled."));
@@ -92,8 +191,8 @@ FaceInfo::setTimeoutEvent(const scheduler::EventId& id, const Name& interestName
 void
 FaceInfo::cancelTimeoutEvent()
 {
-  scheduler::cancel(m_timeoutEventId);
-  m_isTimeoutScheduled = false;
+  scheduler::cancel(m_table->m_timeoutEvent[m_row]);
+  m_table->m_isTimeoutScheduled[m_row] = 0;
 }
 
 void
@@ -105,9 +204,9 @@ FaceInfo::cancelTimeoutEvent(const Name& prefix)
 }
 
 bool
-FaceInfo::doesNameMatchLastInterest(const Name& name)
+FaceInfo::doesNameMatchLastInterest(const Name& name) const
 {
-  return m_lastInterestName.isPrefixOf(name);
+  return m_table->m_lastInterestName[m_row].isPrefixOf(name);
 }
 
 void
@@ -124,79 +223,100 @@ FaceInfo::recordRtt(const shared_ptr<pit::Entry>& pitEntry, const Face& inFace)
   time::steady_clock::Duration steadyRtt = time::steady_clock::now() - outRecord->getLastRenewed();
   RttEstimator::Duration durationRtt = time::duration_cast<RttEstimator::Duration>(steadyRtt);
 
-  m_rttStats.addRttMeasurement(durationRtt);
+  RttStats& rttStats = getRttStats();
+  rttStats.addRttMeasurement(durationRtt);
 
   NFD_LOG_TRACE("Recording RTT for FaceId: " << inFace.getId()
-                                             << " RTT: "    << m_rttStats.getRtt()
-                                             << " SRTT: "   << m_rttStats.getSrtt());
+                                             << " RTT: "    << rttStats.getRtt()
+                                             << " SRTT: "   << rttStats.getSrtt());
 }
 
 void
 FaceInfo::recordTimeout(const Name& interestName)
 {
-  m_rttStats.recordTimeout();
+  getRttStats().recordTimeout();
   cancelTimeoutEvent(interestName);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-NamespaceInfo::NamespaceInfo()
-  : m_isProbingDue(false)
+NamespaceInfo::NamespaceInfo(shared_ptr<FaceInfoTable> table)
+  : m_table(std::move(table))
+  , m_isProbingDue(false)
   , m_hasFirstProbeBeenScheduled(false)
 {
+  BOOST_ASSERT(m_table != nullptr);
 }
 
-FaceInfo*
-NamespaceInfo::getFaceInfo(const fib::Entry& fibEntry, FaceId faceId)
+NamespaceInfo::~NamespaceInfo()
 {
-  FaceInfoTable::iterator it = m_fit.find(faceId);
-
-  if (it != m_fit.end()) {
-    return &it->second;
+  while (!m_rows.empty()) {
+    m_table->erase(m_rows.back().second);
   }
-  else {
-    return nullptr;
+}
+
+std::vector<std::pair<FaceId, FaceInfoTable::Row>>::iterator
+NamespaceInfo::findRow(FaceId faceId)
+{
+  return std::find_if(m_rows.begin(), m_rows.end(),
+                      [faceId] (const std::pair<FaceId, FaceInfoTable::Row>& p) {
+                        return p.first == faceId;
+                      });
+}
+
+FaceInfo
+NamespaceInfo::get(FaceId faceId)
+{
+  auto it = findRow(faceId);
+  if (it == m_rows.end() || m_table->m_expiry[it->second] <= time::steady_clock::now()) {
+    return FaceInfo();
   }
+  return FaceInfo(*m_table, it->second);
 }
 
-FaceInfo&
-NamespaceInfo::getOrCreateFaceInfo(const fib::Entry& fibEntry, FaceId faceId)
+FaceInfo
+NamespaceInfo::insert(FaceId faceId)
 {
-  FaceInfoTable::iterator it = m_fit.find(faceId);
+  auto it = findRow(faceId);
+  if (it != m_rows.end()) {
+    // expired, but not swept yet
+    m_table->reset(it->second);
+    return FaceInfo(*m_table, it->second);
+  }
 
-  FaceInfo* info = nullptr;
+  FaceInfoTable::Row row = m_table->insert(*this, faceId);
+  m_rows.emplace_back(faceId, row);
+  return FaceInfo(*m_table, row);
+}
 
-  if (it == m_fit.end()) {
-    const auto& pair = m_fit.insert(std::make_pair(faceId, FaceInfo()));
-    info = &pair.first->second;
+FaceInfo
+NamespaceInfo::getOrCreateFaceInfo(const fib::Entry& fibEntry, FaceId faceId)
+{
+  FaceInfo info = get(faceId);
 
-    extendFaceInfoLifetime(*info, faceId);
-  }
-  else {
-    info = &it->second;
+  if (!info) {
+    info = insert(faceId);
+    extendFaceInfoLifetime(info, faceId);
   }
 
-  return *info;
+  return info;
 }
 
 void
 NamespaceInfo::expireFaceInfo(FaceId faceId)
 {
-  m_fit.erase(faceId);
+  auto it = findRow(faceId);
+  if (it != m_rows.end()) {
+    m_table->erase(it->second);
+  }
 }
 
 void
-NamespaceInfo::extendFaceInfoLifetime(FaceInfo& info, FaceId faceId)
+NamespaceInfo::extendFaceInfoLifetime(FaceInfo info, FaceId faceId)
 {
-  // Cancel previous expiration
-  scheduler::cancel(info.getMeasurementExpirationEventId());
-
-  // Refresh measurement
-  scheduler::EventId id = scheduler::schedule(AsfMeasurements::MEASUREMENTS_LIFETIME,
-    bind(&NamespaceInfo::expireFaceInfo, this, faceId));
-
-  info.setMeasurementExpirationEventId(id);
+  BOOST_ASSERT(info.m_table == m_table.get() && info.getFaceId() == faceId);
+  m_table->m_expiry[info.m_row] = time::steady_clock::now() + AsfMeasurements::MEASUREMENTS_LIFETIME;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -206,17 +326,18 @@ constexpr time::microseconds AsfMeasurements::MEASUREMENTS_LIFETIME;
 
 AsfMeasurements::AsfMeasurements(MeasurementsAccessor& measurements)
   : m_measurements(measurements)
+  , m_faceInfoTable(make_shared<FaceInfoTable>())
 {
 }
 
-FaceInfo*
+FaceInfo
 AsfMeasurements::getFaceInfo(const fib::Entry& fibEntry, const Interest& interest, FaceId faceId)
 {
   NamespaceInfo& info = getOrCreateNamespaceInfo(fibEntry, interest);
   return info.getFaceInfo(fibEntry, faceId);
 }
 
-FaceInfo&
+FaceInfo
 AsfMeasurements::getOrCreateFaceInfo(const fib::Entry& fibEntry, const Interest& interest,
                                      FaceId faceId)
 {
@@ -235,7 +356,7 @@ AsfMeasurements::getNamespaceInfo(const Name& prefix)
   // Set or update entry lifetime
   extendLifetime(*me);
 
-  NamespaceInfo* info = me->insertStrategyInfo<NamespaceInfo>().first;
+  NamespaceInfo* info = me->insertStrategyInfo<NamespaceInfo>(m_faceInfoTable).first;
   BOOST_ASSERT(info != nullptr);
   return info;
 }
@@ -258,7 +379,7 @@ AsfMeasurements::getOrCreateNamespaceInfo(const fib::Entry& fibEntry, const Inte
   // Set or update entry lifetime
   extendLifetime(*me);
 
-  NamespaceInfo* info = me->insertStrategyInfo<NamespaceInfo>().first;
+  NamespaceInfo* info = me->insertStrategyInfo<NamespaceInfo>(m_faceInfoTable).first;
   BOOST_ASSERT(info != nullptr);
   return *info;
 }
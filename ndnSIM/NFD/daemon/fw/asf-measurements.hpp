@@ -87,8 +87,85 @@ private:
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+class FaceInfo;
+class NamespaceInfo;
+
+/** \brief measurements of every face in every namespace of an AsfStrategy instance
+ *
+ *  The table is stored as structure-of-arrays: each field of the measurements is a column,
+ *  and a (namespace, face) pair occupies the same row in all columns. NamespaceInfo maps the
+ *  faces of a namespace to their rows.
+ *
+ *  Measurements of a face expire AsfMeasurements::MEASUREMENTS_LIFETIME after they were last
+ *  extended, unless they were created by NamespaceInfo::insert. Expired rows are treated as
+ *  absent by NamespaceInfo, and are erased by a periodic sweep of the expiry column, so that
+ *  no event needs to be scheduled or cancelled per face.
+ */
+class FaceInfoTable : noncopyable
+{
+public:
+  typedef uint32_t Row;
+
+  FaceInfoTable();
+
+  ~FaceInfoTable();
+
+  size_t
+  size() const
+  {
+    return m_faceId.size();
+  }
+
+  /** \brief erase every row whose measurements have expired at \p now
+   *  \return number of erased rows
+   */
+  size_t
+  sweep(time::steady_clock::TimePoint now);
+
+public:
+  static const time::nanoseconds SWEEP_INTERVAL;
+
+private:
+  /** \brief append a row with fresh measurements that do not expire
+   */
+  Row
+  insert(NamespaceInfo& ns, FaceId faceId);
+
+  /** \brief give a row fresh measurements that do not expire
+   */
+  void
+  reset(Row row);
+
+  /** \brief erase a row, moving the last row into its place
+   */
+  void
+  erase(Row row);
+
+  void
+  scheduleSweep();
+
+private:
+  std::vector<FaceId> m_faceId;
+  std::vector<NamespaceInfo*> m_namespace;
+  std::vector<time::steady_clock::TimePoint> m_expiry;
+  std::vector<RttStats> m_rttStats;
+  std::vector<uint32_t> m_nSilentTimeouts;
+  std::vector<uint8_t> m_isTimeoutScheduled;
+  std::vector<scheduler::EventId> m_timeoutEvent; ///< RTO of the last Interest
+  std::vector<Name> m_lastInterestName;
+
+  scheduler::ScopedEventId m_sweepEvent;
+  bool m_isSweepScheduled;
+
+  friend class FaceInfo;
+  friend class NamespaceInfo;
+};
+
 /** \brief Strategy information for each face in a namespace
-*/
+ *
+ *  This is a handle to a row of FaceInfoTable. It is valid until the measurements expire or
+ *  the namespace is removed; it must not be kept across strategy triggers.
+ */
 class FaceInfo
 {
 public:
@@ -102,32 +179,42 @@ public:
     }
   };
 
-  FaceInfo();
-
-  ~FaceInfo();
+  /** \brief construct a null handle
+   */
+  FaceInfo()
+    : m_table(nullptr)
+    , m_row(0)
+  {
+  }
 
-  void
-  setTimeoutEvent(const scheduler::EventId& id, const Name& interestName);
+  FaceInfo(FaceInfoTable& table, FaceInfoTable::Row row)
+    : m_table(&table)
+    , m_row(row)
+  {
+  }
 
-  void
-  setMeasurementExpirationEventId(const scheduler::EventId& id)
+  explicit
+  operator bool() const
   {
-    m_measurementExpirationId = id;
+    return m_table != nullptr;
   }
 
-  const scheduler::EventId&
-  getMeasurementExpirationEventId()
+  FaceId
+  getFaceId() const
   {
-    return m_measurementExpirationId;
+    return m_table->m_faceId[m_row];
   }
 
+  void
+  setTimeoutEvent(const scheduler::EventId& id, const Name& interestName);
+
   void
   cancelTimeoutEvent(const Name& prefix);
 
   bool
   isTimeoutScheduled() const
   {
-    return m_isTimeoutScheduled;
+    return m_table->m_isTimeoutScheduled[m_row] != 0;
   }
 
   void
@@ -145,19 +232,19 @@ public:
   RttEstimator::Duration
   computeRto() const
   {
-    return m_rttStats.computeRto();
+    return getRttStats().computeRto();
   }
 
   RttStats::Rtt
   getRtt() const
   {
-    return m_rttStats.getRtt();
+    return getRttStats().getRtt();
   }
 
   RttStats::Rtt
   getSrtt() const
   {
-    return m_rttStats.getSrtt();
+    return getRttStats().getSrtt();
   }
 
   bool
@@ -169,37 +256,35 @@ public:
   size_t
   getNSilentTimeouts() const
   {
-    return m_nSilentTimeouts;
+    return m_table->m_nSilentTimeouts[m_row];
   }
 
   void
   setNSilentTimeouts(size_t nSilentTimeouts)
   {
-    m_nSilentTimeouts = nSilentTimeouts;
+    m_table->m_nSilentTimeouts[m_row] = static_cast<uint32_t>(nSilentTimeouts);
   }
 
 private:
+  RttStats&
+  getRttStats() const
+  {
+    return m_table->m_rttStats[m_row];
+  }
+
   void
   cancelTimeoutEvent();
 
   bool
-  doesNameMatchLastInterest(const Name& name);
+  doesNameMatchLastInterest(const Name& name) const;
 
 private:
-  RttStats m_rttStats;
-  Name m_lastInterestName;
-
-  // Timeout associated with measurement
-  scheduler::EventId m_measurementExpirationId;
+  FaceInfoTable* m_table;
+  FaceInfoTable::Row m_row;
 
-  // RTO associated with Interest
-  scheduler::EventId m_timeoutEventId;
-  bool m_isTimeoutScheduled;
-  size_t m_nSilentTimeouts;
+  friend class NamespaceInfo;
 };
 
-typedef std::unordered_map<FaceId, FaceInfo> FaceInfoTable;
-
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -208,7 +293,10 @@ typedef std::unordered_map<FaceId, FaceInfo> FaceInfoTable;
 class NamespaceInfo : public StrategyInfo
 {
 public:
-  NamespaceInfo();
+  explicit
+  NamespaceInfo(shared_ptr<FaceInfoTable> table);
+
+  ~NamespaceInfo() override;
 
   static constexpr int
   getTypeId()
@@ -216,47 +304,31 @@ public:
     return 1030;
   }
 
-  FaceInfo&
+  FaceInfo
   getOrCreateFaceInfo(const fib::Entry& fibEntry, FaceId faceId);
 
-  FaceInfo*
-  getFaceInfo(const fib::Entry& fibEntry, FaceId faceId);
+  FaceInfo
+  getFaceInfo(const fib::Entry& fibEntry, FaceId faceId)
+  {
+    return get(faceId);
+  }
 
   void
   expireFaceInfo(FaceId faceId);
 
   void
-  extendFaceInfoLifetime(FaceInfo& info, FaceId faceId);
-
-  FaceInfo*
-  get(FaceId faceId)
-  {
-    if (m_fit.find(faceId) != m_fit.end()) {
-      return &m_fit.at(faceId);
-    }
-    else {
-      return nullptr;
-    }
-  }
-
-  FaceInfoTable::iterator
-  find(FaceId faceId)
-  {
-    return m_fit.find(faceId);
-  }
+  extendFaceInfoLifetime(FaceInfo info, FaceId faceId);
 
-  FaceInfoTable::iterator
-  end()
-  {
-    return m_fit.end();
-  }
+  /** \return the measurements of \p faceId, or a null handle if there are none
+   */
+  FaceInfo
+  get(FaceId faceId);
 
-  const FaceInfoTable::iterator
-  insert(FaceId faceId)
-  {
-    const auto& pair = m_fit.insert(std::make_pair(faceId, FaceInfo()));
-    return pair.first;
-  }
+  /** \brief create measurements of \p faceId that do not expire
+   *  \pre get(faceId) returns a null handle
+   */
+  FaceInfo
+  insert(FaceId faceId);
 
   bool
   isProbingDue() const
@@ -283,10 +355,19 @@ public:
   }
 
 private:
-  FaceInfoTable m_fit;
+  /** \return position of \p faceId in m_rows, or m_rows.end()
+   */
+  std::vector<std::pair<FaceId, FaceInfoTable::Row>>::iterator
+  findRow(FaceId faceId);
+
+private:
+  shared_ptr<FaceInfoTable> m_table;
+  std::vector<std::pair<FaceId, FaceInfoTable::Row>> m_rows; ///< few faces, searched linearly
 
   bool m_isProbingDue;
   bool m_hasFirstProbeBeenScheduled;
+
+  friend class FaceInfoTable;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -300,10 +381,10 @@ public:
   explicit
   AsfMeasurements(MeasurementsAccessor& measurements);
 
-  FaceInfo*
+  FaceInfo
   getFaceInfo(const fib::Entry& fibEntry, const Interest& interest, FaceId faceId);
 
-  FaceInfo&
+  FaceInfo
   getOrCreateFaceInfo(const fib::Entry& fibEntry, const Interest& interest, FaceId faceId);
 
   NamespaceInfo*
@@ -321,6 +402,7 @@ public:
 
 private:
   MeasurementsAccessor& m_measurements;
+  shared_ptr<FaceInfoTable> m_faceInfoTable;
 };
 
 } // namespace asf
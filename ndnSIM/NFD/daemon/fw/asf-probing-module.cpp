@@ -73,8 +73,8 @@ ProbingModule::getFaceToProbe(const Face& inFace,
     [] (FaceInfoFacePair pairLhs, FaceInfoFacePair pairRhs) -> bool {
       // Sort by RTT
       // If a face has timed-out, rank it behind non-timed-out faces
-      FaceInfo& lhs = *pairLhs.first;
-      FaceInfo& rhs = *pairRhs.first;
+      const FaceInfo& lhs = pairLhs.first;
+      const FaceInfo& rhs = pairRhs.first;
 
       return (!lhs.isTimeout() && rhs.isTimeout()) ||
              (lhs.isTimeout() == rhs.isTimeout() && lhs.getSrtt() < rhs.getSrtt());
@@ -92,10 +92,10 @@ ProbingModule::getFaceToProbe(const Face& inFace,
       continue;
     }
 
-    FaceInfo* info = m_measurements.getFaceInfo(fibEntry, interest, hopFace.getId());
+    FaceInfo info = m_measurements.getFaceInfo(fibEntry, interest, hopFace.getId());
 
     // If no RTT has been recorded, probe this face
-    if (info == nullptr || !info->hasSrttMeasurement()) {
+    if (!info || !info.hasSrttMeasurement()) {
       return &hopFace;
     }
 
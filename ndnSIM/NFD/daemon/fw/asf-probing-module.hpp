@@ -66,7 +66,7 @@ public:
 
 private:
   // Used to associate FaceInfo with the face in a NextHop
-  typedef std::pair<FaceInfo*, Face*> FaceInfoFacePair;
+  typedef std::pair<FaceInfo, Face*> FaceInfoFacePair;
   typedef std::function<bool(FaceInfoFacePair, FaceInfoFacePair)> FaceInfoPredicate;
   typedef std::set<FaceInfoFacePair, FaceInfoPredicate> FaceInfoFacePairSet;
 
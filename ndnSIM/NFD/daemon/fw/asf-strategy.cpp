@@ -168,17 +168,17 @@ AsfStrategy::beforeSatisfyInterest(const shared_ptr<pit::Entry>& pitEntry,
   }
 
   // Record the RTT between the Interest out to Data in
-  FaceInfo* faceInfo = namespaceInfo->get(inFace.getId());
-  if (faceInfo == nullptr) {
+  FaceInfo faceInfo = namespaceInfo->get(inFace.getId());
+  if (!faceInfo) {
     return;
   }
-  faceInfo->recordRtt(pitEntry, inFace);
+  faceInfo.recordRtt(pitEntry, inFace);
 
   // Extend lifetime for measurements associated with Face
-  namespaceInfo->extendFaceInfoLifetime(*faceInfo, inFace.getId());
+  namespaceInfo->extendFaceInfoLifetime(faceInfo, inFace.getId());
 
-  if (faceInfo->isTimeoutScheduled()) {
-    faceInfo->cancelTimeoutEvent(data.getName());
+  if (faceInfo.isTimeoutScheduled()) {
+    faceInfo.cancelTimeoutEvent(data.getName());
   }
 }
 
@@ -212,7 +212,7 @@ AsfStrategy::forwardInterest(const Interest& interest,
     this->sendInterest(pitEntry, outFace, interest);
   }
 
-  FaceInfo& faceInfo = m_measurements.getOrCreateFaceInfo(fibEntry, interest, outFace.getId());
+  FaceInfo faceInfo = m_measurements.getOrCreateFaceInfo(fibEntry, interest, outFace.getId());
 
   // Refresh measurements since Face is being used for forwarding
   NamespaceInfo& namespaceInfo = m_measurements.getOrCreateNamespaceInfo(fibEntry, interest);
@@ -294,9 +294,9 @@ AsfStrategy::getBestFaceForForwarding(const fib::Entry& fibEntry, const Interest
       continue;
     }
 
-    FaceInfo* info = m_measurements.getFaceInfo(fibEntry, interest, hopFace.getId());
+    FaceInfo info = m_measurements.getFaceInfo(fibEntry, interest, hopFace.getId());
 
-    if (info == nullptr) {
+    if (!info) {
       FaceStats stats = {&hopFace,
                          RttStats::RTT_NO_MEASUREMENT,
                          RttStats::RTT_NO_MEASUREMENT,
@@ -305,7 +305,7 @@ AsfStrategy::getBestFaceForForwarding(const fib::Entry& fibEntry, const Interest
       rankedFaces.insert(stats);
     }
     else {
-      FaceStats stats = {&hopFace, info->getRtt(), info->getSrtt(), hop.getCost()};
+      FaceStats stats = {&hopFace, info.getRtt(), info.getSrtt(), hop.getCost()};
       rankedFaces.insert(stats);
     }
   }
@@ -330,14 +330,12 @@ AsfStrategy::onTimeout(const Name& interestName, const face::FaceId faceId)
     return;
   }
 
-  FaceInfoTable::iterator it = namespaceInfo->find(faceId);
+  FaceInfo faceInfo = namespaceInfo->get(faceId);
 
-  if (it == namespaceInfo->end()) {
-    it = namespaceInfo->insert(faceId);
+  if (!faceInfo) {
+    faceInfo = namespaceInfo->insert(faceId);
   }
 
-  FaceInfo& faceInfo = it->second;
-
   faceInfo.setNSilentTimeouts(faceInfo.getNSilentTimeouts() + 1);
 
   if (faceInfo.getNSilentTimeouts() <= m_maxSilentTimeouts) {
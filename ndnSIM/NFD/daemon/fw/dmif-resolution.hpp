@@ -0,0 +1,86 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2018,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_DMIF_RESOLUTION_HPP
+#define NFD_DAEMON_FW_DMIF_RESOLUTION_HPP
+
+#include "table/fib-entry.hpp"
+
+#include <ndn-cxx/tag.hpp>
+
+namespace nfd {
+namespace fw {
+
+/** \brief outcome of the DMIF FIB lookup for one Interest
+ *
+ *  The forwarder resolves an Interest once and attaches the result as a DmifResolutionTag,
+ *  so that later pipeline stages (e.g. each out-face of a multicast) reuse it instead of
+ *  hashing the name again.
+ */
+struct DmifResolution
+{
+  /** \brief whether this resolution still describes a lookup of \p forwarderId
+   *         in a FIB at \p generation
+   *
+   *  Looking up nextForwarderId yields the same FIB entry, because nextForwarderId is one of
+   *  the forwarderIds learned by that entry.
+   */
+  bool
+  isValidFor(uint32_t forwarderId, uint64_t generation) const
+  {
+    return this->generation == generation &&
+           (this->forwarderId == forwarderId || this->nextForwarderId == forwarderId);
+  }
+
+  /** \brief forwarderId the Interest carried when it was resolved
+   */
+  uint32_t forwarderId = 0;
+
+  /** \brief value of Fib::getDmifGeneration() when the Interest was resolved
+   */
+  uint64_t generation = 0;
+
+  /** \brief FIB entry matched on (name, forwarderId), or nullptr
+   *  \warning may dangle once the FIB generation has changed; check isValidFor before use
+   */
+  fib::Entry* fibEntry = nullptr;
+
+  /** \brief forwarding mode to use on the outgoing Interest
+   */
+  uint32_t mode = 0;
+
+  /** \brief forwarderId to put on the outgoing Interest
+   */
+  uint32_t nextForwarderId = 0;
+};
+
+/** \brief packet tag carrying the DmifResolution of an Interest
+ */
+typedef ndn::SimpleTag<DmifResolution, 0x60000001> DmifResolutionTag;
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_DMIF_RESOLUTION_HPP
@@ -34,6 +34,7 @@
 #include "face/null-face.hpp"
 
 #include "../src/ndnSIM/LogManager.cpp"
+#include "../src/ndnSIM/DmifTrace.cpp"
 #include "../src/ndnSIM/NameHelper.cpp"
 #include "../src/ndnSIM/forwarding-mode.cpp"
 //#include "fib-nexthop.hpp"
@@ -149,7 +150,7 @@ Forwarder::onIncomingInterest(Face& inFace, const Interest& interest)
                 bind(&Forwarder::onContentStoreMiss, this, ref(inFace), pitEntry, _1));
     }
     else {
-      shared_ptr<Data> match = m_csFromNdnSim->Lookup(interest.shared_from_this());
+      shared_ptr<const Data> match = m_csFromNdnSim->Lookup(interest.shared_from_this());
       if (match != nullptr) {
         this->onContentStoreHit(inFace, pitEntry, interest, *match);
       }
@@ -189,7 +190,7 @@ void
 Forwarder::onContentStoreMiss(const Face& inFace,
 		const shared_ptr<pit::Entry>& pitEntry, const Interest& interest) {
 
-	LogManager::AddLogWithNodeId("forwarder.cpp->onContentStoreMiss.start.name", interest.getName().toUri());
+	DMIF_LOG_DEBUG("forwarder.cpp", "onContentStoreMiss.start.name:" << interest.getName());
 	NFD_LOG_DEBUG("onContentStoreMiss interest=" << interest.getName());
 
 	bool shouldReturn = false;
@@ -197,7 +198,9 @@ Forwarder::onContentStoreMiss(const Face& inFace,
 	/****** DMIF ******/
 	LogManager::AddLogWithNodeId("forwarder.cpp->onContentStoreMiss.DMIF.start");
 	int forwardingMode = interest.getForwardingMode();
-	LogManager::AddLogWithNodeId("forwarder.cpp->onContentStoreMiss.interestForwardingMode", interest.getForwardingModeName());
+	DmifTrace::Record(DmifTraceEvent::InterestCsMiss, forwardingMode, interest.getForwarderId(),
+			interest.getName(), inFace.getId());
+	DMIF_LOG_DEBUG("forwarder.cpp", "onContentStoreMiss.interestForwardingMode:" << interest.getForwardingModeName());
 	LogManager::AddLogWithNodeId("forwarder.cpp->onContentStoreMiss.interestForwarderId", interest.getForwarderId());
 	if (forwardingMode == ForwardingMode::Directive) {
 		LogManager::AddLogWithNodeId("forwarder.cpp->onContentStoreMiss.ForwardingMode::Directive");
@@ -206,6 +209,8 @@ Forwarder::onContentStoreMiss(const Face& inFace,
 		LogManager::AddLogWithNodeId("forwarder.cpp->onContentStoreMiss.currentNodeId", currentNodeId);
 		if (forwarderId != currentNodeId) {
 			LogManager::AddLogWithNodeId("forwarder.cpp->onContentStoreMiss.drop");
+			DmifTrace::Record(DmifTraceEvent::DirectiveNotForUs, forwardingMode, forwarderId,
+					interest.getName(), inFace.getId());
 			shouldReturn = true;
 			//return; //drop interest (do nothing)
 		} else {
@@ -214,25 +219,33 @@ Forwarder::onContentStoreMiss(const Face& inFace,
 			LogManager::AddLogWithNodeId("forwarder.cpp->onContentStoreMiss.pitEntry");
 			if (pitEntry != nullptr) {
 				LogManager::AddLogWithNodeId("forwarder.cpp->onContentStoreMiss.pitEntry.hit.drop");
+				DmifTrace::Record(DmifTraceEvent::PitHitDrop, forwardingMode, interest.getForwarderId(),
+						interest.getName(), inFace.getId());
 				shouldReturn = true;
 				//return; //drop interest (do nothing)
 			} else {
 				LogManager::AddLogWithNodeId("forwarder.cpp->onContentStoreMiss.pitEntry.miss");
 				try {
-					fib::Entry* fibEntry = m_fib.findExactMatch_dmif(interest.getName(), forwarderId);
-					if (fibEntry == nullptr) {
+					fw::DmifResolution resolution = this->resolveDmif(interest);
+					if (resolution.fibEntry == nullptr) {
 						LogManager::AddLogWithNodeId("forwarder.cpp->onContentStoreMiss.fibEntry.null");
 						const_cast<Interest&>(interest).setForwardingMode(ForwardingMode::Flooding);
-						LogManager::AddLogWithNodeId("forwarder.cpp->onContentStoreMiss.setForwardingMode", interest.getForwardingModeName());
+						DMIF_LOG_DEBUG("forwarder.cpp", "onContentStoreMiss.setForwardingMode:" << interest.getForwardingModeName());
+						DmifTrace::Record(DmifTraceEvent::ModeSet, interest.getForwardingMode(), interest.getForwarderId(),
+								interest.getName(), inFace.getId());
 					} else {
 						LogManager::AddLogWithNodeId("forwarder.cpp->onContentStoreMiss.fibEntry.not.null");
 						const_cast<Interest&>(interest).setForwardingMode(ForwardingMode::Directive);
-						LogManager::AddLogWithNodeId("forwarder.cpp->onContentStoreMiss.setForwardingMode", interest.getForwardingModeName());
+						DMIF_LOG_DEBUG("forwarder.cpp", "onContentStoreMiss.setForwardingMode:" << interest.getForwardingModeName());
+						DmifTrace::Record(DmifTraceEvent::ModeSet, interest.getForwardingMode(), interest.getForwarderId(),
+								interest.getName(), inFace.getId());
 					}
 				} catch (const std::exception& e) {
 					LogManager::AddLogWithNodeId("forwarder.cpp->onContentStoreMiss.fibLookup.exception", e.what());
 					const_cast<Interest&>(interest).setForwardingMode(ForwardingMode::Flooding);
-					LogManager::AddLogWithNodeId("forwarder.cpp->onContentStoreMiss.setForwardingMode", interest.getForwardingModeName());
+					DMIF_LOG_DEBUG("forwarder.cpp", "onContentStoreMiss.setForwardingMode:" << interest.getForwardingModeName());
+					DmifTrace::Record(DmifTraceEvent::ModeSet, interest.getForwardingMode(), interest.getForwarderId(),
+							interest.getName(), inFace.getId());
 				}
 			}
 		}
@@ -242,29 +255,39 @@ Forwarder::onContentStoreMiss(const Face& inFace,
 //		LogManager::AddLogWithNodeId("forwarder.cpp->onContentStoreMiss.pitEntry");
 		if (pitEntry != nullptr) {
 			LogManager::AddLogWithNodeId("forwarder.cpp->onContentStoreMiss.pitEntry.hit.drop");
+			DmifTrace::Record(DmifTraceEvent::PitHitDrop, forwardingMode, interest.getForwarderId(),
+					interest.getName(), inFace.getId());
 			shouldReturn = true;
 			//return; //drop interest (do nothing)
 		} else {
 			LogManager::AddLogWithNodeId("forwarder.cpp->onContentStoreMiss.pitEntry.miss");
 			try {
-				fib::Entry* fibEntry = m_fib.findExactMatch_dmif(interest.getName(), interest.getForwarderId());
-				if (fibEntry == nullptr) {
+				fw::DmifResolution resolution = this->resolveDmif(interest);
+				if (resolution.fibEntry == nullptr) {
 					LogManager::AddLogWithNodeId("forwarder.cpp->onContentStoreMiss.fibEntry.null");
 					const_cast<Interest&>(interest).setForwardingMode(ForwardingMode::Flooding);
-					LogManager::AddLogWithNodeId("forwarder.cpp->onContentStoreMiss.setForwardingMode", interest.getForwardingModeName());
+					DMIF_LOG_DEBUG("forwarder.cpp", "onContentStoreMiss.setForwardingMode:" << interest.getForwardingModeName());
+					DmifTrace::Record(DmifTraceEvent::ModeSet, interest.getForwardingMode(), interest.getForwarderId(),
+							interest.getName(), inFace.getId());
 				} else {
 					LogManager::AddLogWithNodeId("forwarder.cpp->onContentStoreMiss.fibEntry.not.null");
 					const_cast<Interest&>(interest).setForwardingMode(ForwardingMode::Directive);
-					LogManager::AddLogWithNodeId("forwarder.cpp->onContentStoreMiss.setForwardingMode", interest.getForwardingModeName());
+					DMIF_LOG_DEBUG("forwarder.cpp", "onContentStoreMiss.setForwardingMode:" << interest.getForwardingModeName());
+					DmifTrace::Record(DmifTraceEvent::ModeSet, interest.getForwardingMode(), interest.getForwarderId(),
+							interest.getName(), inFace.getId());
 				}
 			} catch (const std::exception& e) {
 				LogManager::AddLogWithNodeId("forwarder.cpp->onContentStoreMiss.fibLookup.exception", e.what());
 				const_cast<Interest&>(interest).setForwardingMode(ForwardingMode::Flooding);
-				LogManager::AddLogWithNodeId("forwarder.cpp->onContentStoreMiss.setForwardingMode", interest.getForwardingModeName());
+				DMIF_LOG_DEBUG("forwarder.cpp", "onContentStoreMiss.setForwardingMode:" << interest.getForwardingModeName());
+				DmifTrace::Record(DmifTraceEvent::ModeSet, interest.getForwardingMode(), interest.getForwarderId(),
+						interest.getName(), inFace.getId());
 			}
 		}
 	} else {
 		LogManager::AddLogWithNodeId("forwarder.cpp->onContentStoreMiss.forwardingMode.notset.drop");
+		DmifTrace::Record(DmifTraceEvent::ModeNotSetDrop, forwardingMode, interest.getForwarderId(),
+				interest.getName(), inFace.getId());
 		shouldReturn = true;
 		//return; //drop interest (do nothing)
 	}
@@ -345,14 +368,18 @@ Forwarder::onContentStoreHit(const Face& inFace, const shared_ptr<pit::Entry>& p
   this->dispatchToStrategy(*pitEntry,
     [&] (fw::Strategy& strategy) { strategy.beforeSatisfyInterest(pitEntry, *m_csFace, data); });
 
-  data.setTag(make_shared<lp::IncomingFaceIdTag>(face::FACEID_CONTENT_STORE));
+  // data is the cached packet, shared with the CS: the tags of this delivery go to the face
+  // separately, so a hit neither copies nor retags it
+  face::DataDelivery delivery;
+  delivery.incomingFaceId = face::FACEID_CONTENT_STORE;
+
   // XXX should we lookup PIT for other Interests that also match csMatch?
 
   // set PIT straggler timer
   this->setStragglerTimer(pitEntry, true, data.getFreshnessPeriod());
 
   // goto outgoing Data pipeline
-  this->onOutgoingData(data, *const_pointer_cast<Face>(inFace.shared_from_this()));
+  this->onOutgoingData(data, *const_pointer_cast<Face>(inFace.shared_from_this()), delivery);
 }
 
 void
@@ -363,21 +390,20 @@ Forwarder::onOutgoingInterest(const shared_ptr<pit::Entry>& pitEntry, Face& outF
   /******* DMIF ******/
   LogManager::AddLogWithNodeId("forwarder.cpp->onOutgoingInterest.DMIF.start");
     try {
-	  	  uint32_t fi = interest.getForwarderId();
-		fib::Entry* fibEntry = m_fib.findExactMatch_dmif(interest.getName(), fi);
-		if (fibEntry == nullptr) {
+		fw::DmifResolution resolution = this->resolveDmif(interest);
+		if (resolution.fibEntry == nullptr) {
 			LogManager::AddLogWithNodeId("forwarder.cpp->onOutgoingInterest.fibEntry.null");
 			const_cast<Interest&>(interest).setForwardingMode(ForwardingMode::Flooding);
-			LogManager::AddLogWithNodeId("forwarder.cpp->onOutgoingInterest.setForwardingMode", interest.getForwardingModeName());
+			DMIF_LOG_DEBUG("forwarder.cpp", "onOutgoingInterest.setForwardingMode:" << interest.getForwardingModeName());
 		} else {
 			LogManager::AddLogWithNodeId("forwarder.cpp->onOutgoingInterest.fibEntry.not.null");
 
 			//set forwardingMode
 			const_cast<Interest&>(interest).setForwardingMode(ForwardingMode::Directive);
-			LogManager::AddLogWithNodeId("forwarder.cpp->onOutgoingInterest.setForwardingMode", interest.getForwardingModeName());
+			DMIF_LOG_DEBUG("forwarder.cpp", "onOutgoingInterest.setForwardingMode:" << interest.getForwardingModeName());
 
 			//set forwarderId
-			uint32_t fi = fibEntry->getNameTreeEntry()->getForwarderId();
+			uint32_t fi = resolution.nextForwarderId;
 			LogManager::AddLogWithNodeId("forwarder.cpp->onOutgoingInterest.fibEntry.forwarderId", fi);
 			const_cast<Interest&>(interest).setForwarderId(fi);
 			LogManager::AddLogWithNodeId("forwarder.cpp->onOutgoingInterest.setForwarderId", interest.getForwarderId());
@@ -385,10 +411,12 @@ Forwarder::onOutgoingInterest(const shared_ptr<pit::Entry>& pitEntry, Face& outF
 	} catch (const std::exception& e) {
 		LogManager::AddLogWithNodeId("forwarder.cpp->onOutgoingInterest.fibLookup.exception", e.what());
 		const_cast<Interest&>(interest).setForwardingMode(ForwardingMode::Flooding);
-		LogManager::AddLogWithNodeId("forwarder.cpp->onOutgoingInterest.setForwardingMode", interest.getForwardingModeName());
+		DMIF_LOG_DEBUG("forwarder.cpp", "onOutgoingInterest.setForwardingMode:" << interest.getForwardingModeName());
 	}
 
 	LogManager::AddLogWithNodeId("forwarder.cpp->onOutgoingInterest.DMIF.end");
+	DmifTrace::Record(DmifTraceEvent::OutgoingInterest, interest.getForwardingMode(), interest.getForwarderId(),
+			interest.getName(), outFace.getId());
   /******* DMIF ******/
 
   // insert out-record
@@ -463,7 +491,12 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
 {
   // receive Data
   NFD_LOG_DEBUG("onIncomingData face=" << inFace.getId() << " data=" << data.getName());
-  data.setTag(make_shared<lp::IncomingFaceIdTag>(inFace.getId()));
+  // the CS shares this Data instead of caching a copy, so the tags that describe this reception
+  // travel beside it to the pending downstreams and are not left on the cached packet
+  face::DataDelivery delivery = face::DataDelivery::fromTags(data);
+  delivery.incomingFaceId = inFace.getId();
+  data.removeTag<lp::IncomingFaceIdTag>();
+  data.removeTag<lp::HopCountTag>();
   ++m_counters.nInData;
 
   // /localhost scope control
@@ -478,15 +511,18 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
 
   /****** DMIF ******/
   try{
-	  LogManager::AddLogWithNodeId("forwarder.cpp->onIncomingData.name", data.getName().toUri());
+	  DMIF_LOG_DEBUG("forwarder.cpp", "onIncomingData.name:" << data.getName());
 	  LogManager::AddLogWithNodeId("forwarder.cpp->onIncomingData.forwarderId", data.getForwarderId());
-	  fib::Entry* fibEntry = m_fib.findExactMatch_dmif(data.getName(), data.getForwarderId());//finds or inserts
+	  DmifTrace::Record(DmifTraceEvent::IncomingData, 0, data.getForwarderId(), data.getName(), inFace.getId());
+	  fib::Entry* fibEntry = m_fib.findLongestPrefixMatch_dmif(data.getName());
 	  //LogManager::AddLogWithNodeId("forwarder.cpp->onIncomingData.fibEntry.forwarderId", fibEntry->getForwarderId());
-	  if(fibEntry == nullptr){
+	  if(fibEntry == nullptr || !fibEntry->getNameTreeEntry()->hasForwarderId(data.getForwarderId())){
 		  LogManager::AddLogWithNodeId("forwarder.cpp->onIncomingData.findExactMatch_dmif.not-found");
+		  DmifTrace::Record(DmifTraceEvent::FibMiss, 0, data.getForwarderId(), data.getName(), inFace.getId());
 	  }
 	  else{
 		  LogManager::AddLogWithNodeId("forwarder.cpp->onIncomingData.findExactMatch_dmif.found");
+		  DmifTrace::Record(DmifTraceEvent::FibMatch, 0, data.getForwarderId(), data.getName(), inFace.getId());
 	  }
   }
   catch(std::exception& ex){
@@ -503,14 +539,19 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
     return;
   }
 
-  shared_ptr<Data> dataCopyWithoutTag = make_shared<Data>(data);
-  dataCopyWithoutTag->removeTag<lp::HopCountTag>();
+  /****** DMIF ******/
+  // learn that the sender of this Data can serve its name, before ForwarderId is overwritten below
+  this->learnForwarderId(inFace, data);
+  /****** DMIF ******/
 
   // CS insert
+  // ForwarderId is set now to the value every Data sent from this node carries, so
+  // onOutgoingData does not change the cached packet.
+  const_cast<Data&>(data).setForwarderId(LogHelper::GetNodeId());
   if (m_csFromNdnSim == nullptr)
-    m_cs.insert(*dataCopyWithoutTag);
+    m_cs.insert(data);
   else
-    m_csFromNdnSim->Add(dataCopyWithoutTag);
+    m_csFromNdnSim->Add(data.shared_from_this());
 
   std::set<Face*> pendingDownstreams;
   // foreach PitEntry
@@ -551,7 +592,7 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
       continue;
     }
     // goto outgoing Data pipeline
-    this->onOutgoingData(data, *pendingDownstream);
+    this->onOutgoingData(data, *pendingDownstream, delivery);
   }
 }
 
@@ -561,7 +602,8 @@ Forwarder::onDataUnsolicited(Face& inFace, const Data& data)
   // accept to cache?
   fw::UnsolicitedDataDecision decision = m_unsolicitedDataPolicy->decide(inFace, data);
   if (decision == fw::UnsolicitedDataDecision::CACHE) {
-    // CS insert
+    // CS insert, with ForwarderId set as in onIncomingData
+    const_cast<Data&>(data).setForwarderId(LogHelper::GetNodeId());
     if (m_csFromNdnSim == nullptr)
       m_cs.insert(data, true);
     else
@@ -574,7 +616,7 @@ Forwarder::onDataUnsolicited(Face& inFace, const Data& data)
 }
 
 void
-Forwarder::onOutgoingData(const Data& data, Face& outFace)
+Forwarder::onOutgoingData(const Data& data, Face& outFace, const face::DataDelivery& delivery)
 {
   if (outFace.getId() == face::INVALID_FACEID) {
     NFD_LOG_WARN("onOutgoingData face=invalid data=" << data.getName());
@@ -585,6 +627,7 @@ Forwarder::onOutgoingData(const Data& data, Face& outFace)
   /******* DMIF *******/
   const_cast<Data&>(data).setForwarderId(LogHelper::GetNodeId());
   LogManager::AddLogWithNodeId("forwarder.cpp->onOutgoingData.getForwarderId", data.getForwarderId());
+  DmifTrace::Record(DmifTraceEvent::OutgoingData, 0, data.getForwarderId(), data.getName(), outFace.getId());
   /******* DMIF *******/
 
   // /localhost scope control
@@ -600,7 +643,7 @@ Forwarder::onOutgoingData(const Data& data, Face& outFace)
   // TODO traffic manager
 
   // send Data
-  outFace.sendData(data);
+  outFace.sendData(data, delivery);
   ++m_counters.nOutData;
 }
 
@@ -793,4 +836,59 @@ Forwarder::insertDeadNonceList(pit::Entry& pitEntry, bool isSatisfied,
   }
 }
 
+/****** DMIF ******/
+fw::DmifResolution
+Forwarder::resolveDmif(const Interest& interest)
+{
+  uint32_t forwarderId = interest.getForwarderId();
+  shared_ptr<fw::DmifResolutionTag> tag = interest.getTag<fw::DmifResolutionTag>();
+  if (tag != nullptr && tag->get().isValidFor(forwarderId, m_fib.getDmifGeneration())) {
+    return tag->get();
+  }
+
+  fw::DmifResolution resolution;
+  resolution.forwarderId = forwarderId;
+  resolution.generation = m_fib.getDmifGeneration();
+  resolution.fibEntry = m_fib.findExactMatch_dmif(interest.getName(), forwarderId);
+  if (resolution.fibEntry == nullptr) {
+    // forwarderId was not learned for this name (e.g. the Interest comes from a consumer, or
+    // is directed at this node): use the forwarders that supplied Data under the route, if any
+    fib::Entry* fibEntry = m_fib.findLongestPrefixMatch_dmif(interest.getName());
+    if (fibEntry != nullptr && !fibEntry->getNameTreeEntry()->getForwarderIds().empty()) {
+      resolution.fibEntry = fibEntry;
+    }
+  }
+
+  if (resolution.fibEntry == nullptr) {
+    resolution.mode = ForwardingMode::Flooding;
+    resolution.nextForwarderId = forwarderId;
+  }
+  else {
+    resolution.mode = ForwardingMode::Directive;
+    resolution.nextForwarderId = resolution.fibEntry->getNameTreeEntry()->getForwarderId();
+  }
+
+  interest.setTag(make_shared<fw::DmifResolutionTag>(resolution));
+  return resolution;
+}
+
+void
+Forwarder::learnForwarderId(Face& inFace, const Data& data)
+{
+  // Data from a local application does not carry the forwarderId of a neighbor
+  if (inFace.getScope() == ndn::nfd::FACE_SCOPE_LOCAL) {
+    return;
+  }
+
+  // the route the Interest was forwarded on learns the forwarderId; Data never creates routes
+  fib::Entry* fibEntry = m_fib.findLongestPrefixMatch_dmif(data.getName());
+  if (fibEntry == nullptr) {
+    return;
+  }
+  if (m_fib.addForwarderId(*fibEntry, data.getForwarderId())) {
+    LogManager::AddLogWithNodeId("forwarder.cpp->learnForwarderId.learned", data.getForwarderId());
+  }
+}
+/****** DMIF ******/
+
 } // namespace nfd
@@ -29,6 +29,7 @@
 #include "core/common.hpp"
 #include "core/scheduler.hpp"
 #include "forwarder-counters.hpp"
+#include "dmif-resolution.hpp"
 #include "face-table.hpp"
 #include "unsolicited-data-policy.hpp"
 #include "table/fib.hpp"
@@ -258,9 +259,11 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE: // pipelines
   onDataUnsolicited(Face& inFace, const Data& data);
 
   /** \brief outgoing Data pipeline
+   *  \param delivery IncomingFaceId and HopCount of this transmission; \p data may be the
+   *                  instance held by the CS and does not carry them
    */
   VIRTUAL_WITH_TESTS void
-  onOutgoingData(const Data& data, Face& outFace);
+  onOutgoingData(const Data& data, Face& outFace, const face::DataDelivery& delivery);
 
   /** \brief incoming Nack pipeline
    */
@@ -275,6 +278,28 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE: // pipelines
   VIRTUAL_WITH_TESTS void
   onDroppedInterest(Face& outFace, const Interest& interest);
 
+  /****** DMIF ******/
+  /** \brief resolve interest on (name, forwarderId) in the FIB
+   *
+   *  If no FIB entry of the Interest name has learned the Interest's forwarderId, the Interest
+   *  is resolved to its longest prefix match FIB entry if that entry has learned others.
+   *
+   *  The result is attached to interest as a DmifResolutionTag and reused by later calls
+   *  for as long as it stays valid, so a multicast does not repeat the lookup per out-face.
+   */
+  fw::DmifResolution
+  resolveDmif(const Interest& interest);
+
+  /** \brief record that the sender of data can serve its name
+   *
+   *  The forwarderId carried by data is learned by the longest prefix match FIB entry of the
+   *  Data name, so Interests under that route are then resolved as Directive. Nothing is
+   *  learned if no route matches; the FIB is never extended from Data.
+   */
+  void
+  learnForwarderId(Face& inFace, const Data& data);
+  /****** DMIF ******/
+
 PROTECTED_WITH_TESTS_ELSE_PRIVATE:
   VIRTUAL_WITH_TESTS void
   setUnsatisfyTimer(const shared_ptr<pit::Entry>& pitEntry);
@@ -84,6 +84,7 @@ Cs::insert(const Data& data, bool isUnsolicited)
     m_policy->afterRefresh(it);
   }
   else {
+    this->indexInsert(it);
     m_policy->afterInsert(it);
   }
 }
@@ -104,6 +105,18 @@ Cs::find(const Interest& interest,
   bool isRightmost = interest.getChildSelector() == 1;
   NFD_LOG_DEBUG("find " << prefix << (isRightmost ? " R" : " L"));
 
+  // fast path: an Interest without selectors usually names one stored Data exactly,
+  // and a Data with exactly that Name is the leftmost one under the prefix
+  if (!interest.hasSelectors()) {
+    iterator match = this->findExact(interest);
+    if (match != m_table.end()) {
+      NFD_LOG_DEBUG("  matching-exact " << match->getName());
+      m_policy->beforeUse(match);
+      hitCallback(interest, match->getData());
+      return;
+    }
+  }
+
   iterator first = m_table.lower_bound(prefix);
   iterator last = m_table.end();
   if (prefix.size() > 0) {
@@ -172,6 +185,69 @@ Cs::findRightmostAmongExact(const Interest& interest, iterator first, iterator l
   return find_last_if(first, last, bind(&EntryImpl::canSatisfy, _1, interest));
 }
 
+iterator
+Cs::findExact(const Interest& interest) const
+{
+  const Name& name = interest.getName();
+  auto range = m_exactIndex.equal_range(std::hash<Name>()(name));
+  for (auto i = range.first; i != range.second; ++i) {
+    if (i->second->getName() != name) {
+      continue;
+    }
+    for (iterator it = i->second; it != m_table.end() && it->getName() == name; ++it) {
+      if (it->canSatisfy(interest)) {
+        return it;
+      }
+    }
+    break;
+  }
+  return m_table.end();
+}
+
+void
+Cs::indexInsert(iterator it)
+{
+  const Name& name = it->getName();
+  if (it != m_table.begin() && std::prev(it)->getName() == name) {
+    return;
+  }
+
+  // it is the first entry with this Name; an existing index item points to its successor
+  size_t hash = std::hash<Name>()(name);
+  auto range = m_exactIndex.equal_range(hash);
+  for (auto i = range.first; i != range.second; ++i) {
+    if (i->second->getName() == name) {
+      i->second = it;
+      return;
+    }
+  }
+  m_exactIndex.emplace(hash, it);
+}
+
+void
+Cs::indexErase(iterator it)
+{
+  const Name& name = it->getName();
+  if (it != m_table.begin() && std::prev(it)->getName() == name) {
+    return;
+  }
+
+  auto range = m_exactIndex.equal_range(std::hash<Name>()(name));
+  for (auto i = range.first; i != range.second; ++i) {
+    if (i->second != it) {
+      continue;
+    }
+    iterator next = std::next(it);
+    if (next != m_table.end() && next->getName() == name) {
+      i->second = next;
+    }
+    else {
+      m_exactIndex.erase(i);
+    }
+    return;
+  }
+}
+
 void
 Cs::dump()
 {
@@ -197,6 +273,7 @@ Cs::setPolicyImpl(unique_ptr<Policy> policy)
   NFD_LOG_DEBUG("set-policy " << policy->getName());
   m_policy = std::move(policy);
   m_beforeEvictConnection = m_policy->beforeEvict.connect([this] (iterator it) {
+      this->indexErase(it);
       m_table.erase(it);
     });
 
@@ -32,6 +32,8 @@
  *
  *  The Table is a container (std::set) sorted by full Names of stored Data packets.
  *  Data packets are wrapped in Entry objects.
+ *  A hash index locates the first Entry of each Data Name, so that an Interest without selectors
+ *  that names a stored Data exactly is answered without searching the Table.
  *  Each Entry contain the Data packet itself,
  *  and a few addition attributes such as the staleness of the Data packet.
  *
@@ -79,6 +81,7 @@ public:
    *  \param missCallback a callback if there's no match; must not be empty
    *  \note A lookup invokes either callback exactly once.
    *        The callback may be invoked either before or after find() returns
+   *  \note hitCallback receives the stored Data, not a copy, and must not modify it
    */
   void
   find(const Interest& interest,
@@ -201,6 +204,23 @@ private: // find
   iterator
   findRightmostAmongExact(const Interest& interest, iterator first, iterator last) const;
 
+  /** \brief find leftmost match among entries whose Name equals the Interest Name
+   *  \return the leftmost match, or m_table.end() if not found
+   */
+  iterator
+  findExact(const Interest& interest) const;
+
+private: // exact-name index
+  /** \brief index a new Table entry if it is the first one with its Name
+   */
+  void
+  indexInsert(iterator it);
+
+  /** \brief update the index before a Table entry is erased
+   */
+  void
+  indexErase(iterator it);
+
   void
   setPolicyImpl(unique_ptr<Policy> policy);
 
@@ -210,6 +230,8 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
 private:
   Table m_table;
+  /// Name hash => first Table entry with that Name
+  std::unordered_multimap<size_t, iterator> m_exactIndex;
   unique_ptr<Policy> m_policy;
   signal::ScopedConnection m_beforeEvictConnection;
 
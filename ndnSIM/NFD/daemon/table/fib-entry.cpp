@@ -65,6 +65,22 @@ Entry::addNextHop(Face& face, uint64_t cost)
   this->sortNextHops();
 }
 
+void
+Entry::addNextHops(const NextHopList& nextHops)
+{
+  for (const NextHop& nexthop : nextHops) {
+    auto it = this->findNextHop(nexthop.getFace());
+    if (it == m_nextHops.end()) {
+      m_nextHops.push_back(nexthop);
+    }
+    else {
+      it->setCost(nexthop.getCost());
+    }
+  }
+
+  this->sortNextHops();
+}
+
 void
 Entry::removeNextHop(const Face& face)
 {
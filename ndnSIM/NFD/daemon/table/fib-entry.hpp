@@ -87,6 +87,14 @@ public:
   void
   addNextHop(Face& face, uint64_t cost);
 
+  /** \brief adds or updates several NextHop records
+   *
+   *  This is equivalent to calling addNextHop for each element of \p nextHops in order,
+   *  but the nexthop list is sorted only once.
+   */
+  void
+  addNextHops(const NextHopList& nextHops);
+
   /** \brief removes a NextHop record
    *
    *  If no NextHop record for face exists, do nothing.
@@ -45,7 +45,9 @@ nteHasFibEntry(const name_tree::Entry& nte)
 Fib::Fib(NameTree& nameTree)
   : m_nameTree(nameTree)
   , m_nItems(0)
+  , m_dmifGeneration(0)
 {
+  this->bumpDmifGeneration();
 }
 
 template<typename K>
@@ -117,6 +119,49 @@ Fib::findExactMatch_dmif(const Name& prefix, uint32_t forwarderId) {
 		return nullptr;
 	}
 }
+
+Entry*
+Fib::findLongestPrefixMatch_dmif(const Name& prefix)
+{
+  name_tree::Entry* nte = m_nameTree.findLongestPrefixMatch(prefix, &nteHasFibEntry);
+  if (nte != nullptr)
+    return nte->getFibEntry();
+
+  return nullptr;
+}
+
+bool
+Fib::addForwarderId(Entry& entry, uint32_t forwarderId)
+{
+  name_tree::Entry* nte = m_nameTree.getEntry(entry);
+  BOOST_ASSERT(nte != nullptr);
+  if (!m_nameTree.addForwarderId(*nte, forwarderId)) {
+    return false;
+  }
+  this->bumpDmifGeneration();
+  return true;
+}
+
+bool
+Fib::removeForwarderId(Entry& entry, uint32_t forwarderId)
+{
+  name_tree::Entry* nte = m_nameTree.getEntry(entry);
+  BOOST_ASSERT(nte != nullptr);
+  if (!m_nameTree.removeForwarderId(*nte, forwarderId)) {
+    return false;
+  }
+  this->bumpDmifGeneration();
+  return true;
+}
+
+void
+Fib::bumpDmifGeneration()
+{
+  // generations are unique across all FIBs, so that a DmifResolutionTag attached by another
+  // forwarder is never mistaken for a current one
+  static uint64_t s_lastDmifGeneration = 0;
+  m_dmifGeneration = ++s_lastDmifGeneration;
+}
 /****** DMIF ******/
 
 std::pair<Entry*, bool>
@@ -130,6 +175,7 @@ Fib::insert(const Name& prefix)
 
   nte.setFibEntry(make_unique<Entry>(prefix));
   ++m_nItems;
+  this->bumpDmifGeneration();
   return std::make_pair(nte.getFibEntry(), true);
 }
 
@@ -143,6 +189,7 @@ Fib::erase(name_tree::Entry* nte, bool canDeleteNte)
     m_nameTree.eraseIfEmpty(nte);
   }
   --m_nItems;
+  this->bumpDmifGeneration();
 }
 
 void
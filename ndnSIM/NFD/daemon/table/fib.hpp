@@ -83,9 +83,17 @@ public: // lookup
   Entry*
   findExactMatch(const Name& prefix);
 
+  /** \brief performs an exact match lookup among entries that have learned \p forwarderId
+   */
   Entry*
   findExactMatch_dmif(const Name& prefix, uint32_t forwarderId);
 
+  /** \brief performs a longest prefix match for learning or resolving forwarderIds
+   *  \return the entry, or nullptr if no entry matches (instead of an empty entry)
+   */
+  Entry*
+  findLongestPrefixMatch_dmif(const Name& prefix);
+
 public: // mutation
   /** \brief Maximum number of components in a FIB entry prefix.
    *
@@ -117,6 +125,30 @@ public: // mutation
   void
   removeNextHop(Entry& entry, const Face& face);
 
+  /** \brief records that \p forwarderId can serve entry's prefix
+   *  \return whether forwarderId was newly added
+   */
+  bool
+  addForwarderId(Entry& entry, uint32_t forwarderId);
+
+  /** \brief forgets that \p forwarderId can serve entry's prefix
+   *  \return whether forwarderId was present
+   */
+  bool
+  removeForwarderId(Entry& entry, uint32_t forwarderId);
+
+  /** \brief changes whenever a DMIF lookup result may have changed
+   *
+   *  Changed when an entry is inserted or erased (including by removeNextHop), or when a
+   *  forwarderId is learned or forgotten. Values are never reused, even by another FIB.
+   *  Callers caching DMIF lookups compare it to decide whether a cached result is stale.
+   */
+  uint64_t
+  getDmifGeneration() const
+  {
+    return m_dmifGeneration;
+  }
+
 public: // enumeration
   typedef boost::transformed_range<name_tree::GetTableEntry<Entry>, const name_tree::Range> Range;
   typedef boost::range_iterator<Range>::type const_iterator;
@@ -151,12 +183,16 @@ private:
   void
   erase(name_tree::Entry* nte, bool canDeleteNte = true);
 
+  void
+  bumpDmifGeneration();
+
   Range
   getRange() const;
 
 private:
   NameTree& m_nameTree;
   size_t m_nItems;
+  uint64_t m_dmifGeneration;
 
   /** \brief the empty FIB entry.
    *
@@ -34,7 +34,6 @@ Entry::Entry(const Name& name, Node* node)
   , m_parent(nullptr)
 {
   BOOST_ASSERT(node != nullptr);
-  m_forwarderId = -1;
 }
 
 void
@@ -141,23 +140,19 @@ Entry::setStrategyChoiceEntry(unique_ptr<strategy_choice::Entry> strategyChoiceE
 }
 
 /************ DMIF *************/
-void
-Entry::setForwarderId(const uint32_t id){
-	m_forwarderId = id;
-}
 uint32_t
 Entry::getForwarderId() const
 {
-//	LogManager::AddLogWithNodeId("name-tree-entry.cpp->getForwarderId");
-	try {
-//		LogManager::AddLogWithNodeId("name-tree-entry.cpp->getForwarderId.m_forwarderId", m_forwarderId);
-		return m_forwarderId;
-//		return 2;
-	}
-	catch(const std::exception& ex) {
-//		LogManager::AddLogWithNodeId("name-tree-entry.cpp->getForwarderId.exception", ex.what());
-		return -1;
-	}
+  if (m_forwarderIds.empty()) {
+    return std::numeric_limits<uint32_t>::max();
+  }
+  return m_forwarderIds.back();
+}
+
+bool
+Entry::hasForwarderId(uint32_t forwarderId) const
+{
+  return std::find(m_forwarderIds.begin(), m_forwarderIds.end(), forwarderId) != m_forwarderIds.end();
 }
 /************ DMIF *************/
 
@@ -164,10 +164,23 @@ public: // attached table entries
     return tableEntry.m_nameTreeEntry;
   }
 
-public:
-	uint32_t
-	getForwarderId() const;
-	void setForwarderId(const uint32_t id);
+public: // DMIF
+  /** \return the most recently learned forwarderId, or uint32_t(-1) if none
+   */
+  uint32_t
+  getForwarderId() const;
+
+  /** \return forwarderIds learned for this name, oldest first
+   *  \note Use NameTree::addForwarderId to modify, so that the DMIF index stays in sync.
+   */
+  const std::vector<uint32_t>&
+  getForwarderIds() const
+  {
+    return m_forwarderIds;
+  }
+
+  bool
+  hasForwarderId(uint32_t forwarderId) const;
 
 private:
   Name m_name;
@@ -181,10 +194,11 @@ private:
   unique_ptr<strategy_choice::Entry> m_strategyChoiceEntry;
 
   /****** DMIF ********/
-  uint32_t m_forwarderId;
+  std::vector<uint32_t> m_forwarderIds;
   /****** DMIF ********/
 
   friend Node* getNode(const Entry& entry);
+  friend class Hashtable;
 };
 
 /** \brief a functor to get a table entry from a name tree entry
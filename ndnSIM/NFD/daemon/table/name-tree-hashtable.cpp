@@ -25,69 +25,25 @@
 
 #include "name-tree-hashtable.hpp"
 #include "core/logger.hpp"
-#include "core/city-hash.hpp"
-#include "../src/ndnSIM/LogManager.cpp"
+
+#include <boost/pool/singleton_pool.hpp>
 
 namespace nfd {
 namespace name_tree {
 
 NFD_LOG_INIT("NameTreeHashtable");
 
-class Hash32
-{
-public:
-  static HashValue
-  compute(const void* buffer, size_t length)
-  {
-    return static_cast<HashValue>(CityHash32(reinterpret_cast<const char*>(buffer), length));
-  }
-};
-
-class Hash64
-{
-public:
-  static HashValue
-  compute(const void* buffer, size_t length)
-  {
-    return static_cast<HashValue>(CityHash64(reinterpret_cast<const char*>(buffer), length));
-  }
-};
-
-/** \brief a type with compute static method to compute hash value from a raw buffer
- */
-using HashFunc = std::conditional<(sizeof(HashValue) > 4), Hash64, Hash32>::type;
-
 HashValue
 computeHash(const Name& name, size_t prefixLen)
 {
-  name.wireEncode(); // ensure wire buffer exists
-
-  HashValue h = 0;
-  for (size_t i = 0, last = std::min(prefixLen, name.size()); i < last; ++i) {
-    const name::Component& comp = name[i];
-    h ^= HashFunc::compute(comp.wire(), comp.size());
-  }
-  return h;
+  return name.getPrefixHashes()[std::min(prefixLen, name.size())];
 }
 
 HashSequence
 computeHashes(const Name& name, size_t prefixLen)
 {
-  name.wireEncode(); // ensure wire buffer exists
-
-  size_t last = std::min(prefixLen, name.size());
-  HashSequence seq;
-  seq.reserve(last + 1);
-
-  HashValue h = 0;
-  seq.push_back(h);
-
-  for (size_t i = 0; i < last; ++i) {
-    const name::Component& comp = name[i];
-    h ^= HashFunc::compute(comp.wire(), comp.size());
-    seq.push_back(h);
-  }
-  return seq;
+  const HashSequence& hashes = name.getPrefixHashes();
+  return HashSequence(hashes.begin(), hashes.begin() + std::min(prefixLen, name.size()) + 1);
 }
 
 Node::Node(HashValue h, const Name& name)
@@ -104,20 +60,61 @@ Node::~Node()
   BOOST_ASSERT(next == nullptr);
 }
 
+/** \brief pool of Node storage
+ *  \note NameTree is only accessed from the forwarding thread, so the pool is not locked.
+ */
+using NodePool = boost::singleton_pool<Node, sizeof(Node), boost::default_user_allocator_new_delete,
+                                       boost::details::pool::null_mutex>;
+
+void*
+Node::operator new(size_t size)
+{
+  BOOST_ASSERT(size == sizeof(Node));
+  void* p = NodePool::malloc();
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void
+Node::operator delete(void* p)
+{
+  NodePool::free(p);
+}
+
 Node*
 getNode(const Entry& entry)
 {
   return entry.m_node;
 }
 
+std::ostream&
+operator<<(std::ostream& os, HashtableLayout layout)
+{
+  switch (layout) {
+    case HashtableLayout::CHAINED:
+      return os << "chained";
+    case HashtableLayout::OPEN_ADDRESSING:
+      return os << "open-addressing";
+  }
+  return os << static_cast<int>(layout);
+}
+
 HashtableOptions::HashtableOptions(size_t size)
   : initialSize(size)
   , minSize(size)
 {
 }
 
+constexpr uint8_t Hashtable::EMPTY;
+constexpr uint8_t Hashtable::TOMBSTONE;
+constexpr uint8_t Hashtable::FULL;
+
 Hashtable::Hashtable(const Options& options)
-  : m_options(options)
+  : m_nMigrated(0)
+  , m_migrationStep(options.migrationStep)
+  , m_options(options)
   , m_size(0)
 {
   BOOST_ASSERT(m_options.minSize > 0);
@@ -130,7 +127,16 @@ Hashtable::Hashtable(const Options& options)
   BOOST_ASSERT(m_options.shrinkFactor > 0.0);
   BOOST_ASSERT(m_options.shrinkFactor < 1.0);
 
-  m_buckets.resize(options.initialSize);
+  if (m_options.layout == HashtableLayout::CHAINED) {
+    m_buckets.resize(options.initialSize);
+  }
+  else {
+    // an open addressing table must always keep an empty slot to terminate probing
+    BOOST_ASSERT(m_options.expandLoadFactor < 1.0);
+    BOOST_ASSERT(m_options.migrationStep > 0);
+    m_slots.ctrl.resize(options.initialSize, EMPTY);
+    m_slots.nodes.resize(options.initialSize, nullptr);
+  }
   this->computeThresholds();
 }
 
@@ -142,6 +148,14 @@ Hashtable::~Hashtable()
       delete node;
     });
   }
+
+  for (const SlotArray* slots : {&m_slots, &m_oldSlots}) {
+    for (size_t i = 0; i < slots->ctrl.size(); ++i) {
+      if (slots->ctrl[i] & FULL) {
+        delete slots->nodes[i];
+      }
+    }
+  }
 }
 
 void
@@ -181,6 +195,38 @@ Hashtable::detach(size_t bucket, Node* node)
 std::pair<const Node*, bool>
 Hashtable::findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool allowInsert)
 {
+  if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+    size_t i = this->findSlot(m_slots, name, prefixLen, h);
+    if (i < m_slots.ctrl.size()) {
+      NFD_LOG_TRACE("found " << name.getPrefix(prefixLen) << " hash=" << h << " slot=" << i);
+      return {m_slots.nodes[i], false};
+    }
+    if (this->isMigrating()) {
+      i = this->findSlot(m_oldSlots, name, prefixLen, h);
+      if (i < m_oldSlots.ctrl.size()) {
+        NFD_LOG_TRACE("found " << name.getPrefix(prefixLen) << " hash=" << h << " old-slot=" << i);
+        return {m_oldSlots.nodes[i], false};
+      }
+    }
+
+    if (!allowInsert) {
+      NFD_LOG_TRACE("not-found " << name.getPrefix(prefixLen) << " hash=" << h);
+      return {nullptr, false};
+    }
+
+    Node* node = new Node(h, name.getPrefix(prefixLen));
+    this->placeInSlots(node);
+    NFD_LOG_TRACE("insert " << node->entry.getName() << " hash=" << h);
+    ++m_size;
+
+    this->migrate(m_migrationStep);
+    if (m_size > m_expandThreshold) {
+      this->resize(static_cast<size_t>(m_options.expandFactor * this->getNBuckets()));
+    }
+
+    return {node, true};
+  }
+
   size_t bucket = this->computeBucketIndex(h);
 
   for (const Node* node = m_buckets[bucket]; node != nullptr; node = node->next) {
@@ -208,73 +254,63 @@ Hashtable::findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool al
 }
 
 /********* DMIF **********/
-std::pair<const Node*, bool>
-Hashtable::findOrInsert_dmif(const Name& name, size_t prefixLen, HashValue h, bool allowInsert, uint32_t forwarderId)
-{
-//	LogManager::AddLogWithNodeId("name-tree-hashtable.cpp->findOrInsert_dmif.start");
-//	LogManager::AddLogWithNodeId("name-tree-hashtable.cpp->findOrInsert_dmif.name", name.toUri());
-//	LogManager::AddLogWithNodeId("name-tree-hashtable.cpp->findOrInsert_dmif.forwarderId", forwarderId);
-
-	size_t bucket = this->computeBucketIndex(h);
-//	LogManager::AddLogWithNodeId("name-tree-hashtable.cpp->findOrInsert_dmif.1");
-
-	try {
-//		LogManager::AddLogWithNodeId("name-tree-hashtable.cpp->findOrInsert_dmif.2");
-		for (const Node* node = m_buckets[bucket]; node != nullptr; node = node->next) {
-//			LogManager::AddLogWithNodeId("name-tree-hashtable.cpp->findOrInsert_dmif.2.1");
-			//LogManager::AddLogWithNodeId("name-tree-hashtable.cpp->findOrInsert_dmif.loop.node.forwarderId", node->entry.getFibEntry()->getForwarderId());
-//			fib::Entry* fibEntry = node->entry.getFibEntry();
-//			LogManager::AddLogWithNodeId("name-tree-hashtable.cpp->findOrInsert_dmif.2.1.1");
-			//uint32_t fi = fibEntry->getForwarderId();
-			uint32_t fi = node->entry.getForwarderId();
-//			LogManager::AddLogWithNodeId("name-tree-hashtable.cpp->findOrInsert_dmif.2.1.2");
-//			LogManager::AddLogWithNodeId("name-tree-hashtable.cpp->findOrInsert_dmif.entry.forwarderId", fi);
-
-			if (node->hash == h
-					&& name.compare(0, prefixLen, node->entry.getName()) == 0
-					&& fi == forwarderId //DMIF condition
-							)
-			{
-				NFD_LOG_TRACE("found " << name.getPrefix(prefixLen) << " hash=" << h << " bucket=" << bucket);
-//				LogManager::AddLogWithNodeId("name-tree-hashtable.cpp->findOrInsert_dmif.2.2");
-//				LogManager::AddLogWithNodeId("name-tree-hashtable.cpp->findOrInsert_dmif.found");
-				return {node, false};
-			}
-			else{
-//				LogManager::AddLogWithNodeId("name-tree-hashtable.cpp->findOrInsert_dmif.not-found");
-			}
-//			LogManager::AddLogWithNodeId("name-tree-hashtable.cpp->findOrInsert_dmif.2.3");
-		}
-//		LogManager::AddLogWithNodeId("name-tree-hashtable.cpp->findOrInsert_dmif.3");
-	} catch (std::exception& ex) {
-//		LogManager::AddLogWithNodeId("name-tree-hashtable.cpp->findOrInsert_dmif.exception", ex.what());
-	}
-
-//	LogManager::AddLogWithNodeId("name-tree-hashtable.cpp->findOrInsert_dmif.4");
-//	LogManager::AddLogWithNodeId("name-tree-hashtable.cpp->findOrInsert_dmif.allowInsert", allowInsert);
-	if (!allowInsert) {
-//		LogManager::AddLogWithNodeId("name-tree-hashtable.cpp->findOrInsert_dmif.5");
-		NFD_LOG_TRACE("not-found " << name.getPrefix(prefixLen) << " hash=" << h << " bucket=" << bucket);
-//		LogManager::AddLogWithNodeId("name-tree-hashtable.cpp->findOrInsert_dmif.not-found.completed");
-		return {nullptr, false};
-	}
-
-//	LogManager::AddLogWithNodeId("name-tree-hashtable.cpp->findOrInsert_dmif.6");
-	Node* node = new Node(h, name.getPrefix(prefixLen));
-//	LogManager::AddLogWithNodeId("name-tree-hashtable.cpp->findOrInsert_dmif.7");
-	this->attach(bucket, node);
-//	LogManager::AddLogWithNodeId("name-tree-hashtable.cpp->findOrInsert_dmif.8");
-//	LogManager::AddLogWithNodeId("name-tree-hashtable.cpp->findOrInsert_dmif.inserted");
-	NFD_LOG_TRACE("insert " << node->entry.getName() << " hash=" << h << " bucket=" << bucket);
-	++m_size;
-//	LogManager::AddLogWithNodeId("name-tree-hashtable.cpp->findOrInsert_dmif.9");
-	if (m_size > m_expandThreshold) {
-//		LogManager::AddLogWithNodeId("name-tree-hashtable.cpp->findOrInsert_dmif.10");
-		this->resize(static_cast<size_t>(m_options.expandFactor * this->getNBuckets()));
-	}
-//	LogManager::AddLogWithNodeId("name-tree-hashtable.cpp->findOrInsert_dmif.11");
-//	LogManager::AddLogWithNodeId("name-tree-hashtable.cpp->findOrInsert_dmif.not-found.completed");
-	return {node, true};
+const Node*
+Hashtable::findInDmifIndex(const Name& name, size_t prefixLen, HashValue h, uint32_t forwarderId) const
+{
+  auto range = m_dmifIndex.equal_range(DmifKey(h, forwarderId));
+  for (auto it = range.first; it != range.second; ++it) {
+    const Node* node = it->second;
+    if (name.compare(0, prefixLen, node->entry.getName()) == 0) {
+      NFD_LOG_TRACE("found-dmif " << name.getPrefix(prefixLen) << " hash=" << h <<
+                    " forwarderId=" << forwarderId);
+      return node;
+    }
+  }
+
+  NFD_LOG_TRACE("not-found-dmif " << name.getPrefix(prefixLen) << " hash=" << h <<
+                " forwarderId=" << forwarderId);
+  return nullptr;
+}
+
+bool
+Hashtable::addForwarderId(Node* node, uint32_t forwarderId)
+{
+  BOOST_ASSERT(node != nullptr);
+  if (node->entry.hasForwarderId(forwarderId)) {
+    return false;
+  }
+
+  node->entry.m_forwarderIds.push_back(forwarderId);
+  m_dmifIndex.emplace(DmifKey(node->hash, forwarderId), node);
+  return true;
+}
+
+bool
+Hashtable::removeForwarderId(Node* node, uint32_t forwarderId)
+{
+  BOOST_ASSERT(node != nullptr);
+  std::vector<uint32_t>& ids = node->entry.m_forwarderIds;
+  auto it = std::find(ids.begin(), ids.end(), forwarderId);
+  if (it == ids.end()) {
+    return false;
+  }
+
+  ids.erase(it);
+  this->eraseFromDmifIndex(node->hash, forwarderId, node);
+  return true;
+}
+
+void
+Hashtable::eraseFromDmifIndex(HashValue h, uint32_t forwarderId, const Node* node)
+{
+  auto range = m_dmifIndex.equal_range(DmifKey(h, forwarderId));
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second == node) {
+      m_dmifIndex.erase(it);
+      return;
+    }
+  }
+  BOOST_ASSERT_MSG(false, "node is missing from DMIF index");
 }
 /********* DMIF **********/
 
@@ -287,15 +323,18 @@ Hashtable::find(const Name& name, size_t prefixLen) const
 
 /********* DMIF **********/
 const Node*
-Hashtable::find_dmif(const Name& name, size_t prefixLen, uint32_t forwarderId) const {
-	try {
-//		LogManager::AddLogWithNodeId("name-tree-hashtable.cpp->find_dmif.start");
-		HashValue h = computeHash(name, prefixLen);
-		return const_cast<Hashtable*>(this)->findOrInsert_dmif(name, prefixLen, h, false, forwarderId).first;
-	} catch (std::exception& ex) {
-//		LogManager::AddLogWithNodeId("name-tree-hashtable.cpp->findOrInsert_dmif.exception", ex.what());
-		return nullptr;
-	}
+Hashtable::find_dmif(const Name& name, size_t prefixLen, uint32_t forwarderId) const
+{
+  HashValue h = computeHash(name, prefixLen);
+  return this->findInDmifIndex(name, prefixLen, h, forwarderId);
+}
+
+const Node*
+Hashtable::find_dmif(const Name& name, size_t prefixLen, uint32_t forwarderId,
+                     const HashSequence& hashes) const
+{
+  BOOST_ASSERT(hashes.at(prefixLen) == computeHash(name, prefixLen));
+  return this->findInDmifIndex(name, prefixLen, hashes[prefixLen], forwarderId);
 }
 /********* DMIF **********/
 
@@ -319,10 +358,30 @@ Hashtable::erase(Node* node)
   BOOST_ASSERT(node != nullptr);
   BOOST_ASSERT(node->entry.getParent() == nullptr);
 
-  size_t bucket = this->computeBucketIndex(node->hash);
-  NFD_LOG_TRACE("erase " << node->entry.getName() << " hash=" << node->hash << " bucket=" << bucket);
+  for (uint32_t forwarderId : node->entry.m_forwarderIds) {
+    this->eraseFromDmifIndex(node->hash, forwarderId, node);
+  }
+
+  if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+    NFD_LOG_TRACE("erase " << node->entry.getName() << " hash=" << node->hash);
+    size_t i = this->findSlot(m_slots, node);
+    if (i < m_slots.ctrl.size()) {
+      this->clearSlot(i);
+    }
+    else {
+      i = this->findSlot(m_oldSlots, node);
+      BOOST_ASSERT(i < m_oldSlots.ctrl.size());
+      m_oldSlots.ctrl[i] = TOMBSTONE;
+      m_oldSlots.nodes[i] = nullptr;
+    }
+    this->migrate(m_migrationStep);
+  }
+  else {
+    size_t bucket = this->computeBucketIndex(node->hash);
+    NFD_LOG_TRACE("erase " << node->entry.getName() << " hash=" << node->hash << " bucket=" << bucket);
+    this->detach(bucket, node);
+  }
 
-  this->detach(bucket, node);
   delete node;
   --m_size;
 
@@ -349,6 +408,26 @@ Hashtable::resize(size_t newNBuckets)
   }
   NFD_LOG_DEBUG("resize from=" << this->getNBuckets() << " to=" << newNBuckets);
 
+  if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+    // finish an earlier resize, so that at most two slot arrays exist
+    this->migrate(m_oldSlots.ctrl.size());
+
+    m_oldSlots = std::move(m_slots);
+    m_nMigrated = 0;
+    m_slots.ctrl.assign(newNBuckets, EMPTY);
+    m_slots.nodes.assign(newNBuckets, nullptr);
+    this->computeThresholds();
+
+    // migrate fast enough to be done before the next resize can be triggered
+    size_t nOpsBeforeResize = std::min(m_expandThreshold > m_size ? m_expandThreshold - m_size : 0,
+                                       m_size > m_shrinkThreshold ? m_size - m_shrinkThreshold : 0);
+    m_migrationStep = std::max(m_options.migrationStep,
+                               m_oldSlots.ctrl.size() / std::max<size_t>(nOpsBeforeResize, 1) + 1);
+
+    this->migrate(m_migrationStep);
+    return;
+  }
+
   std::vector<Node*> oldBuckets;
   oldBuckets.swap(m_buckets);
   m_buckets.resize(newNBuckets);
@@ -363,5 +442,163 @@ Hashtable::resize(size_t newNBuckets)
   this->computeThresholds();
 }
 
+const Node*
+Hashtable::getFirstNode() const
+{
+  if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+    const Node* node = findOccupiedSlot(m_slots, 0);
+    return node != nullptr ? node : findOccupiedSlot(m_oldSlots, m_nMigrated);
+  }
+
+  for (const Node* head : m_buckets) {
+    if (head != nullptr) {
+      return head;
+    }
+  }
+  return nullptr;
+}
+
+const Node*
+Hashtable::getNextNode(const Node* node) const
+{
+  BOOST_ASSERT(node != nullptr);
+
+  if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+    // nodes in m_slots are enumerated before not yet migrated nodes in m_oldSlots
+    size_t i = this->findSlot(m_slots, node);
+    if (i < m_slots.ctrl.size()) {
+      const Node* next = findOccupiedSlot(m_slots, i + 1);
+      return next != nullptr ? next : findOccupiedSlot(m_oldSlots, m_nMigrated);
+    }
+    i = this->findSlot(m_oldSlots, node);
+    BOOST_ASSERT(i < m_oldSlots.ctrl.size());
+    return findOccupiedSlot(m_oldSlots, i + 1);
+  }
+
+  if (node->next != nullptr) {
+    return node->next;
+  }
+  for (size_t bucket = this->computeBucketIndex(node->hash) + 1; bucket < m_buckets.size(); ++bucket) {
+    if (m_buckets[bucket] != nullptr) {
+      return m_buckets[bucket];
+    }
+  }
+  return nullptr;
+}
+
+size_t
+Hashtable::findSlot(const SlotArray& slots, const Name& name, size_t prefixLen, HashValue h) const
+{
+  size_t nSlots = slots.ctrl.size();
+  if (nSlots == 0) {
+    return nSlots;
+  }
+
+  // the fingerprint in the control byte rules out almost every other node in the probe run
+  // without touching the node, so Name comparison is only done on a likely match
+  uint8_t ctrl = makeControl(h);
+  for (size_t i = h % nSlots, nProbes = 0; nProbes < nSlots; i = (i + 1) % nSlots, ++nProbes) {
+    if (slots.ctrl[i] == EMPTY) {
+      break;
+    }
+    if (slots.ctrl[i] == ctrl) {
+      const Node* node = slots.nodes[i];
+      if (node->hash == h && name.compare(0, prefixLen, node->entry.getName()) == 0) {
+        return i;
+      }
+    }
+  }
+  return nSlots;
+}
+
+size_t
+Hashtable::findSlot(const SlotArray& slots, const Node* node) const
+{
+  size_t nSlots = slots.ctrl.size();
+  if (nSlots == 0) {
+    return nSlots;
+  }
+
+  for (size_t i = node->hash % nSlots, nProbes = 0; nProbes < nSlots; i = (i + 1) % nSlots, ++nProbes) {
+    if (slots.ctrl[i] == EMPTY) {
+      break;
+    }
+    if (slots.nodes[i] == node) {
+      return i;
+    }
+  }
+  return nSlots;
+}
+
+const Node*
+Hashtable::findOccupiedSlot(const SlotArray& slots, size_t i)
+{
+  for (; i < slots.ctrl.size(); ++i) {
+    if (slots.ctrl[i] & FULL) {
+      return slots.nodes[i];
+    }
+  }
+  return nullptr;
+}
+
+void
+Hashtable::placeInSlots(Node* node)
+{
+  size_t nSlots = m_slots.ctrl.size();
+  size_t i = node->hash % nSlots;
+  while (m_slots.ctrl[i] != EMPTY) {
+    i = (i + 1) % nSlots;
+  }
+
+  m_slots.ctrl[i] = makeControl(node->hash);
+  m_slots.nodes[i] = node;
+}
+
+void
+Hashtable::clearSlot(size_t i)
+{
+  size_t nSlots = m_slots.ctrl.size();
+
+  // backward shift deletion: a later node of the probe run moves into the hole unless its
+  // home slot lies cyclically in (i, j], so m_slots never needs tombstones
+  for (size_t j = (i + 1) % nSlots; m_slots.ctrl[j] != EMPTY; j = (j + 1) % nSlots) {
+    size_t home = m_slots.nodes[j]->hash % nSlots;
+    bool isHomeInRange = i <= j ? (i < home && home <= j) : (i < home || home <= j);
+    if (!isHomeInRange) {
+      m_slots.ctrl[i] = m_slots.ctrl[j];
+      m_slots.nodes[i] = m_slots.nodes[j];
+      i = j;
+    }
+  }
+
+  m_slots.ctrl[i] = EMPTY;
+  m_slots.nodes[i] = nullptr;
+}
+
+void
+Hashtable::migrate(size_t nSlots)
+{
+  if (!this->isMigrating()) {
+    return;
+  }
+
+  // a migrated slot becomes a tombstone rather than empty, so that probe runs through it
+  // still reach the nodes that have not been migrated yet
+  size_t end = std::min(m_oldSlots.ctrl.size(), m_nMigrated + nSlots);
+  for (; m_nMigrated < end; ++m_nMigrated) {
+    if (m_oldSlots.ctrl[m_nMigrated] & FULL) {
+      this->placeInSlots(m_oldSlots.nodes[m_nMigrated]);
+      m_oldSlots.ctrl[m_nMigrated] = TOMBSTONE;
+      m_oldSlots.nodes[m_nMigrated] = nullptr;
+    }
+  }
+
+  if (!this->isMigrating()) {
+    NFD_LOG_DEBUG("migrated " << m_oldSlots.ctrl.size() << " slots");
+    m_oldSlots = SlotArray();
+    m_nMigrated = 0;
+  }
+}
+
 } // namespace name_tree
 } // namespace nfd
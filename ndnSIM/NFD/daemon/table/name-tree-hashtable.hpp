@@ -40,15 +40,18 @@ using HashValue = size_t;
 /** \brief a sequence of hash values
  *  \sa computeHashes
  */
-using HashSequence = std::vector<HashValue>;
+using HashSequence = Name::PrefixHashes;
 
 /** \brief computes hash value of \p name.getPrefix(prefixLen)
+ *  \note The value is taken from \p name.getPrefixHashes(), which is computed once per Name.
  */
 HashValue
 computeHash(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::max());
 
 /** \brief computes hash values for each prefix of \p name.getPrefix(prefixLen)
  *  \return a hash sequence, where the i-th hash value equals computeHash(name, i)
+ *  \note Lookups that cover the whole name should use \p name.getPrefixHashes() directly,
+ *        which avoids copying the sequence.
  */
 HashSequence
 computeHashes(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::max());
@@ -57,6 +60,7 @@ computeHashes(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::
  *
  *  Zero or more nodes can be added to a hashtable bucket. They are organized as
  *  a doubly linked list through prev and next pointers.
+ *  In the open addressing layout, prev and next are unused and stay nullptr.
  */
 class Node : noncopyable
 {
@@ -71,6 +75,17 @@ public:
    */
   ~Node();
 
+  /** \brief allocates storage for a node
+   *
+   *  Nodes are created and deleted at the rate of incoming Interests, so their storage is
+   *  taken from a free list shared by all hashtables instead of the heap.
+   */
+  static void*
+  operator new(size_t size);
+
+  static void
+  operator delete(void* p);
+
 public:
   const HashValue hash;
   Node* prev;
@@ -101,6 +116,23 @@ foreachNode(N* head, const F& func)
   }
 }
 
+/** \brief how Hashtable resolves collisions
+ */
+enum class HashtableLayout {
+  /** \brief each bucket is a doubly linked list of nodes;
+   *         the whole table is rehashed at once when it is resized
+   */
+  CHAINED,
+  /** \brief nodes are kept in a flat slot array with linear probing;
+   *         a control byte per slot holds a fingerprint of the node's hash value,
+   *         and the table is migrated a few slots at a time when it is resized
+   */
+  OPEN_ADDRESSING
+};
+
+std::ostream&
+operator<<(std::ostream& os, HashtableLayout layout);
+
 /** \brief provides options for Hashtable
  */
 class HashtableOptions
@@ -137,13 +169,23 @@ public:
   /** \brief when hashtable is shrunk, its new size is max(nBuckets*shrinkFactor, minSize)
    */
   float shrinkFactor = 0.5;
+
+  /** \brief collision resolution
+   */
+  HashtableLayout layout = HashtableLayout::CHAINED;
+
+  /** \brief minimal number of old slots migrated by each insert or erase while an open
+   *         addressing hashtable is being resized
+   */
+  size_t migrationStep = 16;
 };
 
 /** \brief a hashtable for fast exact name lookup
  *
  *  The Hashtable contains a number of buckets.
  *  Each node is placed into a bucket determined by a hash value computed from its name.
- *  Hash collision is resolved through a doubly linked list in each bucket.
+ *  Hash collision is resolved through a doubly linked list in each bucket, or by linear
+ *  probing in the open addressing layout (see HashtableLayout).
  *  The number of buckets is adjusted according to how many nodes are stored.
  */
 class Hashtable
@@ -171,7 +213,7 @@ public:
   size_t
   getNBuckets() const
   {
-    return m_buckets.size();
+    return m_options.layout == HashtableLayout::CHAINED ? m_buckets.size() : m_slots.ctrl.size();
   }
 
   /** \return bucket index for hash value h
@@ -184,23 +226,63 @@ public:
 
   /** \return i-th bucket
    *  \pre bucket < getNBuckets()
+   *  \pre the hashtable uses the chained layout
    */
   const Node*
   getBucket(size_t bucket) const
   {
+    BOOST_ASSERT(m_options.layout == HashtableLayout::CHAINED);
     BOOST_ASSERT(bucket < this->getNBuckets());
     return m_buckets[bucket]; // don't use m_bucket.at() for better performance
   }
 
+  /** \return first node in enumeration order, or nullptr if the hashtable is empty
+   */
+  const Node*
+  getFirstNode() const;
+
+  /** \return node after \p node in enumeration order, or nullptr if \p node is the last
+   *  \pre node exists in this hashtable
+   *  \warning Enumeration order changes when a node is inserted or erased.
+   */
+  const Node*
+  getNextNode(const Node* node) const;
+
   /** \brief find node for name.getPrefix(prefixLen)
    *  \pre name.size() > prefixLen
    */
   const Node*
   find(const Name& name, size_t prefixLen) const;
 
+  /** \brief find node for name.getPrefix(prefixLen) that has learned \p forwarderId
+   *  \pre name.size() > prefixLen
+   *
+   *  The lookup goes through the (hash, forwarderId) index, so its cost does not depend
+   *  on how many forwarderIds have been learned for the same name.
+   */
   const Node*
   find_dmif(const Name& name, size_t prefixLen, uint32_t forwarderId) const;
 
+  /** \brief find node for name.getPrefix(prefixLen) that has learned \p forwarderId
+   *  \pre name.size() > prefixLen
+   *  \pre hashes == computeHashes(name)
+   */
+  const Node*
+  find_dmif(const Name& name, size_t prefixLen, uint32_t forwarderId,
+            const HashSequence& hashes) const;
+
+  /** \brief record that \p forwarderId has been learned for node's name
+   *  \return whether forwarderId was newly added
+   */
+  bool
+  addForwarderId(Node* node, uint32_t forwarderId);
+
+  /** \brief forget \p forwarderId for node's name
+   *  \return whether forwarderId was present
+   */
+  bool
+  removeForwarderId(Node* node, uint32_t forwarderId);
+
   /** \brief find node for name.getPrefix(prefixLen)
    *  \pre name.size() > prefixLen
    *  \pre hashes == computeHashes(name)
@@ -236,8 +318,11 @@ private:
   findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool allowInsert);
 
   /****** DMIF *******/
-  std::pair<const Node*, bool>
-  findOrInsert_dmif(const Name& name, size_t prefixLen, HashValue h, bool allowInsert, uint32_t forwarderId);
+  const Node*
+  findInDmifIndex(const Name& name, size_t prefixLen, HashValue h, uint32_t forwarderId) const;
+
+  void
+  eraseFromDmifIndex(HashValue h, uint32_t forwarderId, const Node* node);
   /****** DMIF *******/
 
   void
@@ -246,12 +331,93 @@ private:
   void
   resize(size_t newNBuckets);
 
+private: // open addressing layout
+  /** \brief a flat array of slots
+   */
+  struct SlotArray
+  {
+    /** \brief EMPTY, TOMBSTONE, or FULL | fingerprint of nodes[i]->hash
+     */
+    std::vector<uint8_t> ctrl;
+    std::vector<Node*> nodes;
+  };
+
+  static constexpr uint8_t EMPTY = 0x00;
+  static constexpr uint8_t TOMBSTONE = 0x01; ///< only in m_oldSlots: migrated or erased node
+  static constexpr uint8_t FULL = 0x80;
+
+  /** \return control byte of a slot holding a node with hash value h
+   */
+  static uint8_t
+  makeControl(HashValue h)
+  {
+    return FULL | static_cast<uint8_t>(h >> (sizeof(HashValue) * 8 - 7));
+  }
+
+  /** \return index of the slot holding name.getPrefix(prefixLen), or slots.ctrl.size() if none
+   */
+  size_t
+  findSlot(const SlotArray& slots, const Name& name, size_t prefixLen, HashValue h) const;
+
+  /** \return index of the slot holding node, or slots.ctrl.size() if none
+   */
+  size_t
+  findSlot(const SlotArray& slots, const Node* node) const;
+
+  /** \return node in the first occupied slot of slots at or after index i, or nullptr if none
+   */
+  static const Node*
+  findOccupiedSlot(const SlotArray& slots, size_t i);
+
+  /** \brief place node in the first empty slot of m_slots on its probe sequence
+   */
+  void
+  placeInSlots(Node* node);
+
+  /** \brief empty a slot of m_slots, shifting back later nodes of the same probe run
+   */
+  void
+  clearSlot(size_t i);
+
+  /** \brief move up to nSlots slots of m_oldSlots into m_slots
+   */
+  void
+  migrate(size_t nSlots);
+
+  bool
+  isMigrating() const
+  {
+    return m_nMigrated < m_oldSlots.ctrl.size();
+  }
+
 private:
   std::vector<Node*> m_buckets;
+  SlotArray m_slots;
+  SlotArray m_oldSlots; ///< slots being migrated into m_slots
+  size_t m_nMigrated; ///< number of slots of m_oldSlots already migrated
+  size_t m_migrationStep; ///< number of slots of m_oldSlots migrated per insert or erase
   Options m_options;
   size_t m_size;
   size_t m_expandThreshold;
   size_t m_shrinkThreshold;
+
+  /****** DMIF *******/
+  using DmifKey = std::pair<HashValue, uint32_t>;
+
+  struct DmifKeyHash
+  {
+    size_t
+    operator()(const DmifKey& key) const
+    {
+      return key.first ^ (static_cast<size_t>(key.second) * 0x9e3779b97f4a7c15ULL);
+    }
+  };
+
+  /** \brief secondary index from (name hash, forwarderId) to nodes;
+   *         multiple nodes share a key only when their name hashes collide
+   */
+  std::unordered_multimap<DmifKey, Node*, DmifKeyHash> m_dmifIndex;
+  /****** DMIF *******/
 };
 
 } // namespace name_tree
@@ -41,13 +41,18 @@ NameTree::NameTree(size_t nBuckets)
 {
 }
 
+NameTree::NameTree(const HashtableOptions& options)
+  : m_ht(options)
+{
+}
+
 Entry&
 NameTree::lookup(const Name& name, bool enforceMaxDepth)
 {
   NFD_LOG_TRACE("lookup " << name);
   size_t depth = enforceMaxDepth ? std::min(name.size(), getMaxDepth()) : name.size();
 
-  HashSequence hashes = computeHashes(name, depth);
+  const HashSequence& hashes = name.getPrefixHashes();
   const Node* node = nullptr;
   Entry* parent = nullptr;
 
@@ -155,24 +160,29 @@ NameTree::findExactMatch(const Name& name, size_t prefixLen) const
 
 /***** DMIF ******/
 Entry*
-NameTree::findExactMatch_dmif(const Name& name, size_t prefixLen, uint32_t forwarderId) const {
-	try {
-//		LogManager::AddLogWithNodeId( "name-tree.cpp->findExactMatch_dmif.start");
-//		LogManager::AddLogWithNodeId("fib.cpp->findExactMatch_dmif.name", name.toUri());
-//		LogManager::AddLogWithNodeId("fib.cpp->findExactMatch_dmif.forwarderId", forwarderId);
-		const Node* node = m_ht.find_dmif(name, std::min(name.size(), prefixLen), forwarderId);
-		return node == nullptr ? nullptr : &node->entry;
-	} catch (std::exception& ex) {
-//		LogManager::AddLogWithNodeId("name-tree.cpp->findExactMatch_dmif.exception", ex.what());
-		return nullptr;
-	}
+NameTree::findExactMatch_dmif(const Name& name, uint32_t forwarderId, size_t prefixLen) const
+{
+  const Node* node = m_ht.find_dmif(name, std::min(name.size(), prefixLen), forwarderId);
+  return node == nullptr ? nullptr : &node->entry;
+}
+
+bool
+NameTree::addForwarderId(Entry& entry, uint32_t forwarderId)
+{
+  return m_ht.addForwarderId(getNode(entry), forwarderId);
+}
+
+bool
+NameTree::removeForwarderId(Entry& entry, uint32_t forwarderId)
+{
+  return m_ht.removeForwarderId(getNode(entry), forwarderId);
 }
 /***** DMIF ******/
 
 Entry*
 NameTree::findLongestPrefixMatch(const Name& name, const EntrySelector& entrySelector) const
 {
-  HashSequence hashes = computeHashes(name);
+  const HashSequence& hashes = name.getPrefixHashes();
 
   for (ssize_t prefixLen = name.size(); prefixLen >= 0; --prefixLen) {
     const Node* node = m_ht.find(name, prefixLen, hashes);
@@ -39,6 +39,9 @@ public:
   explicit
   NameTree(size_t nBuckets = 1024);
 
+  explicit
+  NameTree(const HashtableOptions& options);
+
 public: // information
   /** \brief Maximum depth of the name tree.
    *
@@ -134,6 +137,21 @@ public: // mutation
   size_t
   eraseIfEmpty(Entry* entry, bool canEraseAncestors = true);
 
+public: // DMIF
+  /** \brief record that \p forwarderId can serve \p entry's name
+   *  \return whether forwarderId was newly added
+   */
+  bool
+  addForwarderId(Entry& entry, uint32_t forwarderId);
+
+  /** \brief forget \p forwarderId for \p entry's name
+   *  \return whether forwarderId was present
+   *  \note Use Fib::removeForwarderId for entries with a FIB entry, so that cached DMIF
+   *        resolutions are invalidated.
+   */
+  bool
+  removeForwarderId(Entry& entry, uint32_t forwarderId);
+
 public: // matching
   /** \brief exact match lookup
    *  \return entry with \p name.getPrefix(prefixLen), or nullptr if it does not exist
@@ -141,8 +159,13 @@ public: // matching
   Entry*
   findExactMatch(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::max()) const;
 
+  /** \brief exact match lookup restricted to entries that have learned \p forwarderId
+   *  \return entry with \p name.getPrefix(prefixLen) whose forwarderIds include \p forwarderId,
+   *          or nullptr if it does not exist
+   */
   Entry*
-  findExactMatch_dmif(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::max(), uint32_t forwarderId = -1) const;
+  findExactMatch_dmif(const Name& name, uint32_t forwarderId,
+                      size_t prefixLen = std::numeric_limits<size_t>::max()) const;
 
   /** \brief longest prefix matching
    *  \return entry whose name is a prefix of \p name and passes \p entrySelector,
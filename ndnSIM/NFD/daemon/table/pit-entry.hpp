@@ -30,6 +30,11 @@
 #include "pit-out-record.hpp"
 #include "core/scheduler.hpp"
 
+#include <boost/version.hpp>
+#if BOOST_VERSION >= 105800
+#include <boost/container/small_vector.hpp>
+#endif
+
 namespace nfd {
 
 namespace name_tree {
@@ -38,13 +43,27 @@ class Entry;
 
 namespace pit {
 
+/** \brief storage for in-records or out-records of an entry
+ *
+ *  Most entries have one to three records of each kind, which are kept inline in the entry
+ *  to avoid a heap allocation per record.
+ *  \warning Inserting or deleting a record invalidates iterators to other records.
+ */
+#if BOOST_VERSION >= 105800
+template<typename Record>
+using FaceRecordCollection = boost::container::small_vector<Record, 3>;
+#else
+template<typename Record>
+using FaceRecordCollection = std::vector<Record>;
+#endif
+
 /** \brief an unordered collection of in-records
  */
-typedef std::list<InRecord> InRecordCollection;
+typedef FaceRecordCollection<InRecord> InRecordCollection;
 
 /** \brief an unordered collection of out-records
  */
-typedef std::list<OutRecord> OutRecordCollection;
+typedef FaceRecordCollection<OutRecord> OutRecordCollection;
 
 /** \brief an Interest table entry
  *
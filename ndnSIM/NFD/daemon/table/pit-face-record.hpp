@@ -64,7 +64,7 @@ public:
   update(const Interest& interest);
 
 private:
-  Face& m_face;
+  Face* m_face; // a pointer keeps records move-assignable in their collection
   uint32_t m_lastNonce;
   time::steady_clock::TimePoint m_lastRenewed;
   time::steady_clock::TimePoint m_expiry;
@@ -73,7 +73,7 @@ private:
 inline Face&
 FaceRecord::getFace() const
 {
-  return m_face;
+  return *m_face;
 }
 
 inline uint32_t
@@ -25,9 +25,20 @@
 
 #include "pit.hpp"
 
+#include <boost/pool/pool_alloc.hpp>
+
 namespace nfd {
 namespace pit {
 
+/** \brief allocator of PIT entries
+ *
+ *  PIT entries live for about one round trip, so their storage (together with the shared_ptr
+ *  control block) is recycled through a free list instead of being returned to the heap.
+ *  The tables are only accessed from the forwarding thread, so the pool is not locked.
+ */
+using EntryAllocator = boost::fast_pool_allocator<Entry, boost::default_user_allocator_new_delete,
+                                                  boost::details::pool::null_mutex>;
+
 static inline bool
 nteHasPitEntries(const name_tree::Entry& nte)
 {
@@ -78,7 +89,7 @@ Pit::findOrInsert(const Interest& interest, bool allowInsert)
     return {nullptr, true};
   }
 
-  auto entry = make_shared<Entry>(interest);
+  auto entry = std::allocate_shared<Entry>(EntryAllocator(), interest);
   nte->insertPitEntry(entry);
   ++m_nItems;
   return {entry, true};
@@ -26,6 +26,8 @@
 #include "dummy-face.hpp"
 #include "dummy-transport.hpp"
 
+#include <ndn-cxx/lp/tags.hpp>
+
 namespace nfd {
 namespace face {
 namespace tests {
@@ -62,9 +64,23 @@ private:
   }
 
   virtual void
-  doSendData(const Data& data) override
+  doSendData(const Data& data, const DataDelivery& delivery) override
   {
+    // record the Data as the face would transmit it
     this->sentData.push_back(data);
+    Data& sent = this->sentData.back();
+    if (delivery.incomingFaceId) {
+      sent.setTag(make_shared<lp::IncomingFaceIdTag>(*delivery.incomingFaceId));
+    }
+    else {
+      sent.removeTag<lp::IncomingFaceIdTag>();
+    }
+    if (delivery.hopCount) {
+      sent.setTag(make_shared<lp::HopCountTag>(*delivery.hopCount));
+    }
+    else {
+      sent.removeTag<lp::HopCountTag>();
+    }
     this->afterSend(tlv::Data);
   }
 
@@ -47,7 +47,7 @@ private:
   }
 
   virtual void
-  doSendData(const Data& data) override
+  doSendData(const Data& data, const DataDelivery& delivery) override
   {
     BOOST_ASSERT(false);
   }
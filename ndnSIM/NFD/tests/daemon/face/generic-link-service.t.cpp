@@ -1348,6 +1348,66 @@ BOOST_AUTO_TEST_CASE(ReceivePrefixAnnouncementDropNack)
 
 BOOST_AUTO_TEST_SUITE_END() // LpFields
 
+BOOST_AUTO_TEST_SUITE(DmifUnicast)
+
+BOOST_AUTO_TEST_CASE(DirectiveInterestToLearnedNeighbor)
+{
+  GenericLinkService::Options options;
+  options.allowDmifUnicast = true;
+  initialize(options);
+
+  // Data sent by node 7 is received from endpoint 3
+  shared_ptr<Data> data = makeData("/A/B");
+  data->setForwarderId(7);
+  Transport::Packet received(lp::Packet(data->wireEncode()).wireEncode());
+  received.remoteEndpoint = 3;
+  transport->receivePacket(std::move(received));
+  BOOST_REQUIRE_EQUAL(receivedData.size(), 1);
+  BOOST_CHECK_EQUAL(receivedData.back().getForwarderId(), 7);
+
+  shared_ptr<Interest> interest = makeInterest("/A/B/C");
+  interest->setForwardingMode(ForwardingMode::Directive);
+  interest->setForwarderId(7);
+  face->sendInterest(*interest);
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 1);
+  BOOST_CHECK_EQUAL(transport->sentPackets.back().remoteEndpoint, 3);
+
+  // not learned yet
+  interest->setForwarderId(8);
+  face->sendInterest(*interest);
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 2);
+  BOOST_CHECK_EQUAL(transport->sentPackets.back().remoteEndpoint, 0);
+
+  // Flooding Interests and Data go to the whole link
+  interest->setForwardingMode(ForwardingMode::Flooding);
+  interest->setForwarderId(7);
+  face->sendInterest(*interest);
+  face->sendData(*data);
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 4);
+  BOOST_CHECK_EQUAL(transport->sentPackets[2].remoteEndpoint, 0);
+  BOOST_CHECK_EQUAL(transport->sentPackets[3].remoteEndpoint, 0);
+}
+
+BOOST_AUTO_TEST_CASE(Disabled)
+{
+  initialize(GenericLinkService::Options());
+
+  shared_ptr<Data> data = makeData("/A/B");
+  data->setForwarderId(7);
+  Transport::Packet received(lp::Packet(data->wireEncode()).wireEncode());
+  received.remoteEndpoint = 3;
+  transport->receivePacket(std::move(received));
+
+  shared_ptr<Interest> interest = makeInterest("/A/B/C");
+  interest->setForwardingMode(ForwardingMode::Directive);
+  interest->setForwarderId(7);
+  face->sendInterest(*interest);
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 1);
+  BOOST_CHECK_EQUAL(transport->sentPackets.back().remoteEndpoint, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // DmifUnicast
+
 BOOST_AUTO_TEST_SUITE(Malformed) // receive malformed packets
 
 BOOST_AUTO_TEST_CASE(WrongTlvType)
@@ -73,7 +73,7 @@ private:
   }
 
   void
-  doSendData(const Data& data) override
+  doSendData(const Data& data, const DataDelivery& delivery) override
   {
     BOOST_ASSERT(false);
   }
@@ -653,6 +653,48 @@ BOOST_AUTO_TEST_CASE(LossByGreaterAcks) // detect loss by 3x greater Acks, also
   BOOST_CHECK_EQUAL(linkService->getCounters().nDroppedInterests, 0);
 }
 
+BOOST_AUTO_TEST_CASE(LossByGreaterAcksInOnePacket) // all Acks of a packet are processed in one pass
+{
+  linkService->sendLpPackets({makeFrag(1, 50)});
+  linkService->sendLpPackets({makeFrag(2, 50)});
+  linkService->sendLpPackets({makeFrag(3, 50)});
+  linkService->sendLpPackets({makeFrag(4, 50)});
+  linkService->sendLpPackets({makeFrag(5, 50)});
+
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 5);
+  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+
+  lp::Packet ackPkt;
+  ackPkt.add<lp::AckField>(6);
+  ackPkt.add<lp::AckField>(3);
+  ackPkt.add<lp::AckField>(5);
+  ackPkt.add<lp::AckField>(5); // duplicate Ack - ignored
+  ackPkt.add<lp::AckField>(101010); // Unknown TxSequence number - ignored
+  reliability->processIncomingPacket(ackPkt);
+
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(2), 0); // pkt1 old TxSeq
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(3), 0); // pkt2
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(4), 1); // pkt3
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(4).retxCount, 0);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(4).nGreaterSeqAcks, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(5), 0); // pkt4
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(6), 0); // pkt5
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(7), 1); // pkt1 new TxSeq
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(7).retxCount, 1);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(7).nGreaterSeqAcks, 0);
+  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 4);
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 6);
+  lp::Packet sentRetxPkt(transport->sentPackets.back().packet);
+  BOOST_REQUIRE(sentRetxPkt.has<lp::TxSequenceField>());
+  BOOST_CHECK_EQUAL(sentRetxPkt.get<lp::TxSequenceField>(), 7);
+  BOOST_CHECK_EQUAL(getPktNo(sentRetxPkt), 1);
+  BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 3);
+  BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
+  BOOST_CHECK_EQUAL(linkService->getCounters().nRetxExhausted, 0);
+  BOOST_CHECK_EQUAL(linkService->getCounters().nDroppedInterests, 0);
+}
+
 BOOST_AUTO_TEST_CASE(CancelLossNotificationOnAck)
 {
   reliability->onDroppedInterest.connect([] (const Interest&) {
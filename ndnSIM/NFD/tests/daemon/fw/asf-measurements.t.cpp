@@ -83,7 +83,8 @@ BOOST_AUTO_TEST_SUITE(TestFaceInfo)
 
 BOOST_FIXTURE_TEST_CASE(Basic, UnitTestTimeFixture)
 {
-  FaceInfo info;
+  NamespaceInfo ns(make_shared<FaceInfoTable>());
+  FaceInfo info = ns.insert(1);
 
   scheduler::EventId id = scheduler::schedule(time::seconds(1), []{});
   ndn::Name interestName("/ndn/interest");
@@ -119,6 +120,56 @@ BOOST_FIXTURE_TEST_CASE(Basic, UnitTestTimeFixture)
   BOOST_CHECK_EQUAL(info.isTimeoutScheduled(), false);
 }
 
+BOOST_FIXTURE_TEST_CASE(Expiry, UnitTestTimeFixture)
+{
+  auto table = make_shared<FaceInfoTable>();
+  NamespaceInfo ns1(table);
+  fib::Entry fibEntry("/A");
+
+  // created by a timeout: does not expire
+  FaceInfo info2 = ns1.insert(2);
+  BOOST_REQUIRE(info2);
+  BOOST_CHECK(!ns1.getFaceInfo(fibEntry, 3));
+  this->advanceClocks(time::seconds(10));
+
+  // created by forwarding: expires unless extended
+  FaceInfo info1 = ns1.getOrCreateFaceInfo(fibEntry, 1);
+  BOOST_REQUIRE(info1);
+  BOOST_CHECK_EQUAL(info1.getFaceId(), 1);
+  info1.setNSilentTimeouts(3);
+
+  {
+    NamespaceInfo ns2(table);
+    ns2.getOrCreateFaceInfo(fibEntry, 1);
+    ns2.insert(3);
+    BOOST_CHECK_EQUAL(table->size(), 4);
+  }
+  // rows are erased along with their namespace, and the remaining rows are unaffected
+  BOOST_CHECK_EQUAL(table->size(), 2);
+  BOOST_CHECK_EQUAL(ns1.get(1).getNSilentTimeouts(), 3);
+  BOOST_CHECK_EQUAL(ns1.get(2).getFaceId(), 2);
+
+  this->advanceClocks(time::seconds(5), AsfMeasurements::MEASUREMENTS_LIFETIME + time::seconds(5));
+  // expired but not swept yet: lookup misses, and creation starts from fresh measurements
+  BOOST_CHECK_EQUAL(table->size(), 2);
+  BOOST_CHECK(!ns1.get(1));
+  BOOST_CHECK(ns1.get(2));
+  FaceInfo info3 = ns1.getOrCreateFaceInfo(fibEntry, 1);
+  BOOST_CHECK_EQUAL(info3.getNSilentTimeouts(), 0);
+  BOOST_CHECK_EQUAL(table->size(), 2);
+  BOOST_CHECK_EQUAL(table->sweep(time::steady_clock::now()), 0);
+
+  // the periodic sweep erases expired rows only
+  this->advanceClocks(time::seconds(5), AsfMeasurements::MEASUREMENTS_LIFETIME + time::seconds(20));
+  BOOST_CHECK_EQUAL(table->size(), 1);
+  BOOST_CHECK(!ns1.get(1));
+  BOOST_CHECK(ns1.get(2));
+
+  ns1.expireFaceInfo(2);
+  BOOST_CHECK(!ns1.get(2));
+  BOOST_CHECK_EQUAL(table->size(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestFaceInfo
 
 BOOST_AUTO_TEST_SUITE_END() // TestAsfStrategy
@@ -597,6 +597,274 @@ BOOST_AUTO_TEST_CASE(PitLeak) // Bug 3484
   BOOST_CHECK_EQUAL(pit.size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(DmifResolutionReuse)
+{
+  Forwarder forwarder;
+  Fib& fib = forwarder.getFib();
+  fib::Entry* entryA = fib.insert("/A").first;
+  fib.addForwarderId(*entryA, 7);
+
+  auto interest = makeInterest("/A");
+  interest->setForwarderId(7);
+  BOOST_CHECK(interest->getTag<fw::DmifResolutionTag>() == nullptr);
+
+  fw::DmifResolution resolution = forwarder.resolveDmif(*interest);
+  BOOST_CHECK_EQUAL(resolution.fibEntry, entryA);
+  BOOST_CHECK_EQUAL(resolution.mode, static_cast<uint32_t>(ForwardingMode::Directive));
+  BOOST_CHECK_EQUAL(resolution.nextForwarderId, 7);
+
+  auto tag = interest->getTag<fw::DmifResolutionTag>();
+  BOOST_REQUIRE(tag != nullptr);
+
+  // same forwarderId and unchanged FIB: the tag is reused
+  forwarder.resolveDmif(*interest);
+  BOOST_CHECK_EQUAL(interest->getTag<fw::DmifResolutionTag>(), tag);
+
+  // learning another forwarderId invalidates the tag
+  fib.addForwarderId(*entryA, 9);
+  resolution = forwarder.resolveDmif(*interest);
+  BOOST_CHECK_NE(interest->getTag<fw::DmifResolutionTag>(), tag);
+  BOOST_CHECK_EQUAL(resolution.nextForwarderId, 9);
+
+  // forwarderId not learned by the entry is directed to the most recently learned one
+  interest->setForwarderId(3);
+  resolution = forwarder.resolveDmif(*interest);
+  BOOST_CHECK_EQUAL(resolution.fibEntry, entryA);
+  BOOST_CHECK_EQUAL(resolution.mode, static_cast<uint32_t>(ForwardingMode::Directive));
+  BOOST_CHECK_EQUAL(resolution.nextForwarderId, 9);
+
+  // name that has not learned any forwarderId falls back to flooding
+  fib.insert("/B");
+  auto interestB = makeInterest("/B");
+  interestB->setForwarderId(3);
+  resolution = forwarder.resolveDmif(*interestB);
+  BOOST_CHECK(resolution.fibEntry == nullptr);
+  BOOST_CHECK_EQUAL(resolution.mode, static_cast<uint32_t>(ForwardingMode::Flooding));
+  BOOST_CHECK_EQUAL(resolution.nextForwarderId, 3);
+}
+
+BOOST_AUTO_TEST_CASE(DmifResolutionInvalidation)
+{
+  Forwarder forwarder;
+  Fib& fib = forwarder.getFib();
+  auto face1 = make_shared<DummyFace>();
+  forwarder.addFace(face1);
+  fib::Entry* entryA = fib.insert("/A").first;
+  entryA->addNextHop(*face1, 0);
+  fib.addForwarderId(*entryA, 7);
+  fib.addForwarderId(*entryA, 9);
+
+  auto interest = makeInterest("/A");
+  interest->setForwarderId(7);
+  BOOST_CHECK_EQUAL(forwarder.resolveDmif(*interest).fibEntry, entryA);
+
+  // forgetting a forwarderId invalidates the tag
+  uint64_t generation = fib.getDmifGeneration();
+  BOOST_CHECK_EQUAL(fib.removeForwarderId(*entryA, 9), true);
+  BOOST_CHECK_NE(fib.getDmifGeneration(), generation);
+  fw::DmifResolution resolution = forwarder.resolveDmif(*interest);
+  BOOST_CHECK_EQUAL(resolution.fibEntry, entryA);
+  BOOST_CHECK_EQUAL(resolution.nextForwarderId, 7);
+
+  // removing the last nexthop erases the entry, and the tag no longer refers to it
+  generation = fib.getDmifGeneration();
+  fib.removeNextHop(*entryA, *face1);
+  BOOST_REQUIRE(fib.findExactMatch("/A") == nullptr);
+  BOOST_CHECK_NE(fib.getDmifGeneration(), generation);
+  resolution = forwarder.resolveDmif(*interest);
+  BOOST_CHECK(resolution.fibEntry == nullptr);
+  BOOST_CHECK_EQUAL(resolution.mode, static_cast<uint32_t>(ForwardingMode::Flooding));
+
+  // a tag attached by another forwarder is not reused, even if both FIBs had the same history
+  Forwarder nodeA, nodeB;
+  fib::Entry* entryNodeA = nodeA.getFib().insert("/A").first;
+  nodeA.getFib().addForwarderId(*entryNodeA, 7);
+  fib::Entry* entryNodeB = nodeB.getFib().insert("/A").first;
+  nodeB.getFib().addForwarderId(*entryNodeB, 7);
+  BOOST_CHECK_EQUAL(nodeA.resolveDmif(*interest).fibEntry, entryNodeA);
+  BOOST_CHECK_EQUAL(nodeB.resolveDmif(*interest).fibEntry, entryNodeB);
+}
+
+BOOST_AUTO_TEST_CASE(DmifLongestPrefixMatch)
+{
+  Forwarder forwarder;
+  Fib& fib = forwarder.getFib();
+  auto face1 = make_shared<DummyFace>();
+  forwarder.addFace(face1);
+  fib::Entry* entryA = fib.insert("/A").first;
+  entryA->addNextHop(*face1, 0);
+  fib::Entry* entryAB = fib.insert("/A/B").first;
+  entryAB->addNextHop(*face1, 0);
+
+  // Data is learned on the longest matching route, not on an entry of its own name
+  shared_ptr<Data> dataX = makeData("/A/X/1");
+  dataX->setForwarderId(7);
+  forwarder.learnForwarderId(*face1, *dataX);
+  shared_ptr<Data> dataB = makeData("/A/B/1");
+  dataB->setForwarderId(9);
+  forwarder.learnForwarderId(*face1, *dataB);
+  BOOST_CHECK(fib.findExactMatch_dmif("/A", 7) == entryA);
+  BOOST_CHECK(fib.findExactMatch_dmif("/A", 9) == nullptr);
+  BOOST_CHECK(fib.findExactMatch_dmif("/A/B", 9) == entryAB);
+  BOOST_CHECK(fib.findExactMatch("/A/X/1") == nullptr);
+  BOOST_CHECK_EQUAL(fib.size(), 2);
+
+  // an Interest whose forwarderId was not learned under its own name (e.g. from a consumer)
+  // is directed by the longest matching route
+  auto interestX = makeInterest("/A/X/2");
+  fw::DmifResolution resolution = forwarder.resolveDmif(*interestX);
+  BOOST_CHECK_EQUAL(resolution.fibEntry, entryA);
+  BOOST_CHECK_EQUAL(resolution.mode, static_cast<uint32_t>(ForwardingMode::Directive));
+  BOOST_CHECK_EQUAL(resolution.nextForwarderId, 7);
+
+  auto interestB = makeInterest("/A/B/2");
+  resolution = forwarder.resolveDmif(*interestB);
+  BOOST_CHECK_EQUAL(resolution.fibEntry, entryAB);
+  BOOST_CHECK_EQUAL(resolution.nextForwarderId, 9);
+
+  // a longer route that has learned nothing is not skipped in favor of a shorter one
+  fib::Entry* entryAC = fib.insert("/A/C").first;
+  entryAC->addNextHop(*face1, 0);
+  auto interestC = makeInterest("/A/C/1");
+  interestC->setForwarderId(7);
+  resolution = forwarder.resolveDmif(*interestC);
+  BOOST_CHECK(resolution.fibEntry == nullptr);
+  BOOST_CHECK_EQUAL(resolution.mode, static_cast<uint32_t>(ForwardingMode::Flooding));
+  BOOST_CHECK_EQUAL(resolution.nextForwarderId, 7);
+
+  // without a matching route, Data is not learned and Interests are flooded
+  shared_ptr<Data> dataZ = makeData("/Z/1");
+  dataZ->setForwarderId(11);
+  uint64_t generation = fib.getDmifGeneration();
+  forwarder.learnForwarderId(*face1, *dataZ);
+  BOOST_CHECK_EQUAL(fib.getDmifGeneration(), generation);
+  BOOST_CHECK_EQUAL(fib.size(), 3);
+  resolution = forwarder.resolveDmif(*makeInterest("/Z/2"));
+  BOOST_CHECK(resolution.fibEntry == nullptr);
+  BOOST_CHECK_EQUAL(resolution.mode, static_cast<uint32_t>(ForwardingMode::Flooding));
+}
+
+BOOST_AUTO_TEST_CASE(DmifLearnFromData)
+{
+  Forwarder forwarder;
+
+  auto face1 = make_shared<DummyFace>();
+  auto face2 = make_shared<DummyFace>();
+  auto appFace = make_shared<DummyFace>("dummy://", "dummy://", ndn::nfd::FACE_SCOPE_LOCAL);
+  forwarder.addFace(face1);
+  forwarder.addFace(face2);
+  forwarder.addFace(appFace);
+  forwarder.getFib().insert("/A").first->addNextHop(*face2, 0);
+  forwarder.getFib().insert("/L").first->addNextHop(*appFace, 0);
+
+  // first Interest is flooded, and the Data answering it carries the forwarderId of its sender
+  shared_ptr<Interest> interest1 = makeInterest("/A/B", 1);
+  face1->receiveInterest(*interest1);
+  this->advanceClocks(time::milliseconds(100), time::seconds(1));
+  BOOST_REQUIRE_EQUAL(face2->sentInterests.size(), 1);
+  BOOST_CHECK_EQUAL(face2->sentInterests[0].getForwardingMode(),
+                    static_cast<uint32_t>(ForwardingMode::Flooding));
+
+  shared_ptr<Data> data = makeData("/A/B");
+  data->setForwarderId(5);
+  face2->receiveData(*data);
+  this->advanceClocks(time::milliseconds(100), time::seconds(1));
+  BOOST_REQUIRE_EQUAL(face1->sentData.size(), 1);
+
+  // the route learns the forwarderId; Data does not add FIB entries or nexthops
+  const fib::Entry* learned = forwarder.getFib().findExactMatch_dmif("/A", 5);
+  BOOST_REQUIRE(learned != nullptr);
+  BOOST_CHECK_EQUAL(learned->getNextHops().size(), 1);
+  BOOST_CHECK(learned->hasNextHop(*face2));
+  BOOST_CHECK(forwarder.getFib().findExactMatch("/A/B") == nullptr);
+  BOOST_CHECK_EQUAL(forwarder.getFib().size(), 2);
+
+  // a later Interest under the route is directed to the forwarder that supplied the Data
+  shared_ptr<Interest> interest2 = makeInterest("/A/C", 2);
+  interest2->setMustBeFresh(true);
+  face1->receiveInterest(*interest2);
+  this->advanceClocks(time::milliseconds(100), time::seconds(1));
+  BOOST_REQUIRE_EQUAL(face2->sentInterests.size(), 2);
+  BOOST_CHECK_EQUAL(face2->sentInterests[1].getForwardingMode(),
+                    static_cast<uint32_t>(ForwardingMode::Directive));
+  BOOST_CHECK_EQUAL(face2->sentInterests[1].getForwarderId(), 5);
+
+  // Data from a local application is not learned
+  shared_ptr<Interest> interestL = makeInterest("/L/M", 3);
+  face1->receiveInterest(*interestL);
+  this->advanceClocks(time::milliseconds(100), time::seconds(1));
+  BOOST_REQUIRE_EQUAL(appFace->sentInterests.size(), 1);
+  appFace->receiveData(*makeData("/L/M"));
+  this->advanceClocks(time::milliseconds(100), time::seconds(1));
+  BOOST_CHECK(forwarder.getFib().findExactMatch("/L")->getNameTreeEntry()->getForwarderIds().empty());
+  BOOST_CHECK_EQUAL(forwarder.getFib().size(), 2);
+
+  // learning a known forwarderId again leaves cached resolutions valid
+  uint64_t generation = forwarder.getFib().getDmifGeneration();
+  shared_ptr<Interest> interest4 = makeInterest("/A/D", 4);
+  face1->receiveInterest(*interest4);
+  this->advanceClocks(time::milliseconds(100), time::seconds(1));
+  shared_ptr<Data> data4 = makeData("/A/D");
+  data4->setForwarderId(5);
+  face2->receiveData(*data4);
+  this->advanceClocks(time::milliseconds(100), time::seconds(1));
+  BOOST_CHECK_EQUAL(forwarder.getFib().getDmifGeneration(), generation);
+  BOOST_CHECK_EQUAL(forwarder.getFib().size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(CsSharesIncomingData)
+{
+  Forwarder forwarder;
+
+  auto face1 = make_shared<DummyFace>();
+  auto face2 = make_shared<DummyFace>();
+  auto face3 = make_shared<DummyFace>();
+  forwarder.addFace(face1);
+  forwarder.addFace(face2);
+  forwarder.addFace(face3);
+  forwarder.getFib().insert("/A").first->addNextHop(*face2, 0);
+
+  shared_ptr<Interest> interest1 = makeInterest("/A/B", 1);
+  face1->receiveInterest(*interest1);
+  this->advanceClocks(time::milliseconds(100), time::seconds(1));
+
+  shared_ptr<Data> dataABC = makeData("/A/B/C");
+  dataABC->setTag(make_shared<lp::HopCountTag>(5));
+  face2->receiveData(*dataABC);
+  this->advanceClocks(time::milliseconds(100), time::seconds(1));
+
+  // the CS holds the received instance, not a copy
+  const Cs& cs = forwarder.getCs();
+  BOOST_REQUIRE_EQUAL(cs.size(), 1);
+  BOOST_CHECK_EQUAL(&cs.begin()->getData(), dataABC.get());
+
+  // the downstream still gets the hop count and incoming face of this delivery
+  BOOST_REQUIRE_EQUAL(face1->sentData.size(), 1);
+  BOOST_REQUIRE(face1->sentData[0].getTag<lp::HopCountTag>() != nullptr);
+  BOOST_CHECK_EQUAL(*face1->sentData[0].getTag<lp::HopCountTag>(), 5);
+  BOOST_REQUIRE(face1->sentData[0].getTag<lp::IncomingFaceIdTag>() != nullptr);
+  BOOST_CHECK_EQUAL(*face1->sentData[0].getTag<lp::IncomingFaceIdTag>(), face2->getId());
+
+  // a CS hit does not, and sends the cached instance itself
+  std::vector<const Data*> hitData;
+  face3->getLinkService()->afterSendData.connect([&] (const Data& data) { hitData.push_back(&data); });
+  shared_ptr<Interest> interest3 = makeInterest("/A/B", 3);
+  face3->receiveInterest(*interest3);
+  this->advanceClocks(time::milliseconds(100), time::seconds(1));
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nCsHits, 1);
+  BOOST_REQUIRE_EQUAL(hitData.size(), 1);
+  BOOST_CHECK_EQUAL(hitData[0], dataABC.get());
+  BOOST_REQUIRE_EQUAL(face3->sentData.size(), 1);
+  BOOST_CHECK(face3->sentData[0].getTag<lp::HopCountTag>() == nullptr);
+  BOOST_REQUIRE(face3->sentData[0].getTag<lp::IncomingFaceIdTag>() != nullptr);
+  BOOST_CHECK_EQUAL(*face3->sentData[0].getTag<lp::IncomingFaceIdTag>(), face::FACEID_CONTENT_STORE);
+  BOOST_CHECK_EQUAL(face3->sentData[0].getForwarderId(), face1->sentData[0].getForwarderId());
+
+  // the tags of a reception never reach the cached instance
+  BOOST_CHECK(dataABC->getTag<lp::HopCountTag>() == nullptr);
+  BOOST_CHECK(dataABC->getTag<lp::IncomingFaceIdTag>() == nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -138,11 +138,11 @@ private:
   }
 
   void
-  doSendData(const Data& data) override
+  doSendData(const Data& data, const DataDelivery& delivery) override
   {
     this->sentData.push_back(data);
     this->sentData.back().setTag(std::make_shared<TopologyPcapTimestamp>(time::steady_clock::now()));
-    this->GenericLinkService::doSendData(data);
+    this->GenericLinkService::doSendData(data, delivery);
   }
 
   void
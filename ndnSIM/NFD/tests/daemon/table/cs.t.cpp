@@ -362,6 +362,27 @@ BOOST_AUTO_TEST_CASE(DigestExclude)
   CHECK_CS_FIND(1);
 }
 
+BOOST_AUTO_TEST_CASE(ExactIndexEviction)
+{
+  m_cs.setLimit(2);
+  Name n1 = insert(1, "/A");
+  Name n2 = insert(2, "/A");
+
+  // an Interest without selectors is answered through the exact-name index
+  startInterest("/A");
+  CHECK_CS_FIND(n1 < n2 ? 1 : 2);
+
+  insert(3, "/B"); // evicts Data 1
+  startInterest("/A");
+  CHECK_CS_FIND(2);
+
+  insert(4, "/A/C"); // evicts Data 2
+  startInterest("/A");
+  CHECK_CS_FIND(4);
+  startInterest("/B");
+  CHECK_CS_FIND(3);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Find
 
 // When the capacity limit is set to zero, Data cannot be inserted;
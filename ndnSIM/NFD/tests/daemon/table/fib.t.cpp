@@ -120,6 +120,43 @@ BOOST_AUTO_TEST_CASE(FibEntry)
   BOOST_CHECK_EQUAL(entry.getNextHops().size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(FibEntryAddNextHops)
+{
+  shared_ptr<Face> face1 = make_shared<DummyFace>();
+  shared_ptr<Face> face2 = make_shared<DummyFace>();
+  shared_ptr<Face> face3 = make_shared<DummyFace>();
+
+  Entry entry("ndn:/Bnm3qcJf");
+  entry.addNextHop(*face1, 20);
+  // [(face1,20)]
+
+  NextHopList nextHops;
+  nextHops.emplace_back(*face2);
+  nextHops.back().setCost(30);
+  nextHops.emplace_back(*face1);
+  nextHops.back().setCost(40);
+  nextHops.emplace_back(*face3);
+  nextHops.back().setCost(10);
+  nextHops.emplace_back(*face2);
+  nextHops.back().setCost(5);
+  entry.addNextHops(nextHops);
+  // [(face2,5), (face3,10), (face1,40)]
+
+  BOOST_REQUIRE_EQUAL(entry.getNextHops().size(), 3);
+  NextHopList::const_iterator it = entry.getNextHops().begin();
+  BOOST_CHECK_EQUAL(&it->getFace(), face2.get());
+  BOOST_CHECK_EQUAL(it->getCost(), 5);
+  ++it;
+  BOOST_CHECK_EQUAL(&it->getFace(), face3.get());
+  BOOST_CHECK_EQUAL(it->getCost(), 10);
+  ++it;
+  BOOST_CHECK_EQUAL(&it->getFace(), face1.get());
+  BOOST_CHECK_EQUAL(it->getCost(), 40);
+
+  entry.addNextHops(NextHopList());
+  BOOST_CHECK_EQUAL(entry.getNextHops().size(), 3);
+}
+
 BOOST_AUTO_TEST_CASE(Insert_LongestPrefixMatch)
 {
   NameTree nameTree;
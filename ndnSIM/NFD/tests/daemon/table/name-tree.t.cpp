@@ -182,6 +182,93 @@ BOOST_AUTO_TEST_CASE(Resize)
   BOOST_CHECK_EQUAL(ht.getNBuckets(), 6);
 }
 
+BOOST_AUTO_TEST_CASE(OpenAddressing)
+{
+  HashtableOptions options(16);
+  options.layout = HashtableLayout::OPEN_ADDRESSING;
+  options.migrationStep = 2;
+  Hashtable ht(options);
+
+  std::vector<Name> names;
+  for (int i = 0; i < 1000; ++i) {
+    Name name("/A");
+    name.appendNumber(i % 7).appendNumber(i);
+    names.push_back(name);
+  }
+
+  // lookups must see nodes in both slot arrays while a resize is being migrated
+  std::set<const Node*> nodes;
+  for (size_t i = 0; i < names.size(); ++i) {
+    const Node* node = nullptr;
+    bool isNew = false;
+    std::tie(node, isNew) = ht.insert(names[i], 3, computeHashes(names[i]));
+    BOOST_CHECK_EQUAL(isNew, true);
+    nodes.insert(node);
+    BOOST_CHECK_EQUAL(ht.find(names[i / 2], 3), ht.find(names[i / 2], 3, computeHashes(names[i / 2])));
+    BOOST_CHECK(ht.find(names[i / 2], 3) != nullptr);
+  }
+  BOOST_CHECK_EQUAL(ht.size(), 1000);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 2048);
+  BOOST_CHECK(ht.find(names[0], 2) == nullptr);
+  BOOST_CHECK_EQUAL(ht.insert(names[0], 3, computeHashes(names[0])).second, false);
+
+  size_t nEnumerated = 0;
+  for (const Node* node = ht.getFirstNode(); node != nullptr; node = ht.getNextNode(node)) {
+    BOOST_CHECK_EQUAL(nodes.count(node), 1);
+    ++nEnumerated;
+  }
+  BOOST_CHECK_EQUAL(nEnumerated, 1000);
+
+  for (size_t i = 0; i < names.size(); ++i) {
+    const Node* node = ht.find(names[i], 3);
+    BOOST_REQUIRE(node != nullptr);
+    ht.erase(const_cast<Node*>(node));
+    BOOST_CHECK(ht.find(names[i], 3) == nullptr);
+    if (i + 1 < names.size()) {
+      BOOST_CHECK(ht.find(names.back(), 3) != nullptr);
+    }
+  }
+  BOOST_CHECK_EQUAL(ht.size(), 0);
+  BOOST_CHECK(ht.getFirstNode() == nullptr);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 16);
+}
+
+BOOST_AUTO_TEST_CASE(DmifIndex)
+{
+  Hashtable ht(HashtableOptions(16));
+
+  Name name("/A/B/C");
+  HashSequence hashes = computeHashes(name);
+  Node* node = const_cast<Node*>(ht.insert(name, 2, hashes).first);
+  Node* node2 = const_cast<Node*>(ht.insert(name, 3, hashes).first);
+
+  BOOST_CHECK(ht.find_dmif(name, 2, 7) == nullptr);
+
+  BOOST_CHECK_EQUAL(ht.addForwarderId(node, 7), true);
+  BOOST_CHECK_EQUAL(ht.addForwarderId(node, 7), false);
+  BOOST_CHECK_EQUAL(ht.addForwarderId(node, 9), true);
+  BOOST_CHECK_EQUAL(ht.addForwarderId(node2, 7), true);
+
+  BOOST_CHECK_EQUAL(ht.find_dmif(name, 2, 7), node);
+  BOOST_CHECK_EQUAL(ht.find_dmif(name, 2, 9, hashes), node);
+  BOOST_CHECK_EQUAL(ht.find_dmif(name, 3, 7), node2);
+  BOOST_CHECK(ht.find_dmif(name, 3, 9) == nullptr);
+  BOOST_CHECK(ht.find_dmif(name, 1, 7) == nullptr);
+
+  BOOST_CHECK_EQUAL(node->entry.getForwarderIds().size(), 2);
+  BOOST_CHECK_EQUAL(node->entry.getForwarderId(), 9);
+  BOOST_CHECK_EQUAL(node->entry.hasForwarderId(7), true);
+
+  BOOST_CHECK_EQUAL(ht.removeForwarderId(node, 7), true);
+  BOOST_CHECK_EQUAL(ht.removeForwarderId(node, 7), false);
+  BOOST_CHECK(ht.find_dmif(name, 2, 7) == nullptr);
+  BOOST_CHECK_EQUAL(ht.find_dmif(name, 2, 9), node);
+
+  ht.erase(node);
+  BOOST_CHECK(ht.find_dmif(name, 2, 9) == nullptr);
+  BOOST_CHECK_EQUAL(ht.find_dmif(name, 3, 7), node2);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Hashtable
 
 BOOST_AUTO_TEST_SUITE(TestEntry)
@@ -0,0 +1,147 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2018,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark-helpers.hpp"
+#include "face/null-face.hpp"
+#include "fw/asf-measurements.hpp"
+
+#include <iostream>
+
+#ifdef HAVE_VALGRIND
+#include <valgrind/callgrind.h>
+#endif
+
+namespace nfd {
+namespace fw {
+namespace asf {
+namespace tests {
+
+class AsfMeasurementsBenchmarkFixture
+{
+protected:
+  AsfMeasurementsBenchmarkFixture()
+    : m_table(make_shared<FaceInfoTable>())
+    , m_fibEntry("/bench")
+  {
+#ifdef _DEBUG
+    std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+
+    Interest interest("/bench");
+    m_pitEntry = make_shared<pit::Entry>(interest);
+    for (size_t i = 0; i < N_FACES; ++i) {
+      m_faces.push_back(face::makeNullFace());
+      m_pitEntry->insertOrUpdateOutRecord(*m_faces.back(), interest);
+    }
+  }
+
+  template<typename F>
+  static time::microseconds
+  timed(const F& f)
+  {
+    auto t1 = time::steady_clock::now();
+    f();
+    return time::duration_cast<time::microseconds>(time::steady_clock::now() - t1);
+  }
+
+protected:
+  static constexpr size_t N_NAMESPACES = 100000;
+  static constexpr size_t N_FACES = 8;
+
+  shared_ptr<FaceInfoTable> m_table;
+  fib::Entry m_fibEntry;
+  shared_ptr<pit::Entry> m_pitEntry;
+  std::vector<shared_ptr<Face>> m_faces;
+};
+
+// Models the measurements kept by AsfStrategy for many prefixes reached through the same faces:
+// every prefix has a FaceInfo for every face, which is created when an Interest is forwarded,
+// updated by an RTT sample when Data returns, and looked up when ranking the faces.
+// Finally all measurements expire, and are erased by a single sweep.
+BOOST_FIXTURE_TEST_CASE(ManyPrefixes, AsfMeasurementsBenchmarkFixture)
+{
+  std::vector<unique_ptr<NamespaceInfo>> namespaces;
+  namespaces.reserve(N_NAMESPACES);
+  for (size_t i = 0; i < N_NAMESPACES; ++i) {
+    namespaces.push_back(make_unique<NamespaceInfo>(m_table));
+  }
+
+#ifdef HAVE_VALGRIND
+  CALLGRIND_START_INSTRUMENTATION;
+#endif
+
+  auto createTime = timed([&] {
+    for (const auto& ns : namespaces) {
+      for (size_t face = 0; face < N_FACES; ++face) {
+        ns->getOrCreateFaceInfo(m_fibEntry, face + 1);
+      }
+    }
+  });
+  BOOST_REQUIRE_EQUAL(m_table->size(), N_NAMESPACES * N_FACES);
+
+  auto updateTime = timed([&] {
+    for (const auto& ns : namespaces) {
+      for (size_t face = 0; face < N_FACES; ++face) {
+        FaceInfo info = ns->get(face + 1);
+        info.recordRtt(m_pitEntry, *m_faces[face]);
+        ns->extendFaceInfoLifetime(info, face + 1);
+      }
+    }
+  });
+
+  size_t nMeasured = 0;
+  auto lookupTime = timed([&] {
+    for (const auto& ns : namespaces) {
+      for (size_t face = 0; face < N_FACES; ++face) {
+        FaceInfo info = ns->getFaceInfo(m_fibEntry, face + 1);
+        nMeasured += info && info.hasSrttMeasurement();
+      }
+    }
+  });
+  BOOST_CHECK_EQUAL(nMeasured, N_NAMESPACES * N_FACES);
+
+  size_t nErased = 0;
+  auto sweepTime = timed([&] {
+    nErased = m_table->sweep(time::steady_clock::now() + AsfMeasurements::MEASUREMENTS_LIFETIME);
+  });
+  BOOST_CHECK_EQUAL(nErased, N_NAMESPACES * N_FACES);
+  BOOST_CHECK_EQUAL(m_table->size(), 0);
+
+#ifdef HAVE_VALGRIND
+  CALLGRIND_STOP_INSTRUMENTATION;
+#endif
+
+  std::cout << N_NAMESPACES << " namespaces x " << N_FACES << " faces:"
+            << " create " << createTime
+            << ", RTT update " << updateTime
+            << ", lookup " << lookupTime
+            << ", sweep " << sweepTime
+            << std::endl;
+}
+
+} // namespace tests
+} // namespace asf
+} // namespace fw
+} // namespace nfd
@@ -244,5 +244,44 @@ BOOST_FIXTURE_TEST_CASE(Rightmost, CsBenchmarkFixture)
   std::cout << "find(rightmost) " << (N_INTERESTS * N_CHILDREN * REPEAT) << ": " << d << std::endl;
 }
 
+// find hit of Interests that name a stored Data exactly, with and without selectors
+BOOST_FIXTURE_TEST_CASE(ExactName, CsBenchmarkFixture)
+{
+  constexpr size_t REPEAT = 4;
+
+  for (size_t nEntries : {size_t(100000), size_t(1000000)}) {
+    Cs largeCs(nEntries);
+    std::vector<shared_ptr<Interest>> interestWorkload = makeInterestWorkload(nEntries);
+    for (const auto& data : makeDataWorkload(nEntries)) {
+      largeCs.insert(*data, false);
+    }
+    BOOST_REQUIRE(largeCs.size() == nEntries);
+
+    size_t nHits = 0;
+    auto findAll = [&] {
+      for (size_t j = 0; j < REPEAT; ++j) {
+        for (const auto& interest : interestWorkload) {
+          largeCs.find(*interest, bind([&] { ++nHits; }), bind([]{}));
+        }
+      }
+    };
+
+    // no selectors: exact-name index
+    time::microseconds d1 = timedRun(findAll);
+    BOOST_CHECK_EQUAL(nHits, nEntries * REPEAT);
+
+    // ChildSelector=leftmost finds the same Data through the ordered Table
+    for (auto&& interest : interestWorkload) {
+      interest->setChildSelector(0);
+    }
+    nHits = 0;
+    time::microseconds d2 = timedRun(findAll);
+    BOOST_CHECK_EQUAL(nHits, nEntries * REPEAT);
+
+    std::cout << "find(exact) " << (nEntries * REPEAT) << " in " << nEntries << " entries: "
+              << "hash index " << d1 << ", ordered table " << d2 << std::endl;
+  }
+}
+
 } // namespace tests
 } // namespace nfd
@@ -0,0 +1,237 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2017,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark-helpers.hpp"
+#include "face/face.hpp"
+#include "face/generic-link-service.hpp"
+
+#include <ndn-cxx/security/signature-sha256-with-rsa.hpp>
+
+#include <iostream>
+
+#ifdef HAVE_VALGRIND
+#include <valgrind/callgrind.h>
+#endif
+
+namespace nfd {
+namespace face {
+namespace tests {
+
+/** \brief Transport that hands sent packets to a peer Transport, optionally dropping some
+ */
+class LoopbackTransport : public Transport
+{
+public:
+  explicit
+  LoopbackTransport(ssize_t mtu)
+  {
+    this->setLocalUri(FaceUri("dummy://"));
+    this->setRemoteUri(FaceUri("dummy://"));
+    this->setScope(ndn::nfd::FACE_SCOPE_NON_LOCAL);
+    this->setPersistency(ndn::nfd::FACE_PERSISTENCY_PERSISTENT);
+    this->setLinkType(ndn::nfd::LINK_TYPE_POINT_TO_POINT);
+    this->setMtu(mtu);
+  }
+
+  void
+  connect(LoopbackTransport& peer)
+  {
+    m_peer = &peer;
+  }
+
+  /** \brief drop one of every \p lossInterval sent packets; 0 disables loss
+   */
+  void
+  setLossInterval(size_t lossInterval)
+  {
+    m_lossInterval = lossInterval;
+  }
+
+  size_t
+  getNDropped() const
+  {
+    return m_nDropped;
+  }
+
+private:
+  void
+  doClose() override
+  {
+    this->setState(TransportState::CLOSED);
+  }
+
+  void
+  doSend(Packet&& packet) override
+  {
+    if (m_lossInterval > 0 && ++m_nSent % m_lossInterval == 0) {
+      ++m_nDropped;
+      return;
+    }
+    m_peer->receive(std::move(packet));
+  }
+
+private:
+  LoopbackTransport* m_peer = nullptr;
+  size_t m_lossInterval = 0;
+  size_t m_nSent = 0;
+  size_t m_nDropped = 0;
+};
+
+class GenericLinkServiceBenchmarkFixture
+{
+protected:
+  GenericLinkServiceBenchmarkFixture()
+  {
+#ifdef _DEBUG
+    std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+  }
+
+  /** \brief connect a producer face and a consumer face, with fragmentation and reliability
+   */
+  void
+  initialize(ssize_t mtu, size_t lossInterval)
+  {
+    GenericLinkService::Options options;
+    options.allowFragmentation = true;
+    options.allowReassembly = true;
+    options.reliabilityOptions.isEnabled = true;
+
+    auto producerTransport = make_unique<LoopbackTransport>(mtu);
+    auto consumerTransport = make_unique<LoopbackTransport>(mtu);
+    producerTransport->connect(*consumerTransport);
+    consumerTransport->connect(*producerTransport);
+    // only the Data direction is lossy, so that Acks keep flowing back to the producer
+    producerTransport->setLossInterval(lossInterval);
+    m_producerTransport = producerTransport.get();
+
+    producer = make_unique<Face>(make_unique<GenericLinkService>(options), std::move(producerTransport));
+    consumer = make_unique<Face>(make_unique<GenericLinkService>(options), std::move(consumerTransport));
+
+    producer->afterReceiveInterest.connect([this] (const Interest&) { ++nReceivedInterests; });
+    consumer->afterReceiveData.connect([this] (const Data&) { ++nReceivedData; });
+  }
+
+  static shared_ptr<Data>
+  makeData(const Name& name, size_t payloadSize)
+  {
+    auto data = make_shared<Data>(name);
+    std::vector<uint8_t> payload(payloadSize, 0xBB);
+    data->setContent(payload.data(), payload.size());
+    ndn::SignatureSha256WithRsa fakeSignature;
+    fakeSignature.setValue(ndn::encoding::makeEmptyBlock(tlv::SignatureValue));
+    data->setSignature(fakeSignature);
+    data->wireEncode();
+    return data;
+  }
+
+  /** \brief exchange \p nRounds Interest-Data pairs; each Interest also carries Acks
+   *         for the fragments of earlier Data
+   */
+  time::nanoseconds
+  timedExchange(size_t nRounds, size_t payloadSize)
+  {
+    std::vector<shared_ptr<Interest>> interests;
+    std::vector<shared_ptr<Data>> data;
+    for (size_t i = 0; i < nRounds; ++i) {
+      Name name("/benchmark/lp");
+      name.appendNumber(i);
+      interests.push_back(make_shared<Interest>(name));
+      interests.back()->wireEncode();
+      data.push_back(makeData(name, payloadSize));
+    }
+
+#ifdef HAVE_VALGRIND
+    CALLGRIND_START_INSTRUMENTATION;
+#endif
+
+    auto t1 = time::steady_clock::now();
+    for (size_t i = 0; i < nRounds; ++i) {
+      consumer->sendInterest(*interests[i]);
+      producer->sendData(*data[i]);
+    }
+    auto t2 = time::steady_clock::now();
+
+#ifdef HAVE_VALGRIND
+    CALLGRIND_STOP_INSTRUMENTATION;
+#endif
+
+    return time::duration_cast<time::nanoseconds>(t2 - t1);
+  }
+
+  void
+  printResult(const std::string& title, size_t nRounds, time::nanoseconds d) const
+  {
+    const auto& counters = static_cast<const GenericLinkService*>(producer->getLinkService())->getCounters();
+    std::cout << title << ": " << nRounds << " exchanges, "
+              << producer->getCounters().nOutPackets << " LpPackets sent, "
+              << m_producerTransport->getNDropped() << " dropped, "
+              << nReceivedData << " Data reassembled, "
+              << counters.nRetransmitted << " retransmitted, "
+              << counters.nRetxExhausted << " given up, "
+              << d << " (" << d.count() / nRounds << " ns per exchange)" << std::endl;
+  }
+
+protected:
+  unique_ptr<Face> producer;
+  unique_ptr<Face> consumer;
+  size_t nReceivedInterests = 0;
+  size_t nReceivedData = 0;
+
+private:
+  LoopbackTransport* m_producerTransport = nullptr;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestGenericLinkServiceBenchmark, GenericLinkServiceBenchmarkFixture)
+
+// Data of 8000 octets over a 1500-octet MTU, fragmented into 6 LpPackets, on a lossless link.
+BOOST_AUTO_TEST_CASE(Fragmented)
+{
+  const size_t nRounds = 100000;
+  initialize(1500, 0);
+
+  time::nanoseconds d = timedExchange(nRounds, 8000);
+  printResult("fragmented", nRounds, d);
+  BOOST_CHECK_EQUAL(nReceivedInterests, nRounds);
+  BOOST_CHECK_EQUAL(nReceivedData, nRounds);
+}
+
+// Same exchanges on a link that drops one of every 50 LpPackets from the producer,
+// so that fragments are retransmitted after being reported lost by greater Acks.
+BOOST_AUTO_TEST_CASE(FragmentedLossy)
+{
+  const size_t nRounds = 100000;
+  initialize(1500, 50);
+
+  time::nanoseconds d = timedExchange(nRounds, 8000);
+  printResult("fragmented-lossy", nRounds, d);
+  BOOST_CHECK_EQUAL(nReceivedData, nRounds);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestGenericLinkServiceBenchmark
+
+} // namespace tests
+} // namespace face
+} // namespace nfd
@@ -0,0 +1,142 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2017,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark-helpers.hpp"
+#include "table/name-tree-hashtable.hpp"
+
+#include <iostream>
+
+#ifdef HAVE_VALGRIND
+#include <valgrind/callgrind.h>
+#endif
+
+namespace nfd {
+namespace name_tree {
+namespace tests {
+
+class NameTreeBenchmarkFixture
+{
+protected:
+  NameTreeBenchmarkFixture()
+  {
+#ifdef _DEBUG
+    std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+  }
+
+  /** \brief total and worst-case duration of a kind of operation
+   */
+  struct OpStats
+  {
+    time::nanoseconds total = time::nanoseconds::zero();
+    time::nanoseconds max = time::nanoseconds::zero();
+  };
+
+  template<typename F>
+  static void
+  timedOp(OpStats& stats, const F& f)
+  {
+    auto t1 = time::steady_clock::now();
+    f();
+    auto d = time::steady_clock::now() - t1;
+    stats.total += d;
+    stats.max = std::max(stats.max, time::duration_cast<time::nanoseconds>(d));
+  }
+
+  /** \brief makes the i-th name of the workload
+   *
+   *  Nodes are inserted for the first three components, so that looking up the whole name
+   *  is a miss that probes the same table.
+   */
+  static Name
+  makeName(size_t i)
+  {
+    Name name("/bench");
+    name.appendNumber(i % 16).appendNumber(i).append("miss");
+    name.getPrefixHashes();
+    return name;
+  }
+
+  static constexpr size_t PREFIX_LEN = 3;
+};
+
+// Names are generated outside of the timed operations, so the table is the only large allocation.
+// Each operation is timed individually, in order to show the latency spike of a resize:
+// the chained layout rehashes all nodes at once, while the open addressing layout migrates
+// a few slots on each insert or erase. The 10^7 entries round needs several GB of memory.
+BOOST_FIXTURE_TEST_CASE(Layouts, NameTreeBenchmarkFixture)
+{
+  for (size_t nEntries : {size_t(10000), size_t(100000), size_t(1000000), size_t(10000000)}) {
+    for (HashtableLayout layout : {HashtableLayout::CHAINED, HashtableLayout::OPEN_ADDRESSING}) {
+      HashtableOptions options(1024);
+      options.layout = layout;
+      Hashtable ht(options);
+      OpStats insertStats, findHitStats, findMissStats, eraseStats;
+
+#ifdef HAVE_VALGRIND
+      CALLGRIND_START_INSTRUMENTATION;
+#endif
+
+      for (size_t i = 0; i < nEntries; ++i) {
+        Name name = makeName(i);
+        timedOp(insertStats, [&] { ht.insert(name, PREFIX_LEN, name.getPrefixHashes()); });
+      }
+      BOOST_REQUIRE_EQUAL(ht.size(), nEntries);
+
+      size_t nHits = 0;
+      for (size_t i = 0; i < nEntries; ++i) {
+        Name name = makeName(i);
+        const HashSequence& hashes = name.getPrefixHashes();
+        timedOp(findHitStats, [&] { nHits += ht.find(name, PREFIX_LEN, hashes) != nullptr; });
+        timedOp(findMissStats, [&] { nHits += ht.find(name, name.size(), hashes) != nullptr; });
+      }
+      BOOST_CHECK_EQUAL(nHits, nEntries);
+
+      for (size_t i = 0; i < nEntries; ++i) {
+        Name name = makeName(i);
+        Node* node = const_cast<Node*>(ht.find(name, PREFIX_LEN, name.getPrefixHashes()));
+        BOOST_REQUIRE(node != nullptr);
+        timedOp(eraseStats, [&] { ht.erase(node); });
+      }
+      BOOST_REQUIRE_EQUAL(ht.size(), 0);
+
+#ifdef HAVE_VALGRIND
+      CALLGRIND_STOP_INSTRUMENTATION;
+#endif
+
+      auto us = [] (time::nanoseconds d) { return time::duration_cast<time::microseconds>(d); };
+      std::cout << layout << " " << nEntries << " entries:"
+                << " insert " << us(insertStats.total) << " (max " << insertStats.max << ")"
+                << ", find(hit) " << us(findHitStats.total)
+                << ", find(miss) " << us(findMissStats.total)
+                << ", erase " << us(eraseStats.total) << " (max " << eraseStats.max << ")"
+                << std::endl;
+    }
+  }
+}
+
+} // namespace tests
+} // namespace name_tree
+} // namespace nfd
@@ -24,15 +24,37 @@
  */
 
 #include "benchmark-helpers.hpp"
+#include "face/null-face.hpp"
 #include "table/fib.hpp"
 #include "table/pit.hpp"
 
+#include <cstdlib>
 #include <iostream>
 
 #ifdef HAVE_VALGRIND
 #include <valgrind/callgrind.h>
 #endif
 
+// number of heap allocations made by this program
+static size_t g_nAllocations = 0;
+
+void*
+operator new(size_t size)
+{
+  ++g_nAllocations;
+  void* p = std::malloc(size > 0 ? size : 1);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void
+operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
 namespace nfd {
 namespace tests {
 
@@ -42,6 +64,8 @@ protected:
   PitFibBenchmarkFixture()
     : m_fib(m_nameTree)
     , m_pit(m_nameTree)
+    , m_inFace(face::makeNullFace())
+    , m_outFace(face::makeNullFace())
   {
 #ifdef _DEBUG
     std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
@@ -96,6 +120,8 @@ protected:
   NameTree m_nameTree;
   Fib m_fib;
   Pit m_pit;
+  shared_ptr<Face> m_inFace;
+  shared_ptr<Face> m_outFace;
 };
 
 // This test case models PIT and FIB operations with simple Interest-Data exchanges.
@@ -120,11 +146,13 @@ BOOST_FIXTURE_TEST_CASE(SimpleExchanges, PitFibBenchmarkFixture)
 
   generatePacketsAndPopulateFib(nRoundTrip, nFibEntries, fibPrefixLength,
                                 interestNameLength, dataNameLength);
+  pitEntries.reserve(nRoundTrip);
 
 #ifdef HAVE_VALGRIND
   CALLGRIND_START_INSTRUMENTATION;
 #endif
 
+  size_t nAllocations = g_nAllocations;
   auto t1 = time::steady_clock::now();
 
   for (size_t i = 0; i < nRoundTrip + gap3 + gap4; ++i) {
@@ -132,7 +160,9 @@ BOOST_FIXTURE_TEST_CASE(SimpleExchanges, PitFibBenchmarkFixture)
       // process incoming Interest
       shared_ptr<pit::Entry> pitEntry = m_pit.insert(*interests[i]).first;
       pitEntries.push_back(pitEntry);
+      pitEntry->insertOrUpdateInRecord(*m_inFace, *interests[i]);
       m_fib.findLongestPrefixMatch(*pitEntry);
+      pitEntry->insertOrUpdateOutRecord(*m_outFace, *interests[i]);
     }
     if (i >= gap3 && i < nRoundTrip + gap3) {
       // process incoming Data
@@ -145,11 +175,60 @@ BOOST_FIXTURE_TEST_CASE(SimpleExchanges, PitFibBenchmarkFixture)
   }
 
   auto t2 = time::steady_clock::now();
+  nAllocations = g_nAllocations - nAllocations;
+
+#ifdef HAVE_VALGRIND
+  CALLGRIND_STOP_INSTRUMENTATION;
+#endif
+
+  std::cout << time::duration_cast<time::microseconds>(t2 - t1) << ", "
+            << static_cast<double>(nAllocations) / nRoundTrip << " allocations per round trip"
+            << std::endl;
+}
+
+// This test case models the DMIF FIB lookup, where each prefix has learned several forwarderIds
+// and every incoming Interest is matched on (prefix, forwarderId).
+BOOST_FIXTURE_TEST_CASE(DmifLookups, PitFibBenchmarkFixture)
+{
+  // number of lookups
+  const size_t nLookups = 1000000;
+  // total amount of FIB entries
+  const size_t nFibEntries = 2000;
+  // number of forwarderIds learned per FIB entry
+  const size_t nForwarderIds = 32;
+
+  std::vector<Name> prefixes;
+  for (size_t i = 0; i < nFibEntries; ++i) {
+    Name prefix(to_string(i));
+    fib::Entry* entry = m_fib.insert(prefix).first;
+    for (size_t id = 0; id < nForwarderIds; ++id) {
+      m_fib.addForwarderId(*entry, static_cast<uint32_t>(id));
+    }
+    prefixes.push_back(prefix);
+  }
+
+#ifdef HAVE_VALGRIND
+  CALLGRIND_START_INSTRUMENTATION;
+#endif
+
+  size_t nFound = 0;
+  auto t1 = time::steady_clock::now();
+
+  for (size_t i = 0; i < nLookups; ++i) {
+    // every other lookup asks for a forwarderId that was never learned
+    uint32_t forwarderId = static_cast<uint32_t>(i % (2 * nForwarderIds));
+    if (m_fib.findExactMatch_dmif(prefixes[i % nFibEntries], forwarderId) != nullptr) {
+      ++nFound;
+    }
+  }
+
+  auto t2 = time::steady_clock::now();
 
 #ifdef HAVE_VALGRIND
   CALLGRIND_STOP_INSTRUMENTATION;
 #endif
 
+  BOOST_CHECK_EQUAL(nFound, nLookups / 2);
   std::cout << time::duration_cast<time::microseconds>(t2 - t1) << std::endl;
 }
 
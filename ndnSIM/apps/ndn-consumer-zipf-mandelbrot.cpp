@@ -23,6 +23,10 @@
 
 #include <math.h>
 
+#include <algorithm>
+#include <map>
+#include <tuple>
+
 NS_LOG_COMPONENT_DEFINE("ndn.ConsumerZipfMandelbrot");
 
 namespace ns3 {
@@ -30,6 +34,52 @@ namespace ndn {
 
 NS_OBJECT_ENSURE_REGISTERED(ConsumerZipfMandelbrot);
 
+/**
+ * @brief Get the cumulative probabilities of contents 1..N for the given parameters
+ *
+ * The table is computed once and shared by all consumers that use the same N, q and s;
+ * it is freed when the last of them is destroyed.
+ */
+static shared_ptr<const std::vector<double>>
+getCumulativeProbabilities(uint32_t n, double q, double s)
+{
+  typedef std::map<std::tuple<uint32_t, double, double>, std::weak_ptr<const std::vector<double>>>
+    Cache;
+  static Cache cache;
+
+  std::weak_ptr<const std::vector<double>>& cached = cache[std::make_tuple(n, q, s)];
+  shared_ptr<const std::vector<double>> cachedPcum = cached.lock();
+  if (cachedPcum != nullptr) {
+    return cachedPcum;
+  }
+
+  NS_LOG_DEBUG(q << " and " << s << " and " << n);
+
+  auto pcum = make_shared<std::vector<double>>(n + 1);
+  (*pcum)[0] = 0.0;
+  for (uint32_t i = 1; i <= n; i++) {
+    (*pcum)[i] = (*pcum)[i - 1] + 1.0 / std::pow(i + q, s);
+  }
+
+  double total = (*pcum)[n];
+  for (uint32_t i = 1; i <= n; i++) {
+    (*pcum)[i] = (*pcum)[i] / total;
+    NS_LOG_LOGIC("Cumulative probability [" << i << "]=" << (*pcum)[i]);
+  }
+
+  cached = pcum;
+
+  // forget the tables that are not used anymore
+  for (Cache::iterator it = cache.begin(); it != cache.end();) {
+    if (it->second.expired())
+      it = cache.erase(it);
+    else
+      ++it;
+  }
+
+  return pcum;
+}
+
 TypeId
 ConsumerZipfMandelbrot::GetTypeId(void)
 {
@@ -74,20 +124,7 @@ void
 ConsumerZipfMandelbrot::SetNumberOfContents(uint32_t numOfContents)
 {
   m_N = numOfContents;
-
-  NS_LOG_DEBUG(m_q << " and " << m_s << " and " << m_N);
-
-  m_Pcum = std::vector<double>(m_N + 1);
-
-  m_Pcum[0] = 0.0;
-  for (uint32_t i = 1; i <= m_N; i++) {
-    m_Pcum[i] = m_Pcum[i - 1] + 1.0 / std::pow(i + m_q, m_s);
-  }
-
-  for (uint32_t i = 1; i <= m_N; i++) {
-    m_Pcum[i] = m_Pcum[i] / m_Pcum[m_N];
-    NS_LOG_LOGIC("Cumulative probability [" << i << "]=" << m_Pcum[i]);
-  }
+  m_Pcum = nullptr; // will be obtained before the next sequence number is drawn
 }
 
 uint32_t
@@ -100,7 +137,7 @@ void
 ConsumerZipfMandelbrot::SetQ(double q)
 {
   m_q = q;
-  SetNumberOfContents(m_N);
+  m_Pcum = nullptr;
 }
 
 double
@@ -113,7 +150,7 @@ void
 ConsumerZipfMandelbrot::SetS(double s)
 {
   m_s = s;
-  SetNumberOfContents(m_N);
+  m_Pcum = nullptr;
 }
 
 double
@@ -198,8 +235,11 @@ ConsumerZipfMandelbrot::SendPacket()
 uint32_t
 ConsumerZipfMandelbrot::GetNextSeq()
 {
+  if (m_Pcum == nullptr) {
+    m_Pcum = getCumulativeProbabilities(m_N, m_q, m_s);
+  }
+
   uint32_t content_index = 1; //[1, m_N]
-  double p_sum = 0;
 
   double p_random = m_seqRng->GetValue();
   while (p_random == 0) {
@@ -207,15 +247,14 @@ ConsumerZipfMandelbrot::GetNextSeq()
   }
   // if (p_random == 0)
   NS_LOG_LOGIC("p_random=" << p_random);
-  for (uint32_t i = 1; i <= m_N; i++) {
-    p_sum = m_Pcum[i]; // m_Pcum[i] = m_Pcum[i-1] + p[i], p[0] = 0;   e.g.: p_cum[1] = p[1],
-                       // p_cum[2] = p[1] + p[2]
-    if (p_random <= p_sum) {
-      content_index = i;
-      break;
-    } // if
-  }   // for
-  // content_index = 1;
+
+  // the first content i with p_random <= m_Pcum[i], where m_Pcum[i] = m_Pcum[i-1] + p[i],
+  // p[0] = 0;   e.g.: p_cum[1] = p[1], p_cum[2] = p[1] + p[2]
+  std::vector<double>::const_iterator p_sum =
+    std::lower_bound(m_Pcum->begin() + 1, m_Pcum->end(), p_random);
+  if (p_sum != m_Pcum->end()) {
+    content_index = p_sum - m_Pcum->begin();
+  }
   NS_LOG_DEBUG("RandomNumber=" << content_index);
   return content_index;
 }
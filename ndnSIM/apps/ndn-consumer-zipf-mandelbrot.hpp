@@ -94,7 +94,8 @@ private:
   uint32_t m_N;               // number of the contents
   double m_q;                 // q in (k+q)^s
   double m_s;                 // s in (k+q)^s
-  std::vector<double> m_Pcum; // cumulative probability
+  shared_ptr<const std::vector<double>> m_Pcum; // cumulative probability, shared by all
+                                                // consumers with the same N, q and s
 
   Ptr<UniformRandomVariable> m_seqRng; // RNG
 };
@@ -197,7 +197,7 @@ Consumer::SendPacket() {
 	time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
 	interest->setInterestLifetime(interestLifeTime);
 
-	LogManager::AddLogWithNodeId("ndn-consumer.cpp->SendPacket.name", interest->getName().toUri());
+	DMIF_LOG_DEBUG("ndn-consumer.cpp", "SendPacket.name:" << interest->getName());
 
 	// NS_LOG_INFO ("Requesting Interest: \n" << *interest);
 	NS_LOG_INFO("> Interest for " << seq);
@@ -207,7 +207,7 @@ Consumer::SendPacket() {
 	/****** DMIF ******/
 	const_cast<Interest&>(*interest).setForwarderId(LogHelper::GetNodeId());
 	const_cast<Interest&>(*interest).setForwardingMode(ForwardingMode::Flooding);
-	LogManager::AddLogWithNodeId("ndn-consumer.cpp->SendPacket.ForwardingMode", interest->getForwardingModeName());
+	DMIF_LOG_DEBUG("ndn-consumer.cpp", "SendPacket.ForwardingMode:" << interest->getForwardingModeName());
 	LogManager::AddLogWithNodeId("ndn-consumer.cpp->SendPacket.ForwarderId", interest->getForwarderId());
 	/****** DMIF ******/
 
@@ -230,7 +230,7 @@ Consumer::OnData(shared_ptr<const Data> data)
     return;
 
   LogManager::AddLogWithNodeId("ndn-consumer.cpp->OnData.start");
-  LogManager::AddLogWithNodeId("ndn-consumer.cpp->OnData.name", data->getName().toUri());
+  DMIF_LOG_DEBUG("ndn-consumer.cpp", "OnData.name:" << data->getName());
 
   App::OnData(data); // tracing inside
 
@@ -95,7 +95,7 @@ void
 Producer::OnInterest(shared_ptr<const Interest> interest)
 {
 	LogManager::AddLogWithNodeId("ndn-producer.cpp->OnInterest.start");
-	LogManager::AddLogWithNodeId("ndn-producer.cpp->OnInterest.name", interest->getName().toUri());
+	DMIF_LOG_DEBUG("ndn-producer.cpp", "OnInterest.name:" << interest->getName());
   App::OnInterest(interest); // tracing inside
 
   NS_LOG_FUNCTION(this << interest);
@@ -0,0 +1,478 @@
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/internet-module.h"
+
+#include "ns3/ndnSIM-module.h"
+#include "ns3/position-allocator.h"
+
+#include <ndn-cxx/dmif-header.hpp>
+#include "ns3/ndnSIM/NFD/core/scheduler.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std;
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("ndn.DmifScenario");
+
+/**
+ * Wi-Fi grid scenario for DMIF, replacing the dmif-grid-* and dmif-n*-p*-s* examples.
+ *
+ * Every parameter can be given on the command line (--name=value) or, one name=value per
+ * line, in a file passed with --config; the command line wins. Consumers and producers are
+ * placed in one of three ways:
+ *
+ *   --pairs=2:12,7:17        consumer:producer node pairs, each with its own /pair-N/ prefix
+ *   --pairCount=5            that many random pairs; --placementSeed fixes the placement,
+ *                            otherwise it follows the ns-3 run number (--RngRun)
+ *   --consumers=0,3 --producers=2,5
+ *                            consumers and producers sharing --prefix
+ *
+ * Tracer outputs are written to --outputDir.
+ *
+ * Batch mode runs a sweep in parallel worker processes:
+ *
+ *   dmif-scenario --batch=sweep.txt --runs=5 --jobs=8 --outputDir=results
+ *
+ * Each non-empty line of the sweep file is one configuration (name=value tokens separated by
+ * spaces, applied on top of the options given to the batch itself). Every configuration is run
+ * --runs times with RngRun 1..runs, each in its own directory results/<line>-run<run>/ holding
+ * that run's tracer files and console output; results/runs.csv indexes them.
+ * examples/dmif-scenario/legacy-examples.sweep reproduces the removed examples.
+ */
+struct ScenarioConfig {
+	uint32_t rows = 10;
+	uint32_t columns = 10;
+	uint32_t nodes = 0; // 0: rows * columns
+	double distance = 125;
+	std::string pairs;
+	uint32_t pairCount = 0;
+	uint32_t placementSeed = 0;
+	std::string consumers;
+	std::string producers;
+	std::string prefix = "/test/";
+	uint32_t csSize = 1000;
+	double frequency = 1.0;
+	uint32_t payloadSize = 1200;
+	double duration = 20;
+	double txPower = 5;
+	bool dmifUnicast = false;
+	bool compactDmif = true;
+	bool timerWheel = false;
+	bool pcap = false;
+	std::string outputDir = ".";
+	std::string config;
+	std::string batch;
+	uint32_t runs = 1;
+	uint32_t jobs = 0; // 0: number of cores
+};
+
+struct AppPlacement {
+	uint32_t consumer;
+	uint32_t producer;
+	std::string prefix;
+};
+
+static std::vector<uint32_t>
+ParseNodeList(const std::string& list) {
+	std::vector<uint32_t> ids;
+	std::istringstream is(list);
+	std::string token;
+	while (std::getline(is, token, ','))
+		if (!token.empty())
+			ids.push_back(std::stoul(token));
+	return ids;
+}
+
+static std::vector<AppPlacement>
+PlaceApps(const ScenarioConfig& config) {
+	std::vector<AppPlacement> placements;
+
+	if (!config.pairs.empty()) {
+		std::istringstream is(config.pairs);
+		std::string token;
+		while (std::getline(is, token, ',')) {
+			size_t colon = token.find(':');
+			if (colon == std::string::npos)
+				NS_FATAL_ERROR("--pairs expects consumer:producer, got " << token);
+			std::string prefix = "/pair-" + std::to_string(placements.size() + 1) + "/";
+			placements.push_back({(uint32_t)std::stoul(token.substr(0, colon)),
+				(uint32_t)std::stoul(token.substr(colon + 1)), prefix});
+		}
+	}
+	else if (config.pairCount > 0) {
+		if (2 * config.pairCount > config.nodes)
+			NS_FATAL_ERROR("--pairCount=" << config.pairCount << " needs at least " << 2 * config.pairCount << " nodes");
+
+		// distinct nodes, drawn from the placement seed or from the ns-3 run
+		std::vector<uint32_t> ids(config.nodes);
+		for (uint32_t i = 0; i < config.nodes; i++)
+			ids[i] = i;
+		if (config.placementSeed != 0) {
+			std::mt19937 rng(config.placementSeed);
+			std::shuffle(ids.begin(), ids.end(), rng);
+		}
+		else {
+			Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable>();
+			for (uint32_t i = config.nodes - 1; i > 0; i--)
+				std::swap(ids[i], ids[rand->GetInteger(0, i)]);
+		}
+
+		for (uint32_t i = 0; i < config.pairCount; i++)
+			placements.push_back({ids[2 * i], ids[2 * i + 1], "/pair-" + std::to_string(i + 1) + "/"});
+	}
+
+	for (const AppPlacement& placement : placements)
+		if (placement.consumer >= config.nodes || placement.producer >= config.nodes)
+			NS_FATAL_ERROR("pair " << placement.consumer << ":" << placement.producer << " is outside the "
+					<< config.nodes << "-node topology");
+
+	return placements;
+}
+
+static void
+InstallApps(const ScenarioConfig& config, NodeContainer& nodes) {
+	ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+	consumerHelper.SetAttribute("Frequency", DoubleValue(config.frequency)); // no. of interests per second
+
+	ndn::AppHelper producerHelper("ns3::ndn::Producer");
+	producerHelper.SetAttribute("PayloadSize", UintegerValue(config.payloadSize));
+
+	for (const AppPlacement& placement : PlaceApps(config)) {
+		consumerHelper.SetPrefix(placement.prefix);
+		consumerHelper.Install(nodes.Get(placement.consumer));
+		producerHelper.SetPrefix(placement.prefix);
+		producerHelper.Install(nodes.Get(placement.producer));
+	}
+
+	// shared-prefix placement; node ids past the topology are ignored, as in the old examples
+	consumerHelper.SetPrefix(config.prefix);
+	for (uint32_t c : ParseNodeList(config.consumers))
+		if (c < config.nodes)
+			consumerHelper.Install(nodes.Get(c));
+
+	producerHelper.SetPrefix(config.prefix);
+	for (uint32_t p : ParseNodeList(config.producers))
+		if (p < config.nodes)
+			producerHelper.Install(nodes.Get(p));
+}
+
+static void
+RunScenario(const ScenarioConfig& config) {
+	// disable fragmentation
+	Config::SetDefault("ns3::WifiRemoteStationManager::FragmentationThreshold", StringValue("2200"));
+	Config::SetDefault("ns3::WifiRemoteStationManager::RtsCtsThreshold", StringValue("2200"));
+	Config::SetDefault("ns3::WifiRemoteStationManager::NonUnicastMode", StringValue("OfdmRate24Mbps"));
+
+	::ndn::dmif::setWireFormat(config.compactDmif ? ::ndn::dmif::WireFormat::COMPACT
+	                                              : ::ndn::dmif::WireFormat::LEGACY);
+	nfd::scheduler::setGlobalSchedulerBackend(config.timerWheel ? ::ndn::Scheduler::Backend::TIMER_WHEEL
+	                                                            : ::ndn::Scheduler::Backend::SIMULATOR);
+
+	WifiHelper wifi = WifiHelper::Default();
+	wifi.SetStandard(WIFI_PHY_STANDARD_80211a);
+	wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager", "DataMode", StringValue("OfdmRate24Mbps"));
+
+	YansWifiChannelHelper wifiChannel;
+	wifiChannel.SetPropagationDelay("ns3::ConstantSpeedPropagationDelayModel");
+	wifiChannel.AddPropagationLoss("ns3::ThreeLogDistancePropagationLossModel");
+	wifiChannel.AddPropagationLoss("ns3::NakagamiPropagationLossModel");
+
+	YansWifiPhyHelper wifiPhyHelper = YansWifiPhyHelper::Default();
+	wifiPhyHelper.SetChannel(wifiChannel.Create());
+	wifiPhyHelper.Set("TxPowerStart", DoubleValue(config.txPower));
+	wifiPhyHelper.Set("TxPowerEnd", DoubleValue(config.txPower));
+
+	NqosWifiMacHelper wifiMacHelper = NqosWifiMacHelper::Default();
+	wifiMacHelper.SetType("ns3::AdhocWifiMac");
+
+	NodeContainer nodes;
+	nodes.Create(config.nodes);
+
+	// 1. Install Wifi
+	NetDeviceContainer wifiNetDevices = wifi.Install(wifiPhyHelper, wifiMacHelper, nodes);
+	if (config.pcap)
+		wifiPhyHelper.EnablePcap("wave-simple-80211a", wifiNetDevices);
+
+	// row-major grid; with fewer nodes than cells the last cells stay empty
+	MobilityHelper mobility;
+	Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator>();
+	for (uint32_t i = 0; i < config.rows; i++)
+		for (uint32_t j = 0; j < config.columns; j++)
+			positionAlloc->Add(Vector(i * config.distance, j * config.distance, 0.0));
+	mobility.SetPositionAllocator(positionAlloc);
+	mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+
+	// 2. Install Mobility model
+	mobility.Install(nodes);
+
+	// 3. Install NDN stack
+	NS_LOG_INFO("Installing NDN stack");
+	ndn::StackHelper ndnHelper;
+	ndnHelper.SetOldContentStore("ns3::ndn::cs::Lru", "MaxSize", std::to_string(config.csSize));
+	ndnHelper.SetDefaultRoutes(true);
+	ndnHelper.SetDmifUnicast(config.dmifUnicast);
+	ndnHelper.Install(nodes);
+
+	// Set BestRoute strategy
+	ndn::StrategyChoiceHelper::Install(nodes, "/", "/localhost/nfd/strategy/best-route");
+
+	// 4. Set up applications
+	NS_LOG_INFO("Installing Applications");
+	InstallApps(config, nodes);
+
+	// 5. Running simulation
+	Simulator::Stop(Seconds(config.duration));
+
+	ndn::AppDelayTracer::InstallAll("app-delays-trace.txt");
+	ndn::CsTracer::InstallAll("cs-trace.txt", Seconds(1));
+	ndn::L3RateTracer::InstallAll("rate-trace.txt", Seconds(1.0));
+	L2RateTracer::InstallAll("drop-trace.txt", Seconds(0.5));
+
+	Simulator::Run();
+	Simulator::Destroy();
+}
+
+static void
+AddOptions(CommandLine& cmd, ScenarioConfig& config) {
+	cmd.AddValue("rows", "grid rows", config.rows);
+	cmd.AddValue("columns", "grid columns", config.columns);
+	cmd.AddValue("nodes", "number of nodes (default rows * columns)", config.nodes);
+	cmd.AddValue("distance", "grid spacing in meters", config.distance);
+	cmd.AddValue("pairs", "consumer:producer node pairs, comma separated", config.pairs);
+	cmd.AddValue("pairCount", "number of randomly placed consumer/producer pairs", config.pairCount);
+	cmd.AddValue("placementSeed", "seed for random pair placement (0: follow RngRun)", config.placementSeed);
+	cmd.AddValue("consumers", "consumer nodes sharing --prefix, comma separated", config.consumers);
+	cmd.AddValue("producers", "producer nodes sharing --prefix, comma separated", config.producers);
+	cmd.AddValue("prefix", "prefix of --consumers/--producers", config.prefix);
+	cmd.AddValue("csSize", "content store size (packets)", config.csSize);
+	cmd.AddValue("frequency", "Interests per second per consumer", config.frequency);
+	cmd.AddValue("payloadSize", "Data payload size (bytes)", config.payloadSize);
+	cmd.AddValue("duration", "simulated seconds", config.duration);
+	cmd.AddValue("txPower", "Wi-Fi transmit power (dBm)", config.txPower);
+	cmd.AddValue("dmifUnicast", "send Directive-mode Interests as unicast frames", config.dmifUnicast);
+	cmd.AddValue("compactDmif", "encode DMIF fields as a single DmifHeader element (false: legacy layout)", config.compactDmif);
+	cmd.AddValue("timerWheel", "keep NFD timers in a timing wheel (false: one ns-3 event per timer)", config.timerWheel);
+	cmd.AddValue("pcap", "write pcap traces", config.pcap);
+	cmd.AddValue("outputDir", "directory for tracer outputs", config.outputDir);
+	cmd.AddValue("config", "file with one name=value option per line", config.config);
+	cmd.AddValue("batch", "sweep file; runs each line as a separate configuration", config.batch);
+	cmd.AddValue("runs", "batch: RngRun values 1..runs for every configuration", config.runs);
+	cmd.AddValue("jobs", "batch: parallel worker processes (0: number of cores)", config.jobs);
+}
+
+static std::vector<std::string>
+SplitTokens(const std::string& line) {
+	std::vector<std::string> tokens;
+	std::istringstream is(line);
+	std::string token;
+	while (is >> token)
+		tokens.push_back(token);
+	return tokens;
+}
+
+static std::string
+AsOption(const std::string& token) {
+	return token.compare(0, 2, "--") == 0 ? token : "--" + token;
+}
+
+static bool
+IsBatchOption(const std::string& arg) {
+	for (const char* name : {"--batch=", "--runs=", "--jobs=", "--outputDir=", "--config="})
+		if (arg.compare(0, strlen(name), name) == 0)
+			return true;
+	return false;
+}
+
+static void
+MakeDirectories(const std::string& path) {
+	for (size_t pos = path.find('/', 1); ; pos = path.find('/', pos + 1)) {
+		std::string dir = path.substr(0, pos);
+		if (mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST)
+			NS_FATAL_ERROR("cannot create " << dir);
+		if (pos == std::string::npos)
+			break;
+	}
+}
+
+/** \brief command line with the options of --config, if any, in front of argv
+ */
+static std::vector<std::string>
+ExpandArguments(int argc, char* argv[]) {
+	std::vector<std::string> args(argv, argv + argc);
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		if (arg.compare(0, 9, "--config=") != 0)
+			continue;
+
+		std::ifstream file(arg.substr(9));
+		if (!file)
+			NS_FATAL_ERROR("cannot read " << arg.substr(9));
+
+		std::vector<std::string> fromFile;
+		std::string line;
+		while (std::getline(file, line)) {
+			line = line.substr(0, line.find('#'));
+			for (const std::string& token : SplitTokens(line))
+				fromFile.push_back(AsOption(token));
+		}
+		args.insert(args.begin() + 1, fromFile.begin(), fromFile.end());
+		break;
+	}
+	return args;
+}
+
+struct BatchRun {
+	std::string directory;
+	std::vector<std::string> args;
+	pid_t pid = 0;
+	int status = -1;
+};
+
+static pid_t
+StartRun(const BatchRun& run) {
+	pid_t pid = fork();
+	if (pid != 0)
+		return pid;
+
+	// worker: console output goes next to the run's tracer files
+	std::string log = run.directory + "/stdout.txt";
+	if (freopen(log.c_str(), "w", stdout) == nullptr || dup2(fileno(stdout), STDERR_FILENO) < 0)
+		_exit(127);
+
+	std::vector<char*> argv;
+	for (const std::string& arg : run.args)
+		argv.push_back(const_cast<char*>(arg.c_str()));
+	argv.push_back(nullptr);
+	execv("/proc/self/exe", argv.data());
+	_exit(127);
+}
+
+static int
+RunBatch(const ScenarioConfig& config, const std::vector<std::string>& args) {
+	std::ifstream file(config.batch);
+	if (!file)
+		NS_FATAL_ERROR("cannot read " << config.batch);
+
+	// options given to the batch itself apply to every run
+	std::vector<std::string> common;
+	for (size_t i = 1; i < args.size(); i++)
+		if (!IsBatchOption(args[i]))
+			common.push_back(args[i]);
+
+	std::vector<BatchRun> runs;
+	std::string line;
+	for (int lineNo = 1; std::getline(file, line); lineNo++) {
+		std::vector<std::string> tokens = SplitTokens(line.substr(0, line.find('#')));
+		if (tokens.empty())
+			continue;
+
+		for (uint32_t rngRun = 1; rngRun <= config.runs; rngRun++) {
+			BatchRun run;
+			run.directory = config.outputDir + "/" + std::to_string(lineNo) + "-run" + std::to_string(rngRun);
+			run.args.push_back(args[0]);
+			run.args.insert(run.args.end(), common.begin(), common.end());
+			for (const std::string& token : tokens)
+				run.args.push_back(AsOption(token));
+			run.args.push_back("--RngRun=" + std::to_string(rngRun));
+			run.args.push_back("--outputDir=" + run.directory);
+			runs.push_back(run);
+		}
+	}
+
+	uint32_t jobs = config.jobs != 0 ? config.jobs : std::max(1u, std::thread::hardware_concurrency());
+	std::cout << "Running " << runs.size() << " simulations on " << jobs << " workers" << std::endl;
+
+	std::map<pid_t, size_t> running;
+	size_t next = 0;
+	size_t failed = 0;
+	while (next < runs.size() || !running.empty()) {
+		while (next < runs.size() && running.size() < jobs) {
+			MakeDirectories(runs[next].directory);
+			runs[next].pid = StartRun(runs[next]);
+			running[runs[next].pid] = next;
+			next++;
+		}
+
+		int status = 0;
+		pid_t pid = wait(&status);
+		if (pid < 0)
+			break;
+		auto it = running.find(pid);
+		if (it == running.end())
+			continue;
+
+		BatchRun& run = runs[it->second];
+		run.status = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+		if (run.status != 0)
+			failed++;
+		std::cout << run.directory << ": " << (run.status == 0 ? "done" : "FAILED") << std::endl;
+		running.erase(it);
+	}
+
+	std::ofstream index(config.outputDir + "/runs.csv");
+	index << "directory,status,arguments\n";
+	for (const BatchRun& run : runs) {
+		index << run.directory << "," << run.status << ",\"";
+		for (size_t i = 1; i < run.args.size(); i++)
+			index << (i > 1 ? " " : "") << run.args[i];
+		index << "\"\n";
+	}
+
+	std::cout << runs.size() - failed << " of " << runs.size() << " simulations succeeded" << std::endl;
+	return failed == 0 ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+	std::vector<std::string> args = ExpandArguments(argc, argv);
+	std::vector<char*> expanded;
+	for (std::string& arg : args)
+		expanded.push_back(&arg[0]);
+
+	ScenarioConfig config;
+	CommandLine cmd;
+	AddOptions(cmd, config);
+	cmd.Parse(expanded.size(), expanded.data());
+
+	if (!config.batch.empty()) {
+		MakeDirectories(config.outputDir);
+		return RunBatch(config, args);
+	}
+
+	if (config.nodes == 0)
+		config.nodes = config.rows * config.columns;
+	if (config.nodes > config.rows * config.columns)
+		NS_FATAL_ERROR("--nodes=" << config.nodes << " does not fit a " << config.rows << "x" << config.columns << " grid");
+
+	// tracers and DMIF logs use relative paths
+	if (config.outputDir != ".") {
+		MakeDirectories(config.outputDir);
+		if (chdir(config.outputDir.c_str()) != 0)
+			NS_FATAL_ERROR("cannot enter " << config.outputDir);
+	}
+
+	RunScenario(config);
+	return 0;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+	return ns3::main(argc, argv);
+}
@@ -39,9 +39,12 @@
 #include "ns3/data-rate.h"
 
 #include "daemon/mgmt/fib-manager.hpp"
+#include "daemon/table/fib.hpp"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
 #include "ns3/ndnSIM/helper/ndn-stack-helper.hpp"
 
+#include <algorithm>
+
 namespace ns3 {
 namespace ndn {
 
@@ -256,6 +259,93 @@ FibHelper::RemoveRoute(const std::string& nodeName, const Name& prefix,
   RemoveRoute(node, prefix, otherNode);
 }
 
+void
+FibHelper::UpdateRoutes(const RouteUpdateBatch& batch)
+{
+  auto isSameEntry = [] (const RouteUpdate* a, const RouteUpdate* b) {
+    return a->node == b->node && (a->prefix == b->prefix || *a->prefix == *b->prefix);
+  };
+
+  // Group the updates by node, prefix and face. The sort is stable, so that the last update
+  // of a next hop is the one that takes effect, as if the updates were applied one by one.
+  std::vector<const RouteUpdate*> updates;
+  updates.reserve(batch.size());
+  for (const RouteUpdate& update : batch) {
+    updates.push_back(&update);
+  }
+  std::stable_sort(updates.begin(), updates.end(), [] (const RouteUpdate* a, const RouteUpdate* b) {
+    if (a->node != b->node) {
+      return a->node->GetId() < b->node->GetId();
+    }
+    if (a->prefix != b->prefix) {
+      int order = a->prefix->compare(*b->prefix);
+      if (order != 0) {
+        return order < 0;
+      }
+    }
+    return a->face->getId() < b->face->getId();
+  });
+
+  nfd::fib::NextHopList nextHops;
+  std::vector<const Face*> removedFaces;
+  auto it = updates.begin();
+  while (it != updates.end()) {
+    Ptr<Node> node = (*it)->node;
+    const Name& prefix = *(*it)->prefix;
+
+    Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+    NS_ASSERT_MSG(ndn != 0, "Ndn stack should be installed on the node");
+
+    nextHops.clear();
+    removedFaces.clear();
+    auto entryBegin = it;
+    for (; it != updates.end() && isSameEntry(*entryBegin, *it); ++it) {
+      const RouteUpdate& update = **it;
+      auto next = std::next(it);
+      if (next != updates.end() && isSameEntry(*it, *next) && (*next)->face == update.face) {
+        continue; // superseded by a later update
+      }
+
+      if (update.isRemoval) {
+        NS_LOG_LOGIC("[" << node->GetId() << "]$ route del " << prefix << " via "
+                     << update.face->getLocalUri());
+        removedFaces.push_back(update.face.get());
+      }
+      else {
+        NS_LOG_LOGIC("[" << node->GetId() << "]$ route add " << prefix << " via "
+                     << update.face->getLocalUri() << " metric " << update.metric);
+        NS_ASSERT_MSG(ndn->getFaceById(update.face->getId()) == update.face,
+                      "Face " << update.face->getId() << " does not belong to node ["
+                              << node->GetId() << "]");
+        nextHops.emplace_back(*update.face);
+        nextHops.back().setCost(update.metric);
+      }
+    }
+
+    if (prefix.size() > nfd::Fib::getMaxDepth()) {
+      NS_LOG_DEBUG("Prefix " << prefix << " exceeds the maximum FIB entry depth, ignored");
+      continue;
+    }
+
+    nfd::Fib& fib = ndn->getForwarder()->getFib();
+    if (!nextHops.empty()) {
+      fib.insert(prefix).first->addNextHops(nextHops);
+    }
+    if (!removedFaces.empty()) {
+      nfd::fib::Entry* entry = fib.findExactMatch(prefix);
+      if (entry == nullptr) {
+        continue;
+      }
+      for (const Face* face : removedFaces) {
+        entry->removeNextHop(*face);
+      }
+      if (!entry->hasNextHops()) {
+        fib.erase(*entry);
+      }
+    }
+  }
+}
+
 } // namespace ndn
 
 } // namespace ns
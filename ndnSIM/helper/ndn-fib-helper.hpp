@@ -33,6 +33,20 @@ namespace ndn {
 
 using ::ndn::nfd::ControlParameters;
 
+/**
+ * @brief A change of a FIB next hop, to be applied by FibHelper::UpdateRoutes
+ */
+struct RouteUpdate
+{
+  Ptr<Node> node;
+  shared_ptr<Name> prefix;
+  shared_ptr<Face> face;
+  int32_t metric;
+  bool isRemoval;
+};
+
+typedef std::vector<RouteUpdate> RouteUpdateBatch;
+
 /**
  * @ingroup ndn-helpers
  * @brief Forwarding Information Base (FIB) helper
@@ -150,6 +164,20 @@ public:
   static void
   RemoveRoute(const std::string& nodeName, const Name& prefix, const std::string& otherNodeName);
 
+  /**
+   * @brief Add and remove many forwarding entries at once
+   *
+   * Unlike AddRoute and RemoveRoute, which send a signed command Interest to the FIB manager
+   * of NFD for every route, this writes directly into the FIB of each node, and the next hops
+   * of each FIB entry are sorted once. It is meant for installing the routes of large
+   * scenarios, e.g., by GlobalRoutingHelper. The result is the same as calling AddRoute or
+   * RemoveRoute for each element of @p batch in order.
+   *
+   * \param batch route updates, in any order of nodes and prefixes
+   */
+  static void
+  UpdateRoutes(const RouteUpdateBatch& batch);
+
 private:
   static void
   GenerateCommand(Interest& interest);
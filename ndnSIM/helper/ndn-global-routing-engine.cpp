@@ -0,0 +1,420 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-global-routing-engine.hpp"
+
+#include "model/ndn-global-router.hpp"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+
+#include "boost-graph-ndn-global-routing-helper.hpp"
+
+#include <boost/graph/detail/d_ary_heap.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <map>
+#include <thread>
+#include <tuple>
+
+NS_LOG_COMPONENT_DEFINE("ndn.GlobalRoutingEngine");
+
+namespace ns3 {
+namespace ndn {
+
+// same as boost::WeightInf: a path of this metric or more is unreachable
+const GlobalRoutingEngine::Distance GlobalRoutingEngine::INF =
+  std::numeric_limits<uint16_t>::max();
+// value used by CalculateAllPossibleRoutes to disable a face
+const GlobalRoutingEngine::Distance GlobalRoutingEngine::DISABLED_METRIC =
+  std::numeric_limits<uint16_t>::max() - 1;
+const GlobalRoutingEngine::Edge GlobalRoutingEngine::NO_EDGE =
+  std::numeric_limits<uint32_t>::max();
+
+/**
+ * @brief per-thread state of the searches
+ */
+struct GlobalRoutingEngine::Scratch
+{
+  enum Color : uint8_t {
+    WHITE, ///< not seen yet
+    GRAY,  ///< in the queue
+    BLACK  ///< done
+  };
+
+  std::vector<Edge> firstEdge; ///< first edge of the shortest path to each vertex
+  std::vector<Color> color;
+  std::vector<size_t> indexInHeap;
+  std::vector<Distance> dist;
+};
+
+GlobalRoutingEngine::GlobalRoutingEngine(size_t nThreads)
+  : m_nThreads(nThreads != 0 ? nThreads : std::max(1u, std::thread::hardware_concurrency()))
+{
+  TakeSnapshot();
+}
+
+void
+GlobalRoutingEngine::TakeSnapshot()
+{
+  boost::NdnGlobalRouterGraph graph;
+
+  std::unordered_map<const GlobalRouter*, Vertex> vertexIds;
+  for (const auto& gr : graph.GetVertices()) {
+    vertexIds.emplace(PeekPointer(gr), static_cast<Vertex>(m_vertexNode.size()));
+    m_vertexNode.push_back(gr->GetObject<Node>());
+  }
+
+  std::map<Name, uint32_t> prefixIds;
+  m_edgeBegin.reserve(m_vertexNode.size() + 1);
+  m_prefixBegin.reserve(m_vertexNode.size() + 1);
+  for (const auto& gr : graph.GetVertices()) {
+    m_edgeBegin.push_back(static_cast<uint32_t>(m_edgeTarget.size()));
+    for (const auto& incidency : gr->GetIncidencies()) {
+      const auto& face = std::get<1>(incidency);
+      auto target = vertexIds.find(PeekPointer(std::get<2>(incidency)));
+      NS_ASSERT(target != vertexIds.end());
+
+      if (face != nullptr) {
+        m_faceEdge.emplace(face.get(), static_cast<Edge>(m_edgeTarget.size()));
+      }
+      m_edgeTarget.push_back(target->second);
+      // same as boost::get(EdgeWeights, Incidency)
+      m_edgeMetric.push_back(face == nullptr ? 0 : static_cast<Distance>(face->getMetric()));
+      m_isEdgeUp.push_back(1);
+      m_edgeFace.push_back(face);
+    }
+
+    m_prefixBegin.push_back(static_cast<uint32_t>(m_prefixIds.size()));
+    for (const auto& prefix : gr->GetLocalPrefixes()) {
+      auto it = prefixIds.emplace(*prefix, static_cast<uint32_t>(m_prefixes.size())).first;
+      if (it->second == m_prefixes.size()) {
+        m_prefixes.push_back(prefix);
+      }
+      m_prefixIds.push_back(it->second);
+    }
+  }
+  m_edgeBegin.push_back(static_cast<uint32_t>(m_edgeTarget.size()));
+  m_prefixBegin.push_back(static_cast<uint32_t>(m_prefixIds.size()));
+
+  for (Vertex v = 0; v < m_vertexNode.size(); ++v) {
+    if (m_vertexNode[v] != nullptr) {
+      m_sources.push_back(v);
+    }
+  }
+
+  NS_LOG_DEBUG("Snapshot of " << m_vertexNode.size() << " vertices (" << m_sources.size()
+               << " nodes), " << m_edgeTarget.size() << " edges, " << m_prefixes.size()
+               << " prefixes");
+}
+
+template<typename F>
+void
+GlobalRoutingEngine::ParallelFor(size_t nTasks, const F& f) const
+{
+  size_t nThreads = std::min(m_nThreads, nTasks);
+  std::atomic<size_t> nextTask(0);
+  auto worker = [&] {
+    Scratch scratch;
+    scratch.firstEdge.resize(m_vertexNode.size());
+    scratch.color.resize(m_vertexNode.size());
+    scratch.indexInHeap.resize(m_vertexNode.size());
+    scratch.dist.resize(m_vertexNode.size());
+    for (size_t task = nextTask++; task < nTasks; task = nextTask++) {
+      f(task, scratch);
+    }
+  };
+
+  if (nThreads <= 1) {
+    worker();
+    return;
+  }
+
+  std::vector<std::thread> threads;
+  threads.reserve(nThreads - 1);
+  for (size_t i = 1; i < nThreads; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+void
+GlobalRoutingEngine::Search(Vertex source, Edge enabledEdge, Distance* dist,
+                            Scratch& scratch) const
+{
+  std::fill_n(dist, m_vertexNode.size(), INF);
+  std::fill(scratch.firstEdge.begin(), scratch.firstEdge.end(), NO_EDGE);
+  std::fill(scratch.color.begin(), scratch.color.end(), Scratch::WHITE);
+
+  // Equal-cost paths are resolved as by boost::dijkstra_shortest_paths on NdnGlobalRouterGraph,
+  // which this search replaces: same 4-ary queue, a vertex is queued when first seen even if it
+  // is not reachable, and a path replaces the current one only if it is strictly shorter.
+  // Which of the equal-cost next hops is installed therefore does not change.
+  boost::d_ary_heap_indirect<Vertex, 4, size_t*, Distance*> queue(dist,
+                                                                  scratch.indexInHeap.data());
+  dist[source] = 0;
+  scratch.color[source] = Scratch::GRAY;
+  queue.push(source);
+
+  while (!queue.empty()) {
+    Vertex u = queue.top();
+    queue.pop();
+    uint32_t d = dist[u];
+
+    for (Edge e = m_edgeBegin[u]; e < m_edgeBegin[u + 1]; ++e) {
+      if (!m_isEdgeUp[e]) {
+        continue;
+      }
+      uint32_t metric = m_edgeMetric[e];
+      if (u == source && enabledEdge != NO_EDGE && e != enabledEdge) {
+        metric = DISABLED_METRIC;
+      }
+
+      Vertex v = m_edgeTarget[e];
+      if (scratch.color[v] == Scratch::BLACK) {
+        continue;
+      }
+
+      uint32_t newDist = d + metric;
+      bool isRelaxed = newDist < dist[v];
+      if (isRelaxed) {
+        dist[v] = static_cast<Distance>(newDist);
+        scratch.firstEdge[v] = u == source ? e : scratch.firstEdge[u];
+      }
+
+      if (scratch.color[v] == Scratch::WHITE) {
+        scratch.color[v] = Scratch::GRAY;
+        queue.push(v);
+      }
+      else if (isRelaxed) {
+        queue.update(v);
+      }
+    }
+    scratch.color[u] = Scratch::BLACK;
+  }
+}
+
+void
+GlobalRoutingEngine::CollectRoutes(Vertex source, Edge enabledEdge, const Distance* dist,
+                                   const Scratch& scratch, std::vector<Route>& routes) const
+{
+  for (Vertex v = 0; v < m_vertexNode.size(); ++v) {
+    Edge edge = scratch.firstEdge[v];
+    if (v == source || edge == NO_EDGE) {
+      continue; // unreachable
+    }
+    if (enabledEdge != NO_EDGE && (edge != enabledEdge || m_edgeMetric[edge] == DISABLED_METRIC)) {
+      continue; // through a disabled face
+    }
+
+    for (uint32_t i = m_prefixBegin[v]; i < m_prefixBegin[v + 1]; ++i) {
+      routes.push_back({m_prefixIds[i], edge, dist[v]});
+    }
+  }
+}
+
+/**
+ * @brief sort routes by prefix and edge, keeping the lowest metric for the same prefix and edge
+ */
+template<typename Route>
+static void
+normalizeRoutes(std::vector<Route>& routes)
+{
+  std::sort(routes.begin(), routes.end(), [] (const Route& a, const Route& b) {
+      return std::tie(a.prefix, a.edge, a.metric) < std::tie(b.prefix, b.edge, b.metric);
+    });
+  routes.erase(std::unique(routes.begin(), routes.end(), [] (const Route& a, const Route& b) {
+                   return a.prefix == b.prefix && a.edge == b.edge;
+                 }),
+               routes.end());
+}
+
+void
+GlobalRoutingEngine::ComputeSources(const std::vector<size_t>& slots)
+{
+  size_t nVertices = m_vertexNode.size();
+  ParallelFor(slots.size(), [&] (size_t task, Scratch& scratch) {
+      size_t slot = slots[task];
+      Vertex source = m_sources[slot];
+      Distance* dist = &m_dist[slot * nVertices];
+      Search(source, NO_EDGE, dist, scratch);
+
+      std::vector<Route>& routes = m_routes[slot];
+      routes.clear();
+      CollectRoutes(source, NO_EDGE, dist, scratch, routes);
+      normalizeRoutes(routes);
+    });
+}
+
+void
+GlobalRoutingEngine::AppendUpdates(Vertex source, const std::vector<Route>& routes,
+                                   bool isRemoval, RouteUpdateBatch& batch) const
+{
+  for (const Route& route : routes) {
+    batch.push_back({m_vertexNode[source], m_prefixes[route.prefix], m_edgeFace[route.edge],
+                     route.metric, isRemoval});
+  }
+}
+
+RouteUpdateBatch
+GlobalRoutingEngine::CalculateRoutes()
+{
+  m_dist.assign(m_sources.size() * m_vertexNode.size(), INF);
+  m_routes.assign(m_sources.size(), {});
+
+  std::vector<size_t> slots(m_sources.size());
+  for (size_t i = 0; i < slots.size(); ++i) {
+    slots[i] = i;
+  }
+  ComputeSources(slots);
+
+  RouteUpdateBatch batch;
+  for (size_t slot = 0; slot < m_sources.size(); ++slot) {
+    AppendUpdates(m_sources[slot], m_routes[slot], false, batch);
+  }
+  return batch;
+}
+
+RouteUpdateBatch
+GlobalRoutingEngine::CalculateAllPossibleRoutes()
+{
+  // one task per out-edge of every node
+  std::vector<std::pair<size_t, Edge>> tasks;
+  for (size_t slot = 0; slot < m_sources.size(); ++slot) {
+    Vertex source = m_sources[slot];
+    for (Edge e = m_edgeBegin[source]; e < m_edgeBegin[source + 1]; ++e) {
+      tasks.emplace_back(slot, e);
+    }
+  }
+
+  std::vector<std::vector<Route>> routes(tasks.size());
+  ParallelFor(tasks.size(), [&] (size_t task, Scratch& scratch) {
+      Vertex source = m_sources[tasks[task].first];
+      Edge enabledEdge = tasks[task].second;
+      Search(source, enabledEdge, scratch.dist.data(), scratch);
+      CollectRoutes(source, enabledEdge, scratch.dist.data(), scratch, routes[task]);
+    });
+
+  RouteUpdateBatch batch;
+  std::vector<Route> sourceRoutes;
+  for (size_t begin = 0, end = 0; begin < tasks.size(); begin = end) {
+    sourceRoutes.clear();
+    for (end = begin; end < tasks.size() && tasks[end].first == tasks[begin].first; ++end) {
+      sourceRoutes.insert(sourceRoutes.end(), routes[end].begin(), routes[end].end());
+    }
+    normalizeRoutes(sourceRoutes);
+    AppendUpdates(m_sources[tasks[begin].first], sourceRoutes, false, batch);
+  }
+  return batch;
+}
+
+RouteUpdateBatch
+GlobalRoutingEngine::SetLinkState(const Face& face1, const Face& face2, bool isUp)
+{
+  NS_ASSERT_MSG(m_routes.size() == m_sources.size(), "CalculateRoutes has not been called");
+
+  std::vector<std::pair<Vertex, Edge>> changed;
+  for (const Face* face : {&face1, &face2}) {
+    auto it = m_faceEdge.find(face);
+    if (it != m_faceEdge.end() && m_isEdgeUp[it->second] != isUp) {
+      Edge e = it->second;
+      Vertex u = std::upper_bound(m_edgeBegin.begin(), m_edgeBegin.end(), e) - m_edgeBegin.begin() - 1;
+      changed.emplace_back(u, e);
+    }
+  }
+  if (changed.empty()) {
+    return {};
+  }
+
+  // A failed edge affects a source if it lies on a shortest path, i.e., it is tight.
+  // A restored edge affects a source if it gives an equal or shorter path to its target.
+  size_t nVertices = m_vertexNode.size();
+  std::vector<size_t> affected;
+  for (size_t slot = 0; slot < m_sources.size(); ++slot) {
+    const Distance* dist = &m_dist[slot * nVertices];
+    bool isAffected = false;
+    for (const auto& edge : changed) {
+      Vertex u = edge.first;
+      Edge e = edge.second;
+      if (dist[u] == INF) {
+        continue;
+      }
+      uint32_t viaEdge = uint32_t(dist[u]) + m_edgeMetric[e];
+      Distance current = dist[m_edgeTarget[e]];
+      if (isUp ? viaEdge <= current && viaEdge < INF : viaEdge == current) {
+        isAffected = true;
+        break;
+      }
+    }
+    if (isAffected) {
+      affected.push_back(slot);
+    }
+  }
+
+  for (const auto& edge : changed) {
+    m_isEdgeUp[edge.second] = isUp;
+  }
+
+  std::vector<std::vector<Route>> oldRoutes;
+  oldRoutes.reserve(affected.size());
+  for (size_t slot : affected) {
+    oldRoutes.push_back(m_routes[slot]);
+  }
+  ComputeSources(affected);
+
+  NS_LOG_DEBUG("Link " << (isUp ? "up" : "down") << ": recomputed " << affected.size()
+               << " of " << m_sources.size() << " nodes");
+
+  RouteUpdateBatch batch;
+  std::vector<Route> removed, added;
+  auto byPrefixAndEdge = [] (const Route& a, const Route& b) {
+    return std::tie(a.prefix, a.edge) < std::tie(b.prefix, b.edge);
+  };
+  for (size_t i = 0; i < affected.size(); ++i) {
+    const std::vector<Route>& before = oldRoutes[i];
+    const std::vector<Route>& after = m_routes[affected[i]];
+
+    removed.clear();
+    std::set_difference(before.begin(), before.end(), after.begin(), after.end(),
+                        std::back_inserter(removed), byPrefixAndEdge);
+
+    // new routes, and existing routes with a different metric
+    added.clear();
+    auto it = before.begin();
+    for (const Route& route : after) {
+      it = std::lower_bound(it, before.end(), route, byPrefixAndEdge);
+      if (it == before.end() || byPrefixAndEdge(route, *it) || it->metric != route.metric) {
+        added.push_back(route);
+      }
+    }
+
+    Vertex source = m_sources[affected[i]];
+    AppendUpdates(source, removed, true, batch);
+    AppendUpdates(source, added, false, batch);
+  }
+  return batch;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,183 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_GLOBAL_ROUTING_ENGINE_H
+#define NDN_GLOBAL_ROUTING_ENGINE_H
+
+/// @cond include_hidden
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/helper/ndn-fib-helper.hpp"
+
+#include "ns3/ptr.h"
+#include "ns3/node.h"
+
+#include <boost/noncopyable.hpp>
+
+#include <unordered_map>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Shortest path computation for GlobalRoutingHelper
+ *
+ * The engine takes a snapshot of the graph formed by the GlobalRouter objects of nodes and
+ * channels (boost::NdnGlobalRouterGraph), with face metrics at the time of the snapshot, and
+ * stores it in compressed sparse row form. The per-source Dijkstra searches only read the
+ * snapshot, so they run on a pool of threads; ns-3 objects are touched on the calling thread
+ * only, when the results are turned into a RouteUpdateBatch.
+ *
+ * After CalculateRoutes, the engine keeps the distances from every node, so that
+ * SetLinkState recomputes only the sources whose shortest paths may be affected by
+ * a link failing or being restored, and returns the difference of their routes.
+ */
+class GlobalRoutingEngine : boost::noncopyable
+{
+public:
+  /**
+   * @param nThreads number of threads for the searches, 0 for one per hardware thread
+   */
+  explicit
+  GlobalRoutingEngine(size_t nThreads = 0);
+
+  /**
+   * @brief Calculate the shortest path from every node to every prefix origin
+   * @return one route per node, prefix and next hop face
+   */
+  RouteUpdateBatch
+  CalculateRoutes();
+
+  /**
+   * @brief Calculate the shortest path through each face of every node to every prefix origin
+   *
+   * This is the computation of GlobalRoutingHelper::CalculateAllPossibleRoutes: each face
+   * of a node is evaluated with the other faces of that node set to a prohibitive metric.
+   * It does not enable SetLinkState.
+   */
+  RouteUpdateBatch
+  CalculateAllPossibleRoutes();
+
+  /**
+   * @brief Fail or restore the link between two faces, and update the routes
+   *
+   * Faces that are not part of the graph are ignored.
+   *
+   * @pre CalculateRoutes has been called
+   * @return removed and added routes
+   */
+  RouteUpdateBatch
+  SetLinkState(const Face& face1, const Face& face2, bool isUp);
+
+  size_t
+  GetNVertices() const
+  {
+    return m_vertexNode.size();
+  }
+
+  size_t
+  GetNEdges() const
+  {
+    return m_edgeTarget.size();
+  }
+
+private:
+  typedef uint32_t Vertex;
+  typedef uint32_t Edge;
+  typedef uint16_t Distance;
+
+  /**
+   * @brief a route of one source: prefix index, first edge of the path, path metric
+   */
+  struct Route
+  {
+    uint32_t prefix;
+    Edge edge;
+    Distance metric;
+  };
+
+  struct Scratch;
+
+  void
+  TakeSnapshot();
+
+  /**
+   * @brief run Dijkstra from source vertex @p source
+   * @param dist distances of all vertices, filled by the search
+   * @param enabledEdge if not NO_EDGE, the out-edges of the source other than this one
+   *                    are given DISABLED_METRIC
+   */
+  void
+  Search(Vertex source, Edge enabledEdge, Distance* dist, Scratch& scratch) const;
+
+  /**
+   * @brief append the routes to every prefix origin found by the last Search
+   */
+  void
+  CollectRoutes(Vertex source, Edge enabledEdge, const Distance* dist, const Scratch& scratch,
+                std::vector<Route>& routes) const;
+
+  /**
+   * @brief compute the routes of sources m_sources[i] for each i in @p slots, in parallel
+   */
+  void
+  ComputeSources(const std::vector<size_t>& slots);
+
+  void
+  AppendUpdates(Vertex source, const std::vector<Route>& routes, bool isRemoval,
+                RouteUpdateBatch& batch) const;
+
+  template<typename F>
+  void
+  ParallelFor(size_t nTasks, const F& f) const;
+
+public:
+  static const Distance INF;
+  static const Distance DISABLED_METRIC;
+  static const Edge NO_EDGE;
+
+private:
+  size_t m_nThreads;
+
+  // vertices: nodes and multi-access channels
+  std::vector<Ptr<Node>> m_vertexNode; ///< null for a channel
+  std::vector<uint32_t> m_prefixBegin; ///< vertex v originates m_prefixIds[m_prefixBegin[v]..[v + 1])
+  std::vector<uint32_t> m_prefixIds; ///< index in m_prefixes
+  std::vector<shared_ptr<Name>> m_prefixes;
+
+  // edges, grouped by source vertex
+  std::vector<uint32_t> m_edgeBegin; ///< out-edges of vertex v are [m_edgeBegin[v], [v + 1])
+  std::vector<Vertex> m_edgeTarget;
+  std::vector<Distance> m_edgeMetric;
+  std::vector<uint8_t> m_isEdgeUp;
+  std::vector<shared_ptr<Face>> m_edgeFace; ///< null for an edge out of a channel
+  std::unordered_map<const Face*, Edge> m_faceEdge;
+
+  // results of CalculateRoutes
+  std::vector<Vertex> m_sources;
+  std::vector<Distance> m_dist; ///< distances from m_sources[i] start at m_dist[i * V]
+  std::vector<std::vector<Route>> m_routes; ///< sorted by prefix and edge
+};
+
+} // namespace ndn
+} // namespace ns3
+
+/// @endcond
+
+#endif // NDN_GLOBAL_ROUTING_ENGINE_H
@@ -96,6 +96,10 @@ public:
 
   /**
    * @brief Calculate for every node shortest path trees and install routes to all prefix origins
+   *
+   * The shortest paths are calculated on a snapshot of the topology and of face metrics, with
+   * one Dijkstra search per node, spread over SetRouteCalculationThreads threads. Among
+   * equal-cost paths, the one chosen is the same as with boost::dijkstra_shortest_paths.
    */
   static void
   CalculateRoutes();
@@ -103,7 +107,9 @@ public:
   /**
    * @brief Calculate all possible next-hop independent alternative routes
    *
-   * Refer to the implementation for more details.
+   * For each face of each node, the shortest paths are calculated with the other faces of the
+   * node disabled, and a route is installed for every prefix that can be reached through the
+   * face.
    *
    * Note that this method is highly experimental and should be used with caution (very time
    *consuming).
@@ -111,6 +117,34 @@ public:
   static void
   CalculateAllPossibleRoutes();
 
+  /**
+   * @brief Set the number of threads used to calculate routes
+   * @param nThreads number of threads, 0 (default) for one per hardware thread
+   */
+  static void
+  SetRouteCalculationThreads(size_t nThreads);
+
+  /**
+   * @brief Enable or disable route updates when LinkControlHelper fails or restores a link
+   *
+   * When enabled, CalculateRoutes keeps the shortest paths it has calculated. A link failed
+   * or restored afterwards by LinkControlHelper causes the shortest paths of the nodes that
+   * may be affected to be recalculated, and their routes installed by CalculateRoutes to be
+   * updated. The shortest paths are released when the simulator is destroyed. Disabled by
+   * default.
+   */
+  static void
+  EnableIncrementalUpdates(bool isEnabled = true);
+
+  /**
+   * @brief Update routes after the link between two faces has failed or been restored
+   *
+   * This is called by LinkControlHelper, and has no effect unless incremental updates are
+   * enabled and CalculateRoutes has been called.
+   */
+  static void
+  NotifyLinkStateChange(const Face& face1, const Face& face2, bool isUp);
+
 private:
   void
   Install(Ptr<Channel> channel);
@@ -43,6 +43,9 @@ public:
    *
    * Note that only PointToPointChannels are supported by this helper method
    *
+   * If GlobalRoutingHelper::EnableIncrementalUpdates is in effect, routes calculated by
+   * GlobalRoutingHelper::CalculateRoutes are updated to avoid the link.
+   *
    * @param node1 one node
    * @param node2 another node
    */
@@ -73,6 +76,9 @@ public:
    *
    * Note that only PointToPointChannels are supported by this helper method
    *
+   * If GlobalRoutingHelper::EnableIncrementalUpdates is in effect, routes calculated by
+   * GlobalRoutingHelper::CalculateRoutes are updated to use the link again.
+   *
    * @param node1 one node
    * @param node2 another node
    */
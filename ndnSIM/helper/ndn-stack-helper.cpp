@@ -50,6 +50,7 @@ StackHelper::StackHelper()
   , m_isForwarderStatusManagerDisabled(false)
   , m_isStrategyChoiceManagerDisabled(false)
   , m_needSetDefaultRoutes(false)
+  , m_isDmifUnicastEnabled(false)
   , m_maxCsSize(100)
 {
   setCustomNdnCxxClocks();
@@ -93,6 +94,13 @@ StackHelper::SetDefaultRoutes(bool needSet)
   m_needSetDefaultRoutes = needSet;
 }
 
+void
+StackHelper::SetDmifUnicast(bool isEnabled)
+{
+  NS_LOG_FUNCTION(this << isEnabled);
+  m_isDmifUnicastEnabled = isEnabled;
+}
+
 void
 StackHelper::SetStackAttributes(const std::string& attr1, const std::string& value1,
                                 const std::string& attr2, const std::string& value2,
@@ -274,6 +282,7 @@ StackHelper::DefaultNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn,
   ::nfd::face::GenericLinkService::Options opts;
   opts.allowFragmentation = true;
   opts.allowReassembly = true;
+  opts.allowDmifUnicast = m_isDmifUnicastEnabled;
 
   auto linkService = make_unique<::nfd::face::GenericLinkService>(opts);
 
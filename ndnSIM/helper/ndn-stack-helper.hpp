@@ -190,6 +190,17 @@ public:
   void
   SetDefaultRoutes(bool needSet);
 
+  /**
+   * \brief Set whether Directive-mode DMIF Interests are sent as unicast frames on
+   *        broadcast-capable (e.g., Wi-Fi) devices (disabled by default)
+   *
+   * When disabled, every packet goes to the broadcast address and the neighbors that are
+   * not named by the Interest's ForwarderId drop it after decoding. Enabling it changes which
+   * nodes receive Directive-mode Interests, and hence the results of existing scenarios.
+   */
+  void
+  SetDmifUnicast(bool isEnabled);
+
   static KeyChain&
   getKeyChain();
 
@@ -272,6 +283,7 @@ private:
   ObjectFactory m_contentStoreFactory;
 
   bool m_needSetDefaultRoutes;
+  bool m_isDmifUnicastEnabled;
   size_t m_maxCsSize;
 
   typedef std::function<std::unique_ptr<nfd::cs::Policy>()> PolicyCreationCallback;
@@ -0,0 +1,68 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "bf-controller.hpp"
+
+#include "../src/ndnSIM/LogManager.cpp"
+
+namespace ns3 {
+namespace ndn {
+
+void
+BFController::startInterestTimer()
+{
+  timerInterest.StartTimer(BFTimer::InterestTimer);
+  m_interestWindow = timerInterest.GetWindow();
+}
+
+void
+BFController::startDataTimer()
+{
+  timerData.StartTimer(BFTimer::DataTimer);
+  m_dataWindow = timerData.GetWindow();
+}
+
+void
+BFController::checkInterest(const std::string& interests, uint32_t nonce)
+{
+  LogManager::AddLogWithNodeId("bf-controller.cpp->checkInterest.interests", interests);
+
+  if (interests.empty()) {
+    m_shouldFloodInterest = false;
+    return;
+  }
+
+  m_shouldFloodInterest = m_deferredInterests.insert({interests, nonce}, m_interestWindow);
+}
+
+void
+BFController::checkData(const std::string& data, uint32_t nonce)
+{
+  LogManager::AddLogWithNodeId("bf-controller.cpp->checkData.data", data);
+
+  if (data.empty()) {
+    m_shouldFloodData = false;
+    return;
+  }
+
+  m_shouldFloodData = m_deferredData.insert({data, nonce}, m_dataWindow);
+}
+
+} // namespace ndn
+} // namespace ns3
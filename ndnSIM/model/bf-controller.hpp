@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_BF_CONTROLLER_HPP
+#define NDNSIM_BF_CONTROLLER_HPP
+
+#include "bf-dedup-table.hpp"
+#include "bf-timer.hpp"
+
+#include <string>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Decides whether deferred Interests and Data are flooded
+ *
+ * A packet seen again within the deferral window drawn by its timer is a
+ * duplicate and is not flooded.
+ */
+class BFController {
+public:
+  // draws the deferral window applied to Interests checked from now on
+  void
+  startInterestTimer();
+
+  // draws the deferral window applied to Data checked from now on
+  void
+  startDataTimer();
+
+  // an Interest seen again within its deferral window is not flooded
+  void
+  checkInterest(const std::string& interests, uint32_t nonce = 0);
+
+  // a Data seen again within its deferral window is not flooded
+  void
+  checkData(const std::string& data, uint32_t nonce = 0);
+
+  void
+  clearInterests()
+  {
+    m_deferredInterests.clear();
+  }
+
+  void
+  clearData()
+  {
+    m_deferredData.clear();
+  }
+
+  void
+  addInterest(const std::string& interests, uint32_t nonce = 0)
+  {
+    m_deferredInterests.insert({interests, nonce}, m_interestWindow);
+  }
+
+  void
+  addData(const std::string& data, uint32_t nonce = 0)
+  {
+    m_deferredData.insert({data, nonce}, m_dataWindow);
+  }
+
+  bool
+  existsInterest(const std::string& interests, uint32_t nonce = 0) const
+  {
+    return m_deferredInterests.contains({interests, nonce});
+  }
+
+  bool
+  existsData(const std::string& data, uint32_t nonce = 0) const
+  {
+    return m_deferredData.contains({data, nonce});
+  }
+
+  bool
+  shouldFloodInterest() const
+  {
+    return m_shouldFloodInterest;
+  }
+
+  bool
+  shouldFloodData() const
+  {
+    return m_shouldFloodData;
+  }
+
+public:
+  BFDedupTable m_deferredInterests;
+  BFDedupTable m_deferredData;
+  bool m_shouldFloodInterest = true;
+  bool m_shouldFloodData = true;
+  BFTimer timerInterest{0};
+  BFTimer timerData{1};
+  Time m_interestWindow;
+  Time m_dataWindow;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_BF_CONTROLLER_HPP
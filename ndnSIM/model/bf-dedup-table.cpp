@@ -0,0 +1,145 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "bf-dedup-table.hpp"
+
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace ns3 {
+namespace ndn {
+
+size_t
+BFDedupTable::KeyHash::operator()(const Key& key) const
+{
+  return std::hash<std::string>()(key.name) ^ (static_cast<size_t>(key.nonce) * 0x9e3779b97f4a7c15ULL);
+}
+
+BFDedupTable::BFDedupTable(size_t capacity)
+  : m_capacity(std::max<size_t>(capacity, 1))
+{
+}
+
+BFDedupTable::~BFDedupTable()
+{
+  Simulator::Cancel(m_sweepEvent);
+}
+
+bool
+BFDedupTable::contains(const Key& key) const
+{
+  auto it = m_index.find(key);
+  return it != m_index.end() && it->second->expiry > Simulator::Now();
+}
+
+bool
+BFDedupTable::insert(const Key& key, Time lifetime)
+{
+  Time now = Simulator::Now();
+  Time expiry = now + lifetime;
+
+  auto it = m_index.find(key);
+  if (it != m_index.end()) {
+    bool isFresh = it->second->expiry <= now;
+    it->second->expiry = expiry;
+    m_lru.splice(m_lru.begin(), m_lru, it->second);
+    pushExpiry(key, expiry);
+    return isFresh;
+  }
+
+  if (m_index.size() >= m_capacity) {
+    m_index.erase(m_lru.back().key);
+    m_lru.pop_back();
+  }
+
+  m_lru.push_front(Entry{key, expiry});
+  m_index.emplace(key, m_lru.begin());
+  pushExpiry(key, expiry);
+  return true;
+}
+
+void
+BFDedupTable::clear()
+{
+  Simulator::Cancel(m_sweepEvent);
+  m_index.clear();
+  m_lru.clear();
+  m_expiries.clear();
+}
+
+void
+BFDedupTable::pushExpiry(const Key& key, Time expiry)
+{
+  if (m_expiries.size() >= 2 * m_capacity)
+    compactExpiries();
+
+  m_expiries.push_back(Expiry{expiry, key});
+  std::push_heap(m_expiries.begin(), m_expiries.end(), std::greater<Expiry>());
+  scheduleSweep(expiry);
+}
+
+void
+BFDedupTable::compactExpiries()
+{
+  // every live entry has exactly one current heap item; the rest are stale
+  m_expiries.clear();
+  for (const Entry& entry : m_lru) {
+    m_expiries.push_back(Expiry{entry.expiry, entry.key});
+  }
+  std::make_heap(m_expiries.begin(), m_expiries.end(), std::greater<Expiry>());
+}
+
+void
+BFDedupTable::scheduleSweep(Time expiry)
+{
+  if (m_sweepEvent.IsRunning() && expiry >= m_nextSweep)
+    return;
+
+  Simulator::Cancel(m_sweepEvent);
+  m_nextSweep = expiry;
+  m_sweepEvent = Simulator::Schedule(expiry - Simulator::Now(), &BFDedupTable::sweep, this);
+}
+
+void
+BFDedupTable::sweep()
+{
+  Time now = Simulator::Now();
+
+  while (!m_expiries.empty() && m_expiries.front().time <= now) {
+    const Expiry& due = m_expiries.front();
+    // heap items of refreshed or evicted keys are stale and only dropped
+    auto it = m_index.find(due.key);
+    if (it != m_index.end() && it->second->expiry == due.time) {
+      m_lru.erase(it->second);
+      m_index.erase(it);
+    }
+    std::pop_heap(m_expiries.begin(), m_expiries.end(), std::greater<Expiry>());
+    m_expiries.pop_back();
+  }
+
+  if (!m_expiries.empty()) {
+    m_nextSweep = m_expiries.front().time;
+    m_sweepEvent = Simulator::Schedule(m_nextSweep - now, &BFDedupTable::sweep, this);
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,154 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_BF_DEDUP_TABLE_HPP
+#define NDNSIM_BF_DEDUP_TABLE_HPP
+
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Duplicate-suppression table for deferred Interests and Data
+ *
+ * Entries are keyed on (name, nonce) and looked up through a hash index.
+ * Each entry lives for the deferral window it was inserted with, measured in
+ * ns-3 simulated time; expired entries are ignored by lookups and reclaimed by
+ * a single sweep event scheduled at the earliest pending expiry. Expiries are
+ * kept in a min-heap, so a sweep only visits the entries that are due. The
+ * table holds at most `capacity` entries and evicts the least recently seen
+ * one when full.
+ *
+ * Refreshing or evicting an entry leaves its old heap item behind. The heap is
+ * rebuilt from the live entries once stale items outnumber them, so it never
+ * holds more than twice the table capacity.
+ */
+class BFDedupTable {
+public:
+  struct Key {
+    std::string name;
+    uint32_t nonce;
+
+    bool
+    operator==(const Key& other) const
+    {
+      return nonce == other.nonce && name == other.name;
+    }
+  };
+
+  struct KeyHash {
+    size_t
+    operator()(const Key& key) const;
+  };
+
+  explicit BFDedupTable(size_t capacity = 4096);
+
+  // the sweep event holds a pointer to this table
+  BFDedupTable(const BFDedupTable&) = delete;
+  BFDedupTable&
+  operator=(const BFDedupTable&) = delete;
+
+  ~BFDedupTable();
+
+  /** @return true if key was seen within its window
+   */
+  bool
+  contains(const Key& key) const;
+
+  /** @brief records key for lifetime
+   *  @return true if key was not already present (i.e. it is not a duplicate)
+   */
+  bool
+  insert(const Key& key, Time lifetime);
+
+  void
+  clear();
+
+  /** @return number of entries, including expired ones not swept yet
+   */
+  size_t
+  size() const
+  {
+    return m_index.size();
+  }
+
+  size_t
+  capacity() const
+  {
+    return m_capacity;
+  }
+
+  /** @return number of items in the expiry heap, including stale ones
+   */
+  size_t
+  pendingExpiries() const
+  {
+    return m_expiries.size();
+  }
+
+private:
+  struct Entry {
+    Key key;
+    Time expiry;
+  };
+
+  struct Expiry {
+    Time time;
+    Key key;
+
+    bool
+    operator>(const Expiry& other) const
+    {
+      return time > other.time;
+    }
+  };
+
+  void
+  pushExpiry(const Key& key, Time expiry);
+
+  void
+  compactExpiries();
+
+  void
+  scheduleSweep(Time expiry);
+
+  void
+  sweep();
+
+private:
+  size_t m_capacity;
+  std::list<Entry> m_lru; // most recently seen first
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> m_index;
+  std::vector<Expiry> m_expiries; // min-heap on time, may hold stale items
+  EventId m_sweepEvent;
+  Time m_nextSweep;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_BF_DEDUP_TABLE_HPP
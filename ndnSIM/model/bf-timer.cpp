@@ -0,0 +1,126 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "bf-timer.hpp"
+
+#include "ns3/simulator.h"
+
+#include "../src/ndnSIM/LogManager.cpp"
+
+#include <algorithm>
+
+namespace ns3 {
+namespace ndn {
+
+const int BFTimer::DEFAULT_DEFERRED_SLOTS;
+const int BFTimer::DEFAULT_SLOT_MILLISECONDS;
+const int64_t BFTimer::STREAM_BASE;
+
+BFTimer::BFTimer(int64_t streamOffset)
+  : m_rand(CreateObject<UniformRandomVariable>())
+{
+  int nodeId = LogHelper::GetNodeId();
+  if (nodeId >= 0)
+    AssignStreams(STREAM_BASE + 2 * static_cast<int64_t>(nodeId) + streamOffset);
+}
+
+BFTimer::~BFTimer()
+{
+  Simulator::Cancel(m_event);
+}
+
+int64_t
+BFTimer::AssignStreams(int64_t stream)
+{
+  m_rand->SetStream(stream);
+  return 1;
+}
+
+void
+BFTimer::SetDeferral(int deferredSlots, int slotMilliseconds)
+{
+  m_deferredSlots = std::max(deferredSlots, 2);
+  m_slotMilliseconds = slotMilliseconds;
+}
+
+void
+BFTimer::StartTimer(int timerFor)
+{
+  StartTimer(timerFor, nullptr);
+}
+
+void
+BFTimer::StartTimer(int timerFor, const Callback& callback)
+{
+  Simulator::Cancel(m_event);
+  m_waitOver = false;
+  m_callback = callback;
+
+  if (timerFor == InterestTimer)
+    m_waitForMilliseconds = GetIntervalForInterest();
+  else if (timerFor == DataTimer)
+    m_waitForMilliseconds = GetIntervalForData();
+
+  m_event = Simulator::Schedule(GetWindow(), &BFTimer::Expire, this);
+}
+
+void
+BFTimer::Cancel()
+{
+  Simulator::Cancel(m_event);
+  m_waitOver = true;
+  m_callback = nullptr;
+}
+
+int
+BFTimer::GetIntervalForInterest()
+{
+  int temp = (m_deferredSlots + m_rand->GetInteger(0, m_deferredSlots - 1)) * m_slotMilliseconds;
+  LogManager::AddLogWithNodeId("bf-timer.cpp->RandomIntervalForInterest", temp);
+  return temp;
+}
+
+int
+BFTimer::GetIntervalForData()
+{
+  int temp = m_rand->GetInteger(0, m_deferredSlots - 2) * m_slotMilliseconds;
+  LogManager::AddLogWithNodeId("bf-timer.cpp->RandomIntervalForData", temp);
+  return temp;
+}
+
+int
+BFTimer::GetRemainingTime() const
+{
+  if (m_waitOver)
+    return 0;
+  return static_cast<int>(Simulator::GetDelayLeft(m_event).GetMilliSeconds());
+}
+
+void
+BFTimer::Expire()
+{
+  m_waitOver = true;
+  Callback callback;
+  std::swap(callback, m_callback);
+  if (callback)
+    callback();
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_BF_TIMER_HPP
+#define NDNSIM_BF_TIMER_HPP
+
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/random-variable-stream.h"
+
+#include <cstdint>
+#include <functional>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief DMIF deferral timer driven by the ns-3 scheduler
+ *
+ * The window is drawn from a UniformRandomVariable whose stream is derived
+ * from the node id, so runs with the same seed and run number defer exactly
+ * the same way on any machine. Expiry is an ns-3 event in simulated time;
+ * nothing polls the host clock.
+ *
+ * Interest windows last between DeferredSlots and 2 * DeferredSlots - 1 slots,
+ * Data windows between 0 and DeferredSlots - 2 slots.
+ */
+class BFTimer {
+public:
+  typedef std::function<void()> Callback;
+
+  enum {
+    InterestTimer = 1,
+    DataTimer = 2
+  };
+
+  static const int DEFAULT_DEFERRED_SLOTS = 4;
+  static const int DEFAULT_SLOT_MILLISECONDS = 10;
+
+  /** @param streamOffset distinguishes the timers of one node (0 or 1)
+   */
+  explicit BFTimer(int64_t streamOffset = 0);
+
+  // the expiry event holds a pointer to this timer
+  BFTimer(const BFTimer&) = delete;
+  BFTimer&
+  operator=(const BFTimer&) = delete;
+
+  ~BFTimer();
+
+  /** @brief fixes the random stream used to draw deferral windows
+   *  @return number of streams used
+   */
+  int64_t
+  AssignStreams(int64_t stream);
+
+  /** @brief sets the number of slots and the slot length windows are drawn in
+   *  @param deferredSlots at least 2
+   */
+  void
+  SetDeferral(int deferredSlots, int slotMilliseconds);
+
+  void
+  StartTimer(int timerFor);
+
+  /** @brief starts a new deferral window; callback, if any, runs when it elapses
+   */
+  void
+  StartTimer(int timerFor, const Callback& callback);
+
+  void
+  Cancel();
+
+  bool
+  IsWaitOver() const
+  {
+    return m_waitOver;
+  }
+
+  Time
+  GetWindow() const
+  {
+    return MilliSeconds(m_waitForMilliseconds);
+  }
+
+  int
+  GetIntervalForInterest();
+
+  int
+  GetIntervalForData();
+
+  // milliseconds until the current window elapses
+  int
+  GetRemainingTime() const;
+
+private:
+  void
+  Expire();
+
+private:
+  // keeps deferral streams clear of the streams assigned by helpers
+  static const int64_t STREAM_BASE = 1000000;
+
+  Ptr<UniformRandomVariable> m_rand;
+  EventId m_event;
+  Callback m_callback;
+  int m_deferredSlots = DEFAULT_DEFERRED_SLOTS;
+  int m_slotMilliseconds = DEFAULT_SLOT_MILLISECONDS;
+  int m_waitForMilliseconds = 0;
+  bool m_waitOver = true;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_BF_TIMER_HPP
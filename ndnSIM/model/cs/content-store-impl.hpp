@@ -32,6 +32,7 @@
 #include "ns3/string.h"
 
 #include "../../utils/trie/trie-with-policy.hpp"
+#include "../../utils/trie/compact-trie.hpp"
 
 namespace ns3 {
 namespace ndn {
@@ -77,6 +78,8 @@ private:
 /**
  * @ingroup ndn-cs
  * @brief Base implementation of NDN content store
+ *
+ * Entries are indexed by a compact_trie, and Policy decides which of them are kept.
  */
 template<class Policy>
 class ContentStoreImpl
@@ -85,12 +88,12 @@ class ContentStoreImpl
       trie_with_policy<Name,
                        ndnSIM::smart_pointer_payload_traits<EntryImpl<ContentStoreImpl<Policy>>,
                                                             Entry>,
-                       Policy> {
+                       Policy, ndnSIM::compact_trie> {
 public:
   typedef ndnSIM::
     trie_with_policy<Name, ndnSIM::smart_pointer_payload_traits<EntryImpl<ContentStoreImpl<Policy>>,
                                                                 Entry>,
-                     Policy> super;
+                     Policy, ndnSIM::compact_trie> super;
 
   typedef EntryImpl<ContentStoreImpl<Policy>> entry;
 
@@ -102,7 +105,7 @@ public:
 
   // from ContentStore
 
-  virtual inline shared_ptr<Data>
+  virtual inline shared_ptr<const Data>
   Lookup(shared_ptr<const Interest> interest);
 
   virtual inline bool
@@ -202,7 +205,7 @@ private:
 };
 
 template<class Policy>
-shared_ptr<Data>
+shared_ptr<const Data>
 ContentStoreImpl<Policy>::Lookup(shared_ptr<const Interest> interest)
 {
   NS_LOG_FUNCTION(this << interest->getName());
@@ -218,9 +221,7 @@ ContentStoreImpl<Policy>::Lookup(shared_ptr<const Interest> interest)
 
   if (node != this->end()) {
     this->m_cacheHitsTrace(interest, node->payload()->GetData());
-
-    shared_ptr<Data> copy = make_shared<Data>(*node->payload()->GetData());
-    return copy;
+    return node->payload()->GetData();
   }
   else {
     this->m_cacheMissesTrace(interest);
@@ -119,12 +119,22 @@ public:
    *
    * If an entry is found, it is promoted to the top of most recent
    * used entries index, \see m_contentStore
+   *
+   * \returns the Data stored in the entry (not a copy), or nullptr on a cache miss
+   *
+   * The returned Data is shared by the store, by every hit and by deliveries still in
+   * flight, so it must not be modified, including its tags.  The forwarder passes the
+   * IncomingFaceId and HopCount of a hit to the face beside it (nfd::face::DataDelivery),
+   * so a hit does not copy it.
    */
-  virtual shared_ptr<Data>
+  virtual shared_ptr<const Data>
   Lookup(shared_ptr<const Interest> interest) = 0;
 
   /**
    * \brief Add a new content to the content store.
+   *
+   * \p data is stored without copying, and must not be modified afterwards (\see Lookup).
+   *
    * \returns true if an existing entry was updated, false otherwise
    */
   virtual bool
@@ -27,6 +27,8 @@
 
 #include "apps/ndn-app.hpp"
 
+#include <ndn-cxx/lp/tags.hpp>
+
 NS_LOG_COMPONENT_DEFINE("ndn.AppLinkService");
 
 namespace ns3 {
@@ -56,12 +58,30 @@ AppLinkService::doSendInterest(const Interest& interest)
 }
 
 void
-AppLinkService::doSendData(const Data& data)
+AppLinkService::doSendData(const Data& data, const nfd::face::DataDelivery& delivery)
 {
   NS_LOG_FUNCTION(this << &data);
 
+  // Apps read the hop count of a delivery from HopCountTag.  data may be the instance held by
+  // the CS, which carries no HopCountTag, so a delivery that crossed a link gets a copy with the
+  // tag; a CS hit on this node has no hop count and gets the cached instance itself.
+  shared_ptr<const Data> appData = data.shared_from_this();
+  auto hopCountTag = data.getTag<lp::HopCountTag>();
+  bool needsRetag = delivery.hopCount ? hopCountTag == nullptr || hopCountTag->get() != *delivery.hopCount
+                                      : hopCountTag != nullptr;
+  if (needsRetag) {
+    auto copy = make_shared<Data>(data);
+    if (delivery.hopCount) {
+      copy->setTag(make_shared<lp::HopCountTag>(*delivery.hopCount));
+    }
+    else {
+      copy->removeTag<lp::HopCountTag>();
+    }
+    appData = copy;
+  }
+
   // to decouple callbacks
-  Simulator::ScheduleNow(&App::OnData, m_app, data.shared_from_this());
+  Simulator::ScheduleNow(&App::OnData, m_app, appData);
 }
 
 void
@@ -63,7 +63,7 @@ private:
   doSendInterest(const Interest& interest) override;
 
   virtual void
-  doSendData(const Data& data) override;
+  doSendData(const Data& data, const nfd::face::DataDelivery& delivery) override;
 
   virtual void
   doSendNack(const lp::Nack& nack) override;
@@ -19,16 +19,13 @@
 
 #include "ndn-block-header.hpp"
 
-#include <iosfwd>
-#include <boost/iostreams/concepts.hpp>
-#include <boost/iostreams/stream.hpp>
+#include <algorithm>
 
 #include <ndn-cxx/encoding/tlv.hpp>
 #include <ndn-cxx/interest.hpp>
 #include <ndn-cxx/data.hpp>
 #include <ndn-cxx/lp/packet.hpp>
 
-namespace io = boost::iostreams;
 namespace nfdFace = nfd::face;
 
 namespace ns3 {
@@ -73,37 +70,35 @@ BlockHeader::Serialize(ns3::Buffer::Iterator start) const
   start.Write(m_block.wire(), m_block.size());
 }
 
-class Ns3BufferIteratorSource : public io::source {
-public:
-  Ns3BufferIteratorSource(ns3::Buffer::Iterator& is)
-    : m_is(is)
-  {
-  }
+uint32_t
+BlockHeader::Deserialize(ns3::Buffer::Iterator start)
+{
+  namespace tlv = ::ndn::tlv;
 
-  std::streamsize
-  read(char* buf, std::streamsize nMaxRead)
-  {
-    std::streamsize i = 0;
-    for (; i < nMaxRead && !m_is.IsEnd(); ++i) {
-      buf[i] = m_is.ReadU8();
-    }
-    if (i == 0) {
-      return -1;
-    }
-    else {
-      return i;
-    }
+  // peek TLV-TYPE and TLV-LENGTH (at most 9 octets each) to learn the size of the element
+  uint8_t tlvHeader[18];
+  uint32_t remaining = start.GetRemainingSize();
+  uint32_t peekSize = std::min<uint32_t>(sizeof(tlvHeader), remaining);
+  ns3::Buffer::Iterator peek = start;
+  peek.Read(tlvHeader, peekSize);
+
+  const uint8_t* pos = tlvHeader;
+  const uint8_t* end = tlvHeader + peekSize;
+  uint32_t type = 0;
+  uint64_t length = 0;
+  if (!tlv::readType(pos, end, type) || !tlv::readVarNumber(pos, end, length)) {
+    BOOST_THROW_EXCEPTION(tlv::Error("Insufficient data during TLV parsing"));
   }
 
-private:
-  ns3::Buffer::Iterator& m_is;
-};
+  size_t headerSize = pos - tlvHeader;
+  if (length > remaining - headerSize) {
+    BOOST_THROW_EXCEPTION(tlv::Error("Not enough data in the buffer to fully parse TLV"));
+  }
 
-uint32_t
-BlockHeader::Deserialize(ns3::Buffer::Iterator start)
-{
-  io::stream<Ns3BufferIteratorSource> is(start);
-  m_block = ::ndn::Block::fromStream(is);
+  // copy the whole element with a single bulk read
+  auto buffer = make_shared<::ndn::Buffer>(headerSize + length);
+  start.Read(buffer->data(), buffer->size());
+  m_block = Block(buffer);
   return m_block.size();
 }
 
@@ -86,9 +86,14 @@ NetDeviceTransport::doSend(Packet&& packet)
   Ptr<ns3::Packet> ns3Packet = Create<ns3::Packet>();
   ns3Packet->AddHeader(header);
 
+  // packets addressed to one neighbor (DMIF Directive mode) go out as unicast frames
+  Address destination = m_netDevice->GetBroadcast();
+  if (packet.remoteEndpoint != 0 && packet.remoteEndpoint <= m_endpointAddresses.size()) {
+    destination = m_endpointAddresses[packet.remoteEndpoint - 1];
+  }
+
   // send the NS3 packet
-  m_netDevice->Send(ns3Packet, m_netDevice->GetBroadcast(),
-                    L3Protocol::ETHERNET_FRAME_TYPE);
+  m_netDevice->Send(ns3Packet, destination, L3Protocol::ETHERNET_FRAME_TYPE);
 }
 
 // callback
@@ -101,17 +106,35 @@ NetDeviceTransport::receiveFromNetDevice(Ptr<NetDevice> device,
 {
   NS_LOG_FUNCTION(device << p << protocol << from << to << packetType);
 
-  // Convert NS3 packet to NFD packet
-  Ptr<ns3::Packet> packet = p->Copy();
+  // unicast frames overheard in promiscuous mode are addressed to another node
+  if (packetType == NetDevice::PACKET_OTHERHOST) {
+    return;
+  }
 
+  // Convert NS3 packet to NFD packet; the header is only peeked, so p need not be copied
   BlockHeader header;
-  packet->RemoveHeader(header);
+  p->PeekHeader(header);
 
   auto nfdPacket = Packet(std::move(header.getBlock()));
+  nfdPacket.remoteEndpoint = getEndpointId(from);
 
   this->receive(std::move(nfdPacket));
 }
 
+nfd::face::Transport::EndpointId
+NetDeviceTransport::getEndpointId(const Address& address)
+{
+  auto it = m_endpointIds.find(address);
+  if (it != m_endpointIds.end()) {
+    return it->second;
+  }
+
+  m_endpointAddresses.push_back(address);
+  EndpointId id = m_endpointAddresses.size();
+  m_endpointIds.emplace(address, id);
+  return id;
+}
+
 Ptr<NetDevice>
 NetDeviceTransport::GetNetDevice() const
 {
@@ -32,6 +32,8 @@
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/channel.h"
 
+#include <map>
+
 namespace ns3 {
 namespace ndn {
 
@@ -75,8 +77,19 @@ private:
                        const Address& from, const Address& to,
                        NetDevice::PacketType packetType);
 
+  /**
+   * \brief EndpointId of the neighbor with link-layer address \p address
+   *
+   * Ids are assigned on first contact, starting from 1; 0 stands for the broadcast address.
+   */
+  EndpointId
+  getEndpointId(const Address& address);
+
   Ptr<NetDevice> m_netDevice; ///< \brief Smart pointer to NetDevice
   Ptr<Node> m_node;
+
+  std::map<Address, EndpointId> m_endpointIds;
+  std::vector<Address> m_endpointAddresses; ///< \brief address of EndpointId i + 1
 };
 
 } // namespace ndn
@@ -20,6 +20,7 @@
  */
 
 #include "data.hpp"
+#include "dmif-header.hpp"
 #include "encoding/block-helpers.hpp"
 #include "util/sha256.hpp"
 #include "../src/ndnSIM/LogManager.cpp"
@@ -95,23 +96,36 @@ size_t Data::wireEncode(EncodingImpl<TAG>& encoder, bool wantUnsignedPortionOnly
 	// Name
 	totalLength += getName().wireEncode(encoder);
 
-	// Residual Energy
-	uint32_t residualEnergy = this->getResidualEnergy();
-	totalLength += encoder.prependByteArray(
-			reinterpret_cast<uint8_t*>(&residualEnergy),
-			sizeof(residualEnergy));
-	totalLength += encoder.prependVarNumber(sizeof(residualEnergy));
-	totalLength += encoder.prependVarNumber(tlv::ResidualEnergy);
-
-// Initial Hop
-	uint32_t initialHop = this->getInitialHop();
-	totalLength += encoder.prependByteArray(
-			reinterpret_cast<uint8_t*>(&initialHop), sizeof(initialHop));
-	totalLength += encoder.prependVarNumber(sizeof(initialHop));
-	totalLength += encoder.prependVarNumber(tlv::InitialHop);
-
-// Ids List
-	totalLength += wireEncodeIdsList(encoder);
+	// DMIF fields
+	if (dmif::getWireFormat() == dmif::WireFormat::COMPACT) {
+		totalLength += makeDmifHeader().wireEncode(encoder);
+	}
+	else {
+		// Residual Energy
+		uint32_t residualEnergy = this->getResidualEnergy();
+		totalLength += encoder.prependByteArray(
+				reinterpret_cast<uint8_t*>(&residualEnergy),
+				sizeof(residualEnergy));
+		totalLength += encoder.prependVarNumber(sizeof(residualEnergy));
+		totalLength += encoder.prependVarNumber(tlv::ResidualEnergy);
+
+		// Initial Hop
+		uint32_t initialHop = this->getInitialHop();
+		totalLength += encoder.prependByteArray(
+				reinterpret_cast<uint8_t*>(&initialHop), sizeof(initialHop));
+		totalLength += encoder.prependVarNumber(sizeof(initialHop));
+		totalLength += encoder.prependVarNumber(tlv::InitialHop);
+
+		// Forwarder Id
+		uint32_t forwarderId = this->getForwarderId();
+		totalLength += encoder.prependByteArray(
+				reinterpret_cast<uint8_t*>(&forwarderId), sizeof(forwarderId));
+		totalLength += encoder.prependVarNumber(sizeof(forwarderId));
+		totalLength += encoder.prependVarNumber(tlv::ForwarderId);
+
+		// Ids List
+		totalLength += wireEncodeIdsList(encoder);
+	}
 
 	if (!wantUnsignedPortionOnly) {
 		totalLength += encoder.prependVarNumber(totalLength);
@@ -144,10 +158,12 @@ Data::wireEncode(EncodingBuffer& encoder, const Block& signatureValue) const
 const Block&
 Data::wireEncode() const
 {
-	/* Commented because we want to be wireEncoded eveytime
-  if (m_wire.hasWire())
-    return m_wire;
-	 */
+  if (m_wire.hasWire()) {
+    if (!m_hasDirtyDmifFields || rewriteDmifFields()) {
+      return m_wire;
+    }
+  }
+
   EncodingEstimator estimator;
   size_t estimatedSize = wireEncode(estimator);
 
@@ -160,98 +176,128 @@ Data::wireEncode() const
 
 std::vector<int> Data::wireDecodeIdsList(const Block& wire) {
 //	LogManager::AddLogWithNodeId("data.cpp->wireDecodeIdsList.start");
+	// wireEncodeIdsList writes each id as TLV-LENGTH and a 4-octet value, without TLV-TYPE,
+	// so the value cannot be parsed into sub-elements; the ids are prepended, last id first
 	std::vector<int> v;
-	const Block& content = wire; //m_wire.find(tlv::IdsList);
-	content.parse();
-	auto element = content.elements_begin();
-	if (content.elements_end() == element) {
-		return v;
-	}
-
-	for (; element != content.elements_end(); ++element) {
-		element->parse();
+	Buffer::const_iterator begin = wire.value_begin();
+	Buffer::const_iterator end = wire.value_end();
+	while (begin != end) {
+		uint64_t length = tlv::readVarNumber(begin, end);
 		uint32_t temp = 0;
-		std::memcpy(&temp, element->value(), sizeof(temp));
+		if (length != sizeof(temp) || static_cast<uint64_t>(end - begin) < length) {
+			BOOST_THROW_EXCEPTION(Error("Ids List element is malformed"));
+		}
+		std::copy(begin, begin + length, reinterpret_cast<uint8_t*>(&temp));
+		begin += length;
 		v.push_back(temp);
 	}
+	std::reverse(v.begin(), v.end());
 
 //	LogManager::AddLogWithNodeId("data.cpp->wireDecodeIdsList.completed");
 	return v;
 }
 
+bool
+Data::rewriteDmifFields() const
+{
+  // m_wire's buffer may be shared with copies of this Data (e.g. in the Content Store), so the
+  // fields are rewritten in a private copy; Name, Content, etc. keep referring to the old buffer
+  auto buffer = make_shared<Buffer>(m_wire.wire(), m_wire.size());
+  Block wire(buffer);
+  wire.parse();
+
+  if (!dmif::rewriteHeader(*buffer, wire, makeDmifHeader()) &&
+      !(dmif::rewriteLegacyField(*buffer, wire, tlv::ResidualEnergy, m_residualEnergy) &&
+        dmif::rewriteLegacyField(*buffer, wire, tlv::InitialHop, m_initialHop) &&
+        dmif::rewriteLegacyField(*buffer, wire, tlv::ForwarderId, m_forwarderId))) {
+    return false;
+  }
+
+  m_wire = wire;
+  m_fullName.clear();
+  m_hasDirtyDmifFields = false;
+  return true;
+}
+
 void
 Data::wireDecode(const Block& wire) {
 //	LogManager::AddLogWithNodeId("data.cpp->wireDecode.start");
 	m_fullName.clear();
 	m_wire = wire;
 	m_wire.parse();
-
-	// Name
-	m_name.wireDecode(m_wire.get(tlv::Name));
-
-	// MetaInfo
-	m_metaInfo.wireDecode(m_wire.get(tlv::MetaInfo));
-
-	// Content
-	m_content = m_wire.get(tlv::Content);
-
-	// SignatureInfo
-	m_signature.setInfo(m_wire.get(tlv::SignatureInfo));
-
-	// SignatureValue
-	Block::element_const_iterator val = m_wire.find(tlv::SignatureValue);
-	if (val != m_wire.elements_end()) {
-		m_signature.setValue(*val);
-	}
-
-//	LogManager::AddLogWithNodeId("data.cpp->wireDecode.1");
-	// Residual Energy
-	try{
-		val = m_wire.find(tlv::ResidualEnergy);
-		if (val == m_wire.elements_end()) {
-			BOOST_THROW_EXCEPTION(Error("ResidualEnergy element is missing"));
+	m_hasDirtyDmifFields = false;
+
+	// a single pass over the elements; DMIF fields that are absent, as in Data from non-DMIF
+	// producers, are zero
+	const Block* name = nullptr;
+	const Block* metaInfo = nullptr;
+	const Block* content = nullptr;
+	const Block* signatureInfo = nullptr;
+	const Block* signatureValue = nullptr;
+	const Block* dmifHeader = nullptr;
+	m_residualEnergy = 0;
+	m_initialHop = 0;
+	m_forwarderId = 0;
+	m_idsList.clear();
+	bool isLegacyFieldMalformed = false;
+
+	for (const Block& element : m_wire.elements()) {
+		switch (element.type()) {
+			case tlv::Name:
+				name = &element;
+				break;
+			case tlv::MetaInfo:
+				metaInfo = &element;
+				break;
+			case tlv::Content:
+				content = &element;
+				break;
+			case tlv::SignatureInfo:
+				signatureInfo = &element;
+				break;
+			case tlv::SignatureValue:
+				signatureValue = &element;
+				break;
+			case tlv::DmifHeader:
+				dmifHeader = &element;
+				break;
+			case tlv::ResidualEnergy:
+				isLegacyFieldMalformed |= !dmif::readLegacyField(element, m_residualEnergy);
+				break;
+			case tlv::InitialHop:
+				isLegacyFieldMalformed |= !dmif::readLegacyField(element, m_initialHop);
+				break;
+			case tlv::ForwarderId:
+				isLegacyFieldMalformed |= !dmif::readLegacyField(element, m_forwarderId);
+				break;
+			case tlv::IdsList:
+				m_idsList = wireDecodeIdsList(element);
+				break;
+			default:
+				break;
 		}
-		uint32_t residualEnergy = 0;
-		if (val->value_size() != sizeof(residualEnergy)) {
-			BOOST_THROW_EXCEPTION(Error("ResidualEnergy element is malformed"));
-		}
-		std::memcpy(&residualEnergy, val->value(), sizeof(residualEnergy));
-		m_residualEnergy = residualEnergy;
-	}
-	catch(std::exception& ex){
-//		LogManager::AddLogWithNodeId("data.cpp->ResidualEnergy.exception", ex.what());
 	}
 
-//	LogManager::AddLogWithNodeId("data.cpp->wireDecode.2");
-	// Initial Hop
-	try{
-		val = m_wire.find(tlv::InitialHop);
-		if (val == m_wire.elements_end()) {
-			BOOST_THROW_EXCEPTION(Error("ResidualEnergy element is missing"));
-		}
-		uint32_t initialHop = 0;
-		if (val->value_size() != sizeof(initialHop)) {
-			BOOST_THROW_EXCEPTION(Error("InitialHop element is malformed"));
-		}
-		std::memcpy(&initialHop, val->value(), sizeof(initialHop));
-		m_initialHop = initialHop;
-	}
-	catch(std::exception& ex){
-//		LogManager::AddLogWithNodeId("data.cpp->InitialHop.exception", ex.what());
+	if (name == nullptr || metaInfo == nullptr || content == nullptr || signatureInfo == nullptr ||
+	    signatureValue == nullptr) {
+		BOOST_THROW_EXCEPTION(Error("Name, MetaInfo, Content, SignatureInfo or SignatureValue element is missing"));
 	}
-
-//	LogManager::AddLogWithNodeId("data.cpp->wireDecode.3");
-	// Ids List
-	try{
-		val = m_wire.find(tlv::IdsList);
-		if (val == m_wire.elements_end()) {
-			BOOST_THROW_EXCEPTION(Error("Ids List element is missing"));
-		}
-		std::vector<int> v = wireDecodeIdsList(*val);
-		m_idsList = v;
+	m_name.wireDecode(*name);
+	m_metaInfo.wireDecode(*metaInfo);
+	m_content = *content;
+	m_signature.setInfo(*signatureInfo);
+	m_signature.setValue(*signatureValue);
+
+	// DMIF fields in the compact wire format take precedence over the legacy layout
+	if (dmifHeader != nullptr) {
+		dmif::Header header(*dmifHeader);
+		m_residualEnergy = header.residualEnergy;
+		m_initialHop = header.initialHop;
+		m_forwarderId = header.forwarderId;
+		m_idsList = std::move(header.idsList);
 	}
-	catch(std::exception& ex){
-//		LogManager::AddLogWithNodeId("data.cpp->IdsList.exception", ex.what());
+	else if (isLegacyFieldMalformed) {
+		BOOST_THROW_EXCEPTION(Error("ResidualEnergy, InitialHop or ForwarderId element is malformed"));
 	}
 
 //	LogManager::AddLogWithNodeId("data.cpp->wireDecode.completed");
@@ -264,8 +310,9 @@ Data::getFullName() const
     if (!m_wire.hasWire()) {
       BOOST_THROW_EXCEPTION(Error("Cannot compute full name because Data has no wire encoding (not signed)"));
     }
+    const Block& wire = wireEncode(); // applies pending DMIF field updates
     m_fullName = m_name;
-    m_fullName.appendImplicitSha256Digest(util::Sha256::computeDigest(m_wire.wire(), m_wire.size()));
+    m_fullName.appendImplicitSha256Digest(util::Sha256::computeDigest(wire.wire(), wire.size()));
   }
 
   return m_fullName;
@@ -375,10 +422,23 @@ Data::setFinalBlockId(const name::Component& finalBlockId)
 }
 
 /***** DMIF ******/
+dmif::Header
+Data::makeDmifHeader() const
+{
+  dmif::Header header;
+  header.residualEnergy = m_residualEnergy;
+  header.initialHop = m_initialHop;
+  header.forwarderId = m_forwarderId;
+  header.idsList = m_idsList;
+  return header;
+}
+
 Data&
 Data::setResidualEnergy(const uint32_t val){
-	resetWire();
-	m_residualEnergy = val;
+	if (val != m_residualEnergy) {
+		m_residualEnergy = val;
+		m_hasDirtyDmifFields = true;
+	}
 	return *this;
 }
 
@@ -389,8 +449,10 @@ Data::getResidualEnergy() const {
 
 Data&
 Data::setInitialHop(const uint32_t val){
-	resetWire();
-	m_initialHop = val;
+	if (val != m_initialHop) {
+		m_initialHop = val;
+		m_hasDirtyDmifFields = true;
+	}
 	return *this;
 }
 
@@ -401,8 +463,10 @@ Data::getInitialHop() const {
 
 Data&
 Data::setForwarderId(const uint32_t val){
-	resetWire();
-	m_forwarderId = val;
+	if (val != m_forwarderId) {
+		m_forwarderId = val;
+		m_hasDirtyDmifFields = true;
+	}
 	return *this;
 }
 
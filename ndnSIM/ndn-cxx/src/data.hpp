@@ -30,6 +30,10 @@
 
 namespace ndn {
 
+namespace dmif {
+class Header;
+} // namespace dmif
+
 /** @brief Represents a Data packet
  */
 class Data : public PacketBase, public enable_shared_from_this<Data>
@@ -269,6 +273,18 @@ public:
 
 	std::vector<int>
 	wireDecodeIdsList(const Block& wire);
+
+private:
+	/** @brief collect the DMIF fields for the compact wire format
+	 */
+	dmif::Header
+	makeDmifHeader() const;
+
+	/** @brief update ResidualEnergy, InitialHop and ForwarderId in the cached wire encoding
+	 *  @return false if the wire lacks those fields and must be re-encoded
+	 */
+	bool
+	rewriteDmifFields() const;
 /***** DMIF ******/
 
 private:
@@ -281,10 +297,12 @@ private:
   mutable Name m_fullName; ///< cached FullName computed from m_wire
 
   /***** DMIF ******/
-  uint32_t m_residualEnergy;
-  uint32_t m_initialHop;
-  uint32_t m_forwarderId;
+  uint32_t m_residualEnergy = 0;
+  uint32_t m_initialHop = 0;
+  uint32_t m_forwarderId = 0;
   std::vector<int> m_idsList;
+  /// whether ResidualEnergy, InitialHop or ForwarderId changed since m_wire was encoded
+  mutable bool m_hasDirtyDmifFields = false;
   /***** DMIF ******/
 };
 
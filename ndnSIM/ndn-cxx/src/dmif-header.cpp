@@ -0,0 +1,257 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "dmif-header.hpp"
+
+#include <cstring>
+#include <limits>
+
+namespace ndn {
+namespace dmif {
+
+BOOST_CONCEPT_ASSERT((WireEncodableWithEncodingBuffer<Header>));
+BOOST_CONCEPT_ASSERT((WireDecodable<Header>));
+
+std::ostream&
+operator<<(std::ostream& os, WireFormat format)
+{
+  switch (format) {
+    case WireFormat::LEGACY:
+      return os << "legacy";
+    case WireFormat::COMPACT:
+      return os << "compact";
+  }
+  return os << static_cast<int>(format);
+}
+
+static WireFormat g_wireFormat = WireFormat::COMPACT;
+
+void
+setWireFormat(WireFormat format)
+{
+  g_wireFormat = format;
+}
+
+WireFormat
+getWireFormat()
+{
+  return g_wireFormat;
+}
+
+/** \brief map a signed difference to an unsigned number, so that small magnitudes stay small
+ */
+static uint64_t
+zigzagEncode(int64_t n)
+{
+  return (static_cast<uint64_t>(n) << 1) ^ static_cast<uint64_t>(n >> 63);
+}
+
+static int64_t
+zigzagDecode(uint64_t n)
+{
+  return static_cast<int64_t>(n >> 1) ^ -static_cast<int64_t>(n & 1);
+}
+
+Header::Header(const Block& wire)
+{
+  this->wireDecode(wire);
+}
+
+template<encoding::Tag TAG>
+size_t
+Header::wireEncode(EncodingImpl<TAG>& encoder) const
+{
+  size_t totalLength = 0;
+  uint8_t flags = 0;
+
+  // (reverse encoding)
+
+  if (!idsList.empty()) {
+    for (size_t i = idsList.size(); i-- > 0;) {
+      int64_t previous = i > 0 ? idsList[i - 1] : 0;
+      totalLength += encoder.prependVarNumber(zigzagEncode(idsList[i] - previous));
+    }
+    totalLength += encoder.prependVarNumber(idsList.size());
+    flags |= HAS_IDS_LIST;
+  }
+
+  if (initialHop != 0) {
+    totalLength += encoder.prependVarNumber(initialHop);
+    flags |= HAS_INITIAL_HOP;
+  }
+
+  if (residualEnergy != 0) {
+    totalLength += encoder.prependVarNumber(residualEnergy);
+    flags |= HAS_RESIDUAL_ENERGY;
+  }
+
+  if (forwarderId != 0) {
+    totalLength += encoder.prependVarNumber(forwarderId);
+    flags |= HAS_FORWARDER_ID;
+  }
+
+  if (forwardingMode < MODE_ESCAPE) {
+    flags |= static_cast<uint8_t>(forwardingMode);
+  }
+  else {
+    totalLength += encoder.prependVarNumber(forwardingMode);
+    flags |= MODE_ESCAPE;
+  }
+
+  totalLength += encoder.prependByte(flags);
+  totalLength += encoder.prependVarNumber(totalLength);
+  totalLength += encoder.prependVarNumber(tlv::DmifHeader);
+  return totalLength;
+}
+
+NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(Header);
+
+template<typename Iterator>
+static uint32_t
+readField(Iterator& begin, const Iterator& end, const char* name)
+{
+  uint64_t value = tlv::readVarNumber(begin, end);
+  if (value > std::numeric_limits<uint32_t>::max()) {
+    BOOST_THROW_EXCEPTION(Header::Error(std::string(name) + " is out of range"));
+  }
+  return static_cast<uint32_t>(value);
+}
+
+void
+Header::wireDecode(const Block& wire)
+{
+  if (wire.type() != tlv::DmifHeader) {
+    BOOST_THROW_EXCEPTION(Error("Unexpected TLV type when decoding DmifHeader"));
+  }
+
+  Buffer::const_iterator begin = wire.value_begin();
+  Buffer::const_iterator end = wire.value_end();
+  if (begin == end) {
+    BOOST_THROW_EXCEPTION(Error("DmifHeader is missing Flags"));
+  }
+  uint8_t flags = *begin++;
+
+  try {
+    forwardingMode = flags & MODE_MASK;
+    if (forwardingMode == MODE_ESCAPE) {
+      forwardingMode = readField(begin, end, "ForwardingMode");
+    }
+    forwarderId = (flags & HAS_FORWARDER_ID) ? readField(begin, end, "ForwarderId") : 0;
+    residualEnergy = (flags & HAS_RESIDUAL_ENERGY) ? readField(begin, end, "ResidualEnergy") : 0;
+    initialHop = (flags & HAS_INITIAL_HOP) ? readField(begin, end, "InitialHop") : 0;
+
+    idsList.clear();
+    if (flags & HAS_IDS_LIST) {
+      uint64_t count = tlv::readVarNumber(begin, end);
+      // every id takes at least one octet
+      if (count > static_cast<uint64_t>(end - begin)) {
+        BOOST_THROW_EXCEPTION(Error("IdsList is truncated"));
+      }
+      idsList.reserve(count);
+      int64_t id = 0;
+      for (uint64_t i = 0; i < count; ++i) {
+        id += zigzagDecode(tlv::readVarNumber(begin, end));
+        idsList.push_back(static_cast<int>(id));
+      }
+    }
+  }
+  catch (const Error&) {
+    throw;
+  }
+  catch (const tlv::Error&) {
+    BOOST_THROW_EXCEPTION(Error("DmifHeader is truncated"));
+  }
+}
+
+bool
+rewriteHeader(Buffer& buffer, const Block& wire, const Header& header)
+{
+  Block::element_const_iterator val = wire.find(tlv::DmifHeader);
+  if (val == wire.elements_end()) {
+    return false;
+  }
+
+  EncodingEstimator estimator;
+  if (header.wireEncode(estimator) != val->size()) {
+    return false;
+  }
+
+  EncodingBuffer encoder(val->size(), 0);
+  header.wireEncode(encoder);
+  std::memcpy(buffer.data() + (val->wire() - wire.wire()), encoder.buf(), encoder.size());
+  return true;
+}
+
+bool
+rewriteLegacyField(Buffer& buffer, const Block& wire, uint32_t type, uint32_t value)
+{
+  Block::element_const_iterator val = wire.find(type);
+  if (val == wire.elements_end() || val->value_size() != sizeof(value)) {
+    return false;
+  }
+  std::memcpy(buffer.data() + (val->value() - wire.wire()), &value, sizeof(value));
+  return true;
+}
+
+bool
+readLegacyField(const Block& element, uint32_t& value)
+{
+  if (element.value_size() != sizeof(value)) {
+    return false;
+  }
+  std::memcpy(&value, element.value(), sizeof(value));
+  return true;
+}
+
+bool
+peekForwarderId(const Block& packet, uint32_t& forwarderId)
+{
+  Block::element_const_iterator val = packet.find(tlv::DmifHeader);
+  if (val != packet.elements_end()) {
+    Buffer::const_iterator begin = val->value_begin();
+    Buffer::const_iterator end = val->value_end();
+    if (begin == end) {
+      return false;
+    }
+    uint8_t flags = *begin++;
+    if ((flags & Header::HAS_FORWARDER_ID) == 0) {
+      return false;
+    }
+
+    uint64_t number = 0;
+    if ((flags & Header::MODE_MASK) == Header::MODE_ESCAPE &&
+        !tlv::readVarNumber(begin, end, number)) {
+      return false;
+    }
+    if (!tlv::readVarNumber(begin, end, number) ||
+        number > std::numeric_limits<uint32_t>::max()) {
+      return false;
+    }
+    forwarderId = static_cast<uint32_t>(number);
+    return true;
+  }
+
+  val = packet.find(tlv::ForwarderId);
+  return val != packet.elements_end() && readLegacyField(*val, forwarderId);
+}
+
+} // namespace dmif
+} // namespace ndn
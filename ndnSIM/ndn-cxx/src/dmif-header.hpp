@@ -0,0 +1,157 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_DMIF_HEADER_HPP
+#define NDN_DMIF_HEADER_HPP
+
+#include "encoding/block.hpp"
+#include "encoding/encoding-buffer.hpp"
+#include "util/concepts.hpp"
+
+namespace ndn {
+namespace dmif {
+
+/** \brief wire format of the DMIF fields in Interest and Data
+ */
+enum class WireFormat {
+  /** \brief one element per field, each with a 3-octet TLV-TYPE and a 4-octet value;
+   *         IdsList has one 4-octet element per id
+   */
+  LEGACY,
+  /** \brief a single DmifHeader element, see Header
+   */
+  COMPACT
+};
+
+std::ostream&
+operator<<(std::ostream& os, WireFormat format);
+
+/** \brief set the wire format used when encoding Interest and Data
+ *
+ *  This is a process-wide setting, COMPACT by default. Both formats are always accepted
+ *  by the decoders.
+ */
+void
+setWireFormat(WireFormat format);
+
+WireFormat
+getWireFormat();
+
+/** \brief DMIF fields in the compact wire format
+ *
+ *  \code
+ *  DmifHeader ::= DMIF-HEADER-TYPE TLV-LENGTH
+ *                   Flags (1 octet)
+ *                   ForwardingMode?  VAR-NUMBER, if the mode bits of Flags are MODE_ESCAPE
+ *                   ForwarderId?     VAR-NUMBER
+ *                   ResidualEnergy?  VAR-NUMBER
+ *                   InitialHop?      VAR-NUMBER
+ *                   IdsList?         VAR-NUMBER count, then the count ids as VAR-NUMBER,
+ *                                    each zigzag-encoded as the difference to the previous id
+ *  \endcode
+ *
+ *  The low two bits of Flags hold ForwardingMode if it is less than MODE_ESCAPE, and the other
+ *  bits tell which of the optional fields are present. A field whose value is zero (or an empty
+ *  IdsList) is omitted and decodes as zero. Unknown bits of Flags are ignored, so fields added
+ *  later must be appended after IdsList.
+ */
+class Header
+{
+public:
+  class Error : public tlv::Error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : tlv::Error(what)
+    {
+    }
+  };
+
+  Header() = default;
+
+  explicit
+  Header(const Block& wire);
+
+  /** \brief prepend the DmifHeader element
+   */
+  template<encoding::Tag TAG>
+  size_t
+  wireEncode(EncodingImpl<TAG>& encoder) const;
+
+  /** \brief decode a DmifHeader element
+   *  \throw Error the element is malformed
+   */
+  void
+  wireDecode(const Block& wire);
+
+public:
+  enum : uint8_t {
+    MODE_MASK           = 0x03,
+    MODE_ESCAPE         = 0x03,
+    HAS_FORWARDER_ID    = 0x04,
+    HAS_RESIDUAL_ENERGY = 0x08,
+    HAS_INITIAL_HOP     = 0x10,
+    HAS_IDS_LIST        = 0x20,
+  };
+
+  uint32_t forwardingMode = 0;
+  uint32_t forwarderId = 0;
+  uint32_t residualEnergy = 0;
+  uint32_t initialHop = 0;
+  std::vector<int> idsList;
+};
+
+NDN_CXX_DECLARE_WIRE_ENCODE_INSTANTIATIONS(Header);
+
+/** \brief overwrite the DmifHeader element of \p wire with \p header, in place
+ *  \param buffer the buffer occupied by \p wire, which must be parsed
+ *  \return false if \p wire has no DmifHeader element, or the encoding of \p header has
+ *          a different size
+ */
+bool
+rewriteHeader(Buffer& buffer, const Block& wire, const Header& header);
+
+/** \brief overwrite the 4-octet value of the \p type element of \p wire with \p value,
+ *         in place
+ *  \param buffer the buffer occupied by \p wire, which must be parsed
+ *  \return false if \p wire has no \p type element with a 4-octet value
+ */
+bool
+rewriteLegacyField(Buffer& buffer, const Block& wire, uint32_t type, uint32_t value);
+
+/** \brief read the 4-octet value of a DMIF field in the legacy wire format
+ *  \return false if the element is malformed, in which case \p value is unchanged
+ */
+bool
+readLegacyField(const Block& element, uint32_t& value);
+
+/** \brief read the ForwarderId of a parsed Interest or Data in either wire format,
+ *         without decoding the packet
+ *  \return whether the packet carries a well-formed ForwarderId
+ */
+bool
+peekForwarderId(const Block& packet, uint32_t& forwarderId);
+
+} // namespace dmif
+} // namespace ndn
+
+#endif // NDN_DMIF_HEADER_HPP
@@ -91,8 +91,11 @@ enum {
   LinkDelegation  = 31,
 
   AppPrivateBlock1 = 128,
+  /// all DMIF fields packed in one element; a 1-octet TLV-TYPE keeps the overhead low
+  DmifHeader = 200,
   AppPrivateBlock2 = 32767,
 
+  // DMIF fields in the legacy layout, still accepted by the decoders
   ForwarderId = 33000,
   ForwardingMode = 33001,
   ResidualEnergy = 33002,
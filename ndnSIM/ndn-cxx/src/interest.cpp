@@ -22,6 +22,7 @@
 #include "interest.hpp"
 #include "util/random.hpp"
 #include "data.hpp"
+#include "dmif-header.hpp"
 
 #include <cstring>
 #include <sstream>
@@ -84,17 +85,24 @@ Interest::wireEncode(EncodingImpl<TAG>& encoder) const
   totalLength += encoder.prependVarNumber(sizeof(nonce));
   totalLength += encoder.prependVarNumber(tlv::Nonce);
 
-  // Forwarder Id
-  uint32_t forwarderId = this->getForwarderId();
-	totalLength += encoder.prependByteArray(reinterpret_cast<uint8_t*>(&forwarderId), sizeof(forwarderId));
-	totalLength += encoder.prependVarNumber(sizeof(forwarderId));
-	totalLength += encoder.prependVarNumber(tlv::ForwarderId);
-
-	// Forwarding Mode
-  uint32_t forwardingMode = this->getForwardingMode();
-	totalLength += encoder.prependByteArray(reinterpret_cast<uint8_t*>(&forwardingMode), sizeof(forwardingMode));
-	totalLength += encoder.prependVarNumber(sizeof(forwardingMode));
-	totalLength += encoder.prependVarNumber(tlv::ForwardingMode);
+  // DMIF fields
+  if (dmif::getWireFormat() == dmif::WireFormat::COMPACT) {
+    dmif::Header header;
+    header.forwardingMode = m_forwardingMode;
+    header.forwarderId = m_forwarderId;
+    totalLength += header.wireEncode(encoder);
+  }
+  else {
+    uint32_t forwarderId = this->getForwarderId();
+    totalLength += encoder.prependByteArray(reinterpret_cast<uint8_t*>(&forwarderId), sizeof(forwarderId));
+    totalLength += encoder.prependVarNumber(sizeof(forwarderId));
+    totalLength += encoder.prependVarNumber(tlv::ForwarderId);
+
+    uint32_t forwardingMode = this->getForwardingMode();
+    totalLength += encoder.prependByteArray(reinterpret_cast<uint8_t*>(&forwardingMode), sizeof(forwardingMode));
+    totalLength += encoder.prependVarNumber(sizeof(forwardingMode));
+    totalLength += encoder.prependVarNumber(tlv::ForwardingMode);
+  }
 
   // Selectors
   if (hasSelectors()) {
@@ -114,10 +122,12 @@ NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(Interest);
 const Block&
 Interest::wireEncode() const
 {
-	/* Commenting because we want to be re-encoded each time
-  if (m_wire.hasWire())
-    return m_wire;
-*/
+  if (m_wire.hasWire()) {
+    if (!m_hasDirtyDmifFields || rewriteDmifFields()) {
+      return m_wire;
+    }
+  }
+
   EncodingEstimator estimator;
   size_t estimatedSize = wireEncode(estimator);
 
@@ -128,78 +138,112 @@ Interest::wireEncode() const
   return m_wire;
 }
 
+bool
+Interest::rewriteDmifFields() const
+{
+  // m_wire's buffer may be shared with copies of this Interest, so the fields are rewritten
+  // in a private copy; Name, Selectors, etc. keep referring to the old buffer, which is unchanged
+  auto buffer = make_shared<Buffer>(m_wire.wire(), m_wire.size());
+  Block wire(buffer);
+  wire.parse();
+
+  dmif::Header header;
+  header.forwardingMode = m_forwardingMode;
+  header.forwarderId = m_forwarderId;
+  if (!dmif::rewriteHeader(*buffer, wire, header) &&
+      !(dmif::rewriteLegacyField(*buffer, wire, tlv::ForwarderId, m_forwarderId) &&
+        dmif::rewriteLegacyField(*buffer, wire, tlv::ForwardingMode, m_forwardingMode))) {
+    return false;
+  }
+
+  m_wire = wire;
+  m_hasDirtyDmifFields = false;
+  return true;
+}
+
 void
 Interest::wireDecode(const Block& wire)
 {
   m_wire = wire;
   m_wire.parse();
+  m_hasDirtyDmifFields = false;
 
   if (m_wire.type() != tlv::Interest)
     BOOST_THROW_EXCEPTION(Error("Unexpected TLV number when decoding Interest"));
 
-  // Name
-  m_name.wireDecode(m_wire.get(tlv::Name));
+  // a single pass over the elements; fields that are absent keep their defaults
+  const Block* name = nullptr;
+  const Block* nonce = nullptr;
+  const Block* dmifHeader = nullptr;
+  const Block* forwarderId = nullptr;
+  const Block* forwardingMode = nullptr;
+  m_selectors = Selectors();
+  m_interestLifetime = DEFAULT_INTEREST_LIFETIME;
+  m_forwardingHint = DelegationList();
+
+  for (const Block& element : m_wire.elements()) {
+    switch (element.type()) {
+      case tlv::Name:
+        name = &element;
+        break;
+      case tlv::Selectors:
+        m_selectors.wireDecode(element);
+        break;
+      case tlv::Nonce:
+        nonce = &element;
+        break;
+      case tlv::InterestLifetime:
+        m_interestLifetime = time::milliseconds(readNonNegativeInteger(element));
+        break;
+      case tlv::ForwardingHint:
+        m_forwardingHint.wireDecode(element, false);
+        break;
+      case tlv::DmifHeader:
+        dmifHeader = &element;
+        break;
+      case tlv::ForwarderId:
+        forwarderId = &element;
+        break;
+      case tlv::ForwardingMode:
+        forwardingMode = &element;
+        break;
+      default:
+        break;
+    }
+  }
 
-  // Selectors
-  Block::element_const_iterator val = m_wire.find(tlv::Selectors);
-  if (val != m_wire.elements_end()) {
-    m_selectors.wireDecode(*val);
+  // Name
+  if (name == nullptr) {
+    BOOST_THROW_EXCEPTION(Error("Name element is missing"));
   }
-  else
-    m_selectors = Selectors();
+  m_name.wireDecode(*name);
 
   // Nonce
-  val = m_wire.find(tlv::Nonce);
-  if (val == m_wire.elements_end()) {
+  if (nonce == nullptr) {
     BOOST_THROW_EXCEPTION(Error("Nonce element is missing"));
   }
-  uint32_t nonce = 0;
-  if (val->value_size() != sizeof(nonce)) {
+  uint32_t nonceValue = 0;
+  if (nonce->value_size() != sizeof(nonceValue)) {
     BOOST_THROW_EXCEPTION(Error("Nonce element is malformed"));
   }
-  std::memcpy(&nonce, val->value(), sizeof(nonce));
-  m_nonce = nonce;
-
-  // Forwarder Id
-  val = m_wire.find(tlv::ForwarderId);
-  if (val == m_wire.elements_end()) {
-	BOOST_THROW_EXCEPTION(Error("Forwarder Id element is missing"));
-  }
-  uint32_t forwarderId = 0;
-  if (val->value_size() != sizeof(forwarderId)) {
-	BOOST_THROW_EXCEPTION(Error("Forwarder Id element is malformed"));
-  }
-  std::memcpy(&forwarderId, val->value(), sizeof(forwarderId));
-  m_forwarderId = forwarderId;
-
-  // Forwarding Mode
-   val = m_wire.find(tlv::ForwardingMode);
-   if (val == m_wire.elements_end()) {
- 	BOOST_THROW_EXCEPTION(Error("Forwarding Mode element is missing"));
-   }
-   uint32_t forwardingMode = 0;
-   if (val->value_size() != sizeof(forwardingMode)) {
- 	BOOST_THROW_EXCEPTION(Error("Forwarding Mode element is malformed"));
-   }
-   std::memcpy(&forwardingMode, val->value(), sizeof(forwardingMode));
-   m_forwardingMode = forwardingMode;
-
-  // InterestLifetime
-  val = m_wire.find(tlv::InterestLifetime);
-  if (val != m_wire.elements_end()) {
-    m_interestLifetime = time::milliseconds(readNonNegativeInteger(*val));
-  }
-  else {
-    m_interestLifetime = DEFAULT_INTEREST_LIFETIME;
-  }
-
-  // ForwardingHint
-  val = m_wire.find(tlv::ForwardingHint);
-  if (val != m_wire.elements_end()) {
-    m_forwardingHint.wireDecode(*val, false);
+  std::memcpy(&nonceValue, nonce->value(), sizeof(nonceValue));
+  m_nonce = nonceValue;
+
+  // DMIF fields, in either wire format; an Interest from a non-DMIF node has none
+  m_forwarderId = 0;
+  m_forwardingMode = static_cast<uint32_t>(ForwardingMode::Flooding);
+  if (dmifHeader != nullptr) {
+    dmif::Header header(*dmifHeader);
+    m_forwarderId = header.forwarderId;
+    m_forwardingMode = header.forwardingMode;
   }
   else {
-    m_forwardingHint = DelegationList();
+    if (forwarderId != nullptr && !dmif::readLegacyField(*forwarderId, m_forwarderId)) {
+      BOOST_THROW_EXCEPTION(Error("Forwarder Id element is malformed"));
+    }
+    if (forwardingMode != nullptr && !dmif::readLegacyField(*forwardingMode, m_forwardingMode)) {
+      BOOST_THROW_EXCEPTION(Error("Forwarding Mode element is malformed"));
+    }
   }
 }
 
@@ -386,8 +430,10 @@ Interest::setForwardingHint(const DelegationList& value)
 
 Interest&
 Interest::setForwarderId(const uint32_t id) {
-	m_forwarderId = id;
-	m_wire.reset();
+	if (id != m_forwarderId) {
+		m_forwarderId = id;
+		m_hasDirtyDmifFields = true;
+	}
 	return *this;
 }
 
@@ -398,8 +444,10 @@ Interest::getForwarderId() const {
 
 Interest&
 Interest::setForwardingMode(const uint32_t id) {
-	m_forwardingMode = id;
-	m_wire.reset();
+	if (id != m_forwardingMode) {
+		m_forwardingMode = id;
+		m_hasDirtyDmifFields = true;
+	}
 	return *this;
 }
 
@@ -345,6 +345,12 @@ public:
 	std::string
 	getForwardingModeName() const;
 
+private:
+	/** @brief update ForwarderId and ForwardingMode in the cached wire encoding
+	 *  @return false if the wire lacks those fields and must be re-encoded
+	 */
+	bool
+	rewriteDmifFields() const;
 
 private:
   Name m_name;
@@ -355,8 +361,10 @@ private:
 
   mutable Block m_wire;
 
-  uint32_t m_forwarderId;
+  uint32_t m_forwarderId = 0;
   uint32_t m_forwardingMode = (int)ForwardingMode::Flooding;
+  /// whether ForwarderId or ForwardingMode changed since m_wire was encoded
+  mutable bool m_hasDirtyDmifFields = false;
 };
 
 NDN_CXX_DECLARE_WIRE_ENCODE_INSTANTIATIONS(Interest);
@@ -168,6 +168,7 @@ Name::wireDecode(const Block& wire)
 
   m_wire = wire;
   m_wire.parse();
+  m_prefixHashes.clear();
 }
 
 Name
@@ -211,9 +212,51 @@ Name::getSubName(ssize_t iStartComponent, size_t nComponents) const
   for (size_t i = iStart; i < iEnd; ++i)
     result.append(at(i));
 
+  if (iStart == 0 && !m_prefixHashes.empty()) {
+    result.m_prefixHashes.assign(m_prefixHashes.begin(), m_prefixHashes.begin() + iEnd + 1);
+  }
+
   return result;
 }
 
+const Name::PrefixHashes&
+Name::getPrefixHashes() const
+{
+  if (m_prefixHashes.empty()) {
+    m_prefixHashes.reserve(size() + 1);
+    m_prefixHashes.push_back(0);
+    for (const Component& comp : *this) {
+      m_prefixHashes.push_back(extendPrefixHash(m_prefixHashes.back(), comp));
+    }
+  }
+  return m_prefixHashes;
+}
+
+/** @brief MurmurHash3 fmix64 finalizer
+ *
+ *  hash_combine leaves the high bits of the hash poorly mixed, and the NFD name tree takes its
+ *  fingerprints from them; the finalizer makes every bit depend on every input bit.
+ */
+static size_t
+finalizePrefixHash(uint64_t h)
+{
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return static_cast<size_t>(h);
+}
+
+size_t
+Name::extendPrefixHash(size_t prefixHash, const Component& component)
+{
+  size_t h = prefixHash;
+  boost::hash_combine(h, component.type());
+  boost::hash_range(h, component.value(), component.value() + component.value_size());
+  return finalizePrefixHash(h);
+}
+
 // ---- modifiers ----
 
 Name&
@@ -337,8 +380,7 @@ namespace std {
 size_t
 hash<ndn::Name>::operator()(const ndn::Name& name) const
 {
-  return boost::hash_range(name.wireEncode().wire(),
-                           name.wireEncode().wire() + name.wireEncode().size());
+  return name.getPrefixHashes().back();
 }
 
 } // namespace std
@@ -29,6 +29,11 @@
 #include "name-component.hpp"
 #include <iterator>
 
+#include <boost/version.hpp>
+#if BOOST_VERSION >= 105800
+#include <boost/container/small_vector.hpp>
+#endif
+
 namespace ndn {
 
 class Name;
@@ -69,6 +74,15 @@ public: // nested types
   using difference_type        = component_container::difference_type;
   using size_type              = component_container::size_type;
 
+  /** @brief Hash values of every prefix of a name
+   *  @sa getPrefixHashes
+   */
+#if BOOST_VERSION >= 105800
+  using PrefixHashes = boost::container::small_vector<size_t, 8>;
+#else
+  using PrefixHashes = std::vector<size_t>;
+#endif
+
 public: // constructors, encoding, decoding
   /** @brief Create an empty name
    *  @post empty() == true
@@ -215,6 +229,17 @@ public: // access
       return getSubName(0, nComponents);
   }
 
+  /** @brief Get hash values of every prefix of the name
+   *  @return a sequence of size() + 1 values, where the i-th value is the hash of getPrefix(i)
+   *
+   *  The sequence is computed on first use and kept with the name. Appending a component
+   *  extends a computed sequence by one value; any other modification discards it.
+   *  The i-th value does not depend on components after the i-th, so equal prefixes of
+   *  different names have equal hashes.
+   */
+  const PrefixHashes&
+  getPrefixHashes() const;
+
 public: // iterators
   /** @brief Begin iterator
    */
@@ -256,6 +281,7 @@ public: // modifiers
   append(const Component& component)
   {
     m_wire.push_back(component);
+    extendPrefixHashes();
     return *this;
   }
 
@@ -311,6 +337,7 @@ public: // modifiers
     else {
       m_wire.push_back(Block(tlv::NameComponent, value));
     }
+    extendPrefixHashes();
 
     return *this;
   }
@@ -450,6 +477,7 @@ public: // modifiers
   clear()
   {
     m_wire = Block(tlv::Name);
+    m_prefixHashes.clear();
   }
 
 public: // algorithms
@@ -536,8 +564,25 @@ public:
    */
   static const size_t npos;
 
+private:
+  /** @brief Extend the cached prefix hashes with the last component, if they have been computed
+   */
+  void
+  extendPrefixHashes()
+  {
+    if (!m_prefixHashes.empty()) {
+      m_prefixHashes.push_back(extendPrefixHash(m_prefixHashes.back(), get(-1)));
+    }
+  }
+
+  /** @brief Compute the hash of a prefix with hash @p prefixHash followed by @p component
+   */
+  static size_t
+  extendPrefixHash(size_t prefixHash, const Component& component);
+
 private:
   mutable Block m_wire;
+  mutable PrefixHashes m_prefixHashes; ///< cached getPrefixHashes(), empty until first computed
 };
 
 NDN_CXX_DECLARE_WIRE_ENCODE_INSTANTIATIONS(Name);
@@ -0,0 +1,334 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "timer-wheel.hpp"
+
+#include <limits>
+
+namespace ndn {
+namespace util {
+namespace detail {
+
+TimerWheelEntry::TimerWheelEntry(time::steady_clock::TimePoint expiry)
+  : m_expiry(expiry)
+  , m_seq(0)
+  , m_state(State::NONE)
+  , m_level(0)
+  , m_slot(0)
+{
+}
+
+constexpr size_t TimerWheel::SLOT_BITS;
+constexpr size_t TimerWheel::N_SLOTS;
+constexpr size_t TimerWheel::N_LEVELS;
+constexpr size_t TimerWheel::N_BITMAP_WORDS;
+
+static constexpr uint64_t NO_TICK = std::numeric_limits<uint64_t>::max();
+
+TimerWheel::TimerWheel(time::nanoseconds tick)
+  : m_occupied{}
+  , m_nOverflowPending(0)
+  , m_tick(tick)
+  , m_origin(time::steady_clock::now())
+  , m_now(0)
+  , m_nextSeq(0)
+  , m_nPending(0)
+{
+  BOOST_ASSERT(m_tick > time::nanoseconds::zero());
+}
+
+void
+TimerWheel::insert(shared_ptr<TimerWheelEntry> entry)
+{
+  BOOST_ASSERT(entry != nullptr);
+  BOOST_ASSERT(!entry->isPending());
+
+  if (m_nPending == 0) {
+    // nothing refers to the current tick numbering: restart it from now, which keeps ticks small
+    // and tolerates the clock being replaced while the wheel is idle
+    m_due = DueQueue();
+    m_origin = time::steady_clock::now();
+    m_now = 0;
+  }
+
+  entry->m_seq = m_nextSeq++;
+  ++m_nPending;
+  this->place(std::move(entry));
+}
+
+void
+TimerWheel::cancel(TimerWheelEntry& entry)
+{
+  auto state = entry.m_state;
+  if (state == TimerWheelEntry::State::NONE) {
+    return;
+  }
+  entry.m_state = TimerWheelEntry::State::NONE;
+  --m_nPending;
+
+  // a container left with only cancelled entries is emptied right away; entry may be destroyed
+  switch (state) {
+    case TimerWheelEntry::State::IN_WHEEL: {
+      Slot& slot = m_slots[entry.m_level][entry.m_slot];
+      BOOST_ASSERT(slot.nPending > 0);
+      if (--slot.nPending == 0) {
+        this->setOccupied(entry.m_level, entry.m_slot, false);
+        slot.entries.clear();
+      }
+      break;
+    }
+    case TimerWheelEntry::State::IN_OVERFLOW:
+      BOOST_ASSERT(m_nOverflowPending > 0);
+      if (--m_nOverflowPending == 0) {
+        m_overflow.clear();
+      }
+      break;
+    default:
+      // an entry in the due queue is discarded when it reaches the head of the queue
+      break;
+  }
+}
+
+time::steady_clock::TimePoint
+TimerWheel::getNextExpiry()
+{
+  while (!m_due.empty() && !m_due.top()->isPending()) {
+    m_due.pop();
+  }
+
+  auto expiry = time::steady_clock::TimePoint::max();
+  if (!m_due.empty()) {
+    expiry = m_due.top()->m_expiry;
+  }
+
+  uint64_t tick = this->getNextCascadeTick();
+  if (tick != NO_TICK) {
+    expiry = std::min(expiry, m_origin + m_tick * static_cast<int64_t>(tick));
+  }
+  return expiry;
+}
+
+shared_ptr<TimerWheelEntry>
+TimerWheel::popExpired(time::steady_clock::TimePoint now)
+{
+  this->advance(this->toTick(now));
+
+  while (!m_due.empty()) {
+    const shared_ptr<TimerWheelEntry>& top = m_due.top();
+    if (!top->isPending()) {
+      m_due.pop();
+      continue;
+    }
+    if (top->m_expiry > now) {
+      break;
+    }
+
+    shared_ptr<TimerWheelEntry> entry = top;
+    m_due.pop();
+    entry->m_state = TimerWheelEntry::State::NONE;
+    --m_nPending;
+    return entry;
+  }
+  return nullptr;
+}
+
+std::vector<shared_ptr<TimerWheelEntry>>
+TimerWheel::clear()
+{
+  std::vector<shared_ptr<TimerWheelEntry>> pending;
+  pending.reserve(m_nPending);
+  auto collect = [&pending] (std::vector<shared_ptr<TimerWheelEntry>>& entries) {
+    for (auto& entry : entries) {
+      if (entry->isPending()) {
+        entry->m_state = TimerWheelEntry::State::NONE;
+        pending.push_back(std::move(entry));
+      }
+    }
+    entries.clear();
+  };
+
+  for (size_t level = 0; level < N_LEVELS; ++level) {
+    for (size_t i = 0; i < N_SLOTS; ++i) {
+      collect(m_slots[level][i].entries);
+      m_slots[level][i].nPending = 0;
+    }
+    std::fill_n(m_occupied[level], N_BITMAP_WORDS, 0);
+  }
+  collect(m_overflow);
+  m_nOverflowPending = 0;
+
+  for (; !m_due.empty(); m_due.pop()) {
+    const shared_ptr<TimerWheelEntry>& entry = m_due.top();
+    if (entry->isPending()) {
+      entry->m_state = TimerWheelEntry::State::NONE;
+      pending.push_back(entry);
+    }
+  }
+
+  BOOST_ASSERT(pending.size() == m_nPending);
+  m_nPending = 0;
+  return pending;
+}
+
+uint64_t
+TimerWheel::toTick(time::steady_clock::TimePoint t) const
+{
+  if (t <= m_origin) {
+    return 0;
+  }
+  return static_cast<uint64_t>((t - m_origin) / m_tick);
+}
+
+void
+TimerWheel::place(shared_ptr<TimerWheelEntry> entry)
+{
+  uint64_t tick = this->toTick(entry->m_expiry);
+  if (tick <= m_now) {
+    entry->m_state = TimerWheelEntry::State::IN_DUE;
+    m_due.push(std::move(entry));
+    return;
+  }
+
+  // the level is the most significant group of SLOT_BITS in which tick differs from m_now,
+  // so that the slot is reached by m_now before any lower group of bits can wrap around
+  uint64_t diff = tick ^ m_now;
+  size_t level = 0;
+  while (level < N_LEVELS && (diff >> (SLOT_BITS * (level + 1))) != 0) {
+    ++level;
+  }
+
+  if (level == N_LEVELS) {
+    entry->m_state = TimerWheelEntry::State::IN_OVERFLOW;
+    m_overflow.push_back(std::move(entry));
+    ++m_nOverflowPending;
+    return;
+  }
+
+  size_t i = (tick >> (SLOT_BITS * level)) & (N_SLOTS - 1);
+  Slot& slot = m_slots[level][i];
+  if (slot.nPending++ == 0) {
+    this->setOccupied(level, i, true);
+  }
+  entry->m_state = TimerWheelEntry::State::IN_WHEEL;
+  entry->m_level = static_cast<uint8_t>(level);
+  entry->m_slot = static_cast<uint8_t>(i);
+  slot.entries.push_back(std::move(entry));
+}
+
+void
+TimerWheel::cascade(std::vector<shared_ptr<TimerWheelEntry>>& entries)
+{
+  for (auto& entry : entries) {
+    if (entry->isPending()) {
+      this->place(std::move(entry));
+    }
+  }
+}
+
+uint64_t
+TimerWheel::getNextCascadeTick() const
+{
+  uint64_t next = NO_TICK;
+  for (size_t level = 0; level < N_LEVELS; ++level) {
+    size_t shift = SLOT_BITS * level;
+    size_t i = this->findOccupiedSlot(level, ((m_now >> shift) & (N_SLOTS - 1)) + 1);
+    if (i < N_SLOTS) {
+      uint64_t base = (m_now >> (shift + SLOT_BITS)) << (shift + SLOT_BITS);
+      next = std::min(next, base | (static_cast<uint64_t>(i) << shift));
+    }
+  }
+
+  if (m_nOverflowPending > 0) {
+    size_t shift = SLOT_BITS * N_LEVELS;
+    next = std::min(next, ((m_now >> shift) + 1) << shift);
+  }
+  return next;
+}
+
+void
+TimerWheel::advance(uint64_t tick)
+{
+  std::vector<shared_ptr<TimerWheelEntry>> entries;
+
+  for (uint64_t next = this->getNextCascadeTick(); next <= tick;
+       next = this->getNextCascadeTick()) {
+    m_now = next;
+
+    if (m_nOverflowPending > 0 && (m_now & ((uint64_t(1) << (SLOT_BITS * N_LEVELS)) - 1)) == 0) {
+      entries.swap(m_overflow);
+      m_nOverflowPending = 0;
+      this->cascade(entries);
+      entries.clear();
+    }
+
+    // visit higher levels first: their entries may land in a lower slot starting at m_now
+    for (size_t level = N_LEVELS; level-- > 0;) {
+      size_t shift = SLOT_BITS * level;
+      if ((m_now & ((uint64_t(1) << shift) - 1)) != 0) {
+        continue;
+      }
+      size_t i = (m_now >> shift) & (N_SLOTS - 1);
+      Slot& slot = m_slots[level][i];
+      if (slot.nPending == 0) {
+        continue;
+      }
+
+      entries.swap(slot.entries);
+      slot.nPending = 0;
+      this->setOccupied(level, i, false);
+      this->cascade(entries);
+      entries.clear();
+    }
+  }
+
+  m_now = std::max(m_now, tick);
+}
+
+size_t
+TimerWheel::findOccupiedSlot(size_t level, size_t slot) const
+{
+  for (size_t word = slot / 64; word < N_BITMAP_WORDS; ++word) {
+    uint64_t bits = m_occupied[level][word];
+    if (word == slot / 64) {
+      bits &= ~uint64_t(0) << (slot % 64);
+    }
+    if (bits != 0) {
+      return word * 64 + __builtin_ctzll(bits);
+    }
+  }
+  return N_SLOTS;
+}
+
+void
+TimerWheel::setOccupied(size_t level, size_t slot, bool isOccupied)
+{
+  uint64_t mask = uint64_t(1) << (slot % 64);
+  if (isOccupied) {
+    m_occupied[level][slot / 64] |= mask;
+  }
+  else {
+    m_occupied[level][slot / 64] &= ~mask;
+  }
+}
+
+} // namespace detail
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,222 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_DETAIL_TIMER_WHEEL_HPP
+#define NDN_UTIL_DETAIL_TIMER_WHEEL_HPP
+
+#include "../time.hpp"
+#include "../../common.hpp"
+
+#include <queue>
+#include <tuple>
+
+namespace ndn {
+namespace util {
+namespace detail {
+
+class TimerWheel;
+
+/** \brief an entry in a TimerWheel
+ *
+ *  The owner of a TimerWheel derives from this class to attach a payload to the entry.
+ */
+class TimerWheelEntry : noncopyable
+{
+public:
+  explicit
+  TimerWheelEntry(time::steady_clock::TimePoint expiry);
+
+  time::steady_clock::TimePoint
+  getExpiry() const
+  {
+    return m_expiry;
+  }
+
+  /** \return whether the entry is in a TimerWheel, and has been neither cancelled nor popped
+   */
+  bool
+  isPending() const
+  {
+    return m_state != State::NONE;
+  }
+
+private:
+  enum class State : uint8_t {
+    NONE,
+    IN_WHEEL,
+    IN_OVERFLOW,
+    IN_DUE
+  };
+
+  time::steady_clock::TimePoint m_expiry;
+  uint64_t m_seq; ///< insertion order, breaks ties in expiry
+  State m_state;
+  uint8_t m_level;
+  uint8_t m_slot;
+
+  friend class TimerWheel;
+};
+
+/** \brief a hierarchical timing wheel
+ *
+ *  Time is divided into ticks. The wheel has N_LEVELS levels of N_SLOTS slots each: a slot on
+ *  level L covers N_SLOTS^L ticks. An entry is placed on the lowest level whose slot range
+ *  still includes the current tick, in the slot covering its expiry; entries too far in the
+ *  future are kept in an overflow list. When the current tick reaches the start of a slot on
+ *  a higher level, the entries of that slot are cascaded to lower levels, and the entries of
+ *  the current level-0 slot are moved into a queue ordered by exact expiry, from which they
+ *  are popped.
+ *
+ *  Insertion and cancellation are O(1). A cancelled entry is only marked, and is discarded
+ *  when its slot is emptied, cascaded, or reaches the head of the due queue.
+ */
+class TimerWheel : noncopyable
+{
+public:
+  explicit
+  TimerWheel(time::nanoseconds tick = time::milliseconds(1));
+
+  /** \brief number of pending entries
+   */
+  size_t
+  size() const
+  {
+    return m_nPending;
+  }
+
+  bool
+  empty() const
+  {
+    return m_nPending == 0;
+  }
+
+  /** \brief insert an entry
+   *  \pre !entry->isPending()
+   */
+  void
+  insert(shared_ptr<TimerWheelEntry> entry);
+
+  /** \brief cancel a pending entry
+   *
+   *  This has no effect if the entry is not pending.
+   */
+  void
+  cancel(TimerWheelEntry& entry);
+
+  /** \return the time at which popExpired should be invoked next,
+   *          or TimePoint::max() if there is no pending entry
+   *
+   *  This may be earlier than the expiry of the earliest entry, when entries need to be moved
+   *  to a lower level before they expire.
+   */
+  time::steady_clock::TimePoint
+  getNextExpiry();
+
+  /** \brief pop the earliest pending entry that has expired at \p now
+   *  \return the entry, or nullptr if no pending entry has expired
+   *
+   *  Entries are popped in the order of their expiry, and entries with the same expiry are
+   *  popped in the order they were inserted.
+   */
+  shared_ptr<TimerWheelEntry>
+  popExpired(time::steady_clock::TimePoint now);
+
+  /** \brief remove all entries
+   *  \return the entries that were pending
+   */
+  std::vector<shared_ptr<TimerWheelEntry>>
+  clear();
+
+public:
+  static constexpr size_t SLOT_BITS = 8;
+  static constexpr size_t N_SLOTS = 1 << SLOT_BITS;
+  static constexpr size_t N_LEVELS = 4;
+
+private:
+  uint64_t
+  toTick(time::steady_clock::TimePoint t) const;
+
+  /** \brief put an entry into the due queue, a slot, or the overflow list, relative to m_now
+   */
+  void
+  place(shared_ptr<TimerWheelEntry> entry);
+
+  /** \brief re-place the pending entries of a slot or the overflow list
+   */
+  void
+  cascade(std::vector<shared_ptr<TimerWheelEntry>>& entries);
+
+  /** \return the first tick after m_now at which a slot or the overflow list must be cascaded,
+   *          or UINT64_MAX if none
+   */
+  uint64_t
+  getNextCascadeTick() const;
+
+  /** \brief advance m_now to \p tick, cascading every slot whose start is reached
+   */
+  void
+  advance(uint64_t tick);
+
+  size_t
+  findOccupiedSlot(size_t level, size_t slot) const;
+
+  void
+  setOccupied(size_t level, size_t slot, bool isOccupied);
+
+private:
+  struct Slot
+  {
+    std::vector<shared_ptr<TimerWheelEntry>> entries;
+    size_t nPending = 0;
+  };
+
+  struct EntryLater
+  {
+    bool
+    operator()(const shared_ptr<TimerWheelEntry>& a, const shared_ptr<TimerWheelEntry>& b) const
+    {
+      return std::tie(a->m_expiry, a->m_seq) > std::tie(b->m_expiry, b->m_seq);
+    }
+  };
+
+  using DueQueue = std::priority_queue<shared_ptr<TimerWheelEntry>,
+                                       std::vector<shared_ptr<TimerWheelEntry>>, EntryLater>;
+
+  static constexpr size_t N_BITMAP_WORDS = N_SLOTS / 64;
+
+  Slot m_slots[N_LEVELS][N_SLOTS];
+  uint64_t m_occupied[N_LEVELS][N_BITMAP_WORDS]; ///< bitmap of slots with pending entries
+  std::vector<shared_ptr<TimerWheelEntry>> m_overflow;
+  size_t m_nOverflowPending;
+  DueQueue m_due;
+
+  time::nanoseconds m_tick;
+  time::steady_clock::TimePoint m_origin; ///< time of tick 0
+  uint64_t m_now; ///< current tick
+  uint64_t m_nextSeq;
+  size_t m_nPending;
+};
+
+} // namespace detail
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_DETAIL_TIMER_WHEEL_HPP
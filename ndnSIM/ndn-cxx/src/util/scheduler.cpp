@@ -21,9 +21,12 @@
 
 #include "scheduler.hpp"
 #include "detail/steady-timer.hpp"
+#include "detail/timer-wheel.hpp"
 
 #include <boost/scope_exit.hpp>
 
+#include <algorithm>
+
 namespace ns3 {
 
 /// @cond include_hidden
@@ -46,19 +49,71 @@ namespace ndn {
 namespace util {
 namespace scheduler {
 
-Scheduler::Scheduler(boost::asio::io_service& ioService)
+/** \brief an event kept in the timing wheel
+ *
+ *  The ns3::EventId base is unused, and only makes WheelEvent usable as an EventId.
+ */
+class Scheduler::WheelEvent : public ns3::EventId, public detail::TimerWheelEntry
+{
+public:
+  WheelEvent(const Scheduler& scheduler, time::steady_clock::TimePoint expiry, const Event& event)
+    : detail::TimerWheelEntry(expiry)
+    , scheduler(&scheduler)
+    , callback(event)
+    , context(ns3::Simulator::GetContext())
+  {
+  }
+
+  /** \brief execute the callback, unless the event has been cancelled
+   */
+  void
+  run()
+  {
+    if (callback == nullptr) {
+      return;
+    }
+    Event event = std::move(callback);
+    callback = nullptr;
+    event();
+  }
+
+public:
+  const Scheduler* scheduler;
+  Event callback;
+  /// ns-3 context (node) in which the event was scheduled
+  uint32_t context;
+};
+
+Scheduler::Scheduler(boost::asio::io_service& ioService, Backend backend)
   : m_scheduledEvent(m_events.end())
+  , m_backend(backend)
+  , m_wheelTimerExpiry(time::steady_clock::TimePoint::max())
 {
+  if (m_backend == Backend::TIMER_WHEEL) {
+    m_wheel = make_unique<detail::TimerWheel>();
+  }
 }
 
 Scheduler::~Scheduler()
 {
   cancelAllEvents();
+  ns3::Simulator::Remove(m_destroyEvent);
 }
 
 EventId
 Scheduler::scheduleEvent(const time::nanoseconds& after, const Event& event)
 {
+  if (m_backend == Backend::TIMER_WHEEL) {
+    auto expiry = time::steady_clock::now() + std::max(after, time::nanoseconds::zero());
+    auto wheelEvent = std::make_shared<WheelEvent>(*this, expiry, event);
+    m_wheel->insert(wheelEvent);
+    // the timer is also re-armed if it was lost, e.g. when it was removed by another party
+    if (expiry < m_wheelTimerExpiry || m_wheelTimer.IsExpired()) {
+      this->scheduleWheelTimer();
+    }
+    return wheelEvent;
+  }
+
   EventId eventId = std::make_shared<ns3::EventId>();
   weak_ptr<ns3::EventId> eventWeak = eventId;
   std::function<void()> eventWithCleanup = [this, event, eventWeak] () {
@@ -80,7 +135,19 @@ Scheduler::scheduleEvent(const time::nanoseconds& after, const Event& event)
 void
 Scheduler::cancelEvent(const EventId& eventId)
 {
-  if (eventId != nullptr) {
+  if (eventId != nullptr && m_backend == Backend::TIMER_WHEEL) {
+    auto& wheelEvent = static_cast<WheelEvent&>(*eventId);
+    // an event of a scheduler that has been replaced (e.g. NFD's global scheduler after
+    // Simulator::Destroy) is no longer in any wheel, and its callback has been dropped
+    if (wheelEvent.scheduler == this) {
+      // the ns-3 event serving the wheel is left alone: if it was armed for this event,
+      // it finds nothing due and re-arms for the next one
+      m_wheel->cancel(wheelEvent);
+      wheelEvent.callback = nullptr;
+    }
+    const_cast<EventId&>(eventId).reset();
+  }
+  else if (eventId != nullptr) {
     ns3::Simulator::Remove(*eventId);
     m_events.erase(eventId);
     const_cast<EventId&>(eventId).reset();
@@ -90,6 +157,18 @@ Scheduler::cancelEvent(const EventId& eventId)
 void
 Scheduler::cancelAllEvents()
 {
+  if (m_wheel != nullptr) {
+    for (const auto& entry : m_wheel->clear()) {
+      static_cast<WheelEvent&>(*entry).callback = nullptr;
+    }
+    for (const auto& entry : m_wheelDispatched) {
+      static_cast<WheelEvent&>(*entry).callback = nullptr;
+    }
+    m_wheelDispatched.clear();
+    ns3::Simulator::Remove(m_wheelTimer);
+    m_wheelTimerExpiry = time::steady_clock::TimePoint::max();
+  }
+
   for (auto i = m_events.begin(); i != m_events.end(); ) {
     auto next = i;
     ++next; // ns3::Simulator::Remove can call cancelEvent
@@ -102,6 +181,84 @@ Scheduler::cancelAllEvents()
   m_events.clear();
 }
 
+void
+Scheduler::scheduleWheelTimer()
+{
+  auto expiry = m_wheel->getNextExpiry();
+  if (expiry == m_wheelTimerExpiry && !m_wheelTimer.IsExpired()) {
+    return;
+  }
+
+  ns3::Simulator::Remove(m_wheelTimer);
+  m_wheelTimerExpiry = expiry;
+  if (expiry == time::steady_clock::TimePoint::max()) {
+    return;
+  }
+
+  auto delay = time::duration_cast<time::nanoseconds>(expiry - time::steady_clock::now());
+  delay = std::max(delay, time::nanoseconds::zero());
+  m_wheelTimer = ns3::Simulator::Schedule(ns3::NanoSeconds(delay.count()),
+                                          &Scheduler::onWheelTimer, this);
+
+  if (m_destroyEvent.IsExpired()) {
+    m_destroyEvent = ns3::Simulator::ScheduleDestroy(&Scheduler::onSimulatorDestroy, this);
+  }
+}
+
+void
+Scheduler::onSimulatorDestroy()
+{
+  // the ns-3 events serving the wheel are destroyed with the simulator, and their EventIds
+  // must not reach the next simulator; events still in the wheel are dropped like ns-3 events
+  for (const auto& entry : m_wheel->clear()) {
+    static_cast<WheelEvent&>(*entry).callback = nullptr;
+  }
+  for (const auto& entry : m_wheelDispatched) {
+    static_cast<WheelEvent&>(*entry).callback = nullptr;
+  }
+  m_wheelDispatched.clear();
+  m_wheelTimer = ns3::EventId();
+  m_wheelTimerExpiry = time::steady_clock::TimePoint::max();
+  m_destroyEvent = ns3::EventId();
+}
+
+void
+Scheduler::onWheelTimer()
+{
+  m_wheelTimerExpiry = time::steady_clock::TimePoint::max();
+
+  // re-arm even if an event throws, so that later events are not lost
+  BOOST_SCOPE_EXIT(this_) {
+    this_->scheduleWheelTimer();
+  } BOOST_SCOPE_EXIT_END
+
+  // forget dispatched events that have run or have been cancelled
+  auto isDone = [] (const shared_ptr<detail::TimerWheelEntry>& entry) {
+    return static_cast<WheelEvent&>(*entry).callback == nullptr;
+  };
+  m_wheelDispatched.erase(std::remove_if(m_wheelDispatched.begin(), m_wheelDispatched.end(),
+                                         isDone),
+                          m_wheelDispatched.end());
+
+  auto now = time::steady_clock::now();
+  uint32_t context = ns3::Simulator::GetContext();
+  while (auto entry = m_wheel->popExpired(now)) {
+    auto& wheelEvent = static_cast<WheelEvent&>(*entry);
+    if (wheelEvent.context == context && m_wheelDispatched.empty()) {
+      wheelEvent.run();
+      continue;
+    }
+
+    // ns-3 offers no way to switch context other than through its event queue; while an event
+    // is dispatched, later ones are dispatched too, so that they still run in order.
+    // Cancelling a dispatched event clears its callback, so the ns-3 event holds only the entry
+    std::function<void()> run = [entry] { static_cast<WheelEvent&>(*entry).run(); };
+    ns3::Simulator::ScheduleWithContext(wheelEvent.context, ns3::Seconds(0),
+                                        &std::function<void()>::operator(), run);
+    m_wheelDispatched.push_back(std::move(entry));
+  }
+}
+
 } // namespace scheduler
 } // namespace util
 } // namespace ndn
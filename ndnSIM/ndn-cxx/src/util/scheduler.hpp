@@ -39,6 +39,8 @@ namespace util {
 
 namespace detail {
 class SteadyTimer;
+class TimerWheel;
+class TimerWheelEntry;
 } // namespace detail
 
 namespace scheduler {
@@ -61,8 +63,27 @@ public:
    */
   typedef EventCallback Event;
 
+  /** \brief how scheduled events are kept
+   */
+  enum class Backend {
+    /** \brief every event is an ns-3 simulator event
+     */
+    SIMULATOR,
+    /** \brief events are kept in a hierarchical timing wheel, which is served by a single
+     *         ns-3 simulator event at a time
+     *
+     *  Scheduling and cancelling an event is O(1), and a cancelled event is discarded lazily.
+     *  This suits a large number of timers that are mostly cancelled before they expire.
+     *  Events with the same expiry are executed in the order they were scheduled, but their
+     *  order relative to other ns-3 events at the same simulation time is unspecified.
+     *  Each event is executed in the ns-3 context (node) that scheduled it. Like ns-3 events,
+     *  events still pending when the simulator is destroyed are dropped without running.
+     */
+    TIMER_WHEEL
+  };
+
   explicit
-  Scheduler(boost::asio::io_service& ioService);
+  Scheduler(boost::asio::io_service& ioService, Backend backend = Backend::SIMULATOR);
 
   ~Scheduler();
 
@@ -75,6 +96,7 @@ public:
 
   /**
    * \brief Cancel a scheduled event
+   * \pre eventId has been returned by this Scheduler, or is nullptr
    */
   void
   cancelEvent(const EventId& eventId);
@@ -112,10 +134,42 @@ private:
     mutable EventId m_eventId;
   };
 
+  class WheelEvent;
+
+  /** \brief arm the ns-3 event that serves the timing wheel, if the next expiry has changed
+   */
+  void
+  scheduleWheelTimer();
+
+  /** \brief execute expired events in the timing wheel
+   *
+   *  An event scheduled in another ns-3 context than the current one, and every event after
+   *  it while a dispatched event has not run, is dispatched as a zero-delay ns-3 event in its
+   *  own context.
+   */
+  void
+  onWheelTimer();
+
+  /** \brief drop every event in the timing wheel, and forget the ns-3 events serving it
+   */
+  void
+  onSimulatorDestroy();
+
+private:
   typedef std::multiset<EventId> EventQueue;
 
   EventQueue m_events;
   EventQueue::iterator m_scheduledEvent;
+
+  Backend m_backend;
+  unique_ptr<detail::TimerWheel> m_wheel;
+  ns3::EventId m_wheelTimer;
+  /// expiry of m_wheelTimer, or TimePoint::max() if not scheduled
+  time::steady_clock::TimePoint m_wheelTimerExpiry;
+  /// expired events dispatched by onWheelTimer, which may not have run yet
+  std::vector<shared_ptr<detail::TimerWheelEntry>> m_wheelDispatched;
+  /// Simulator::ScheduleDestroy event that invokes onSimulatorDestroy
+  ns3::EventId m_destroyEvent;
 };
 
 } // namespace scheduler
@@ -23,7 +23,11 @@
 #define BOOST_TEST_DYN_LINK 1
 #define BOOST_TEST_MODULE ndn-cxx Encoding Benchmark
 
+#include "data.hpp"
+#include "dmif-header.hpp"
 #include "encoding/tlv.hpp"
+#include "interest.hpp"
+#include "security/signature-sha256-with-rsa.hpp"
 
 #include "boost-test.hpp"
 #include "timed-execute.hpp"
@@ -135,4 +139,118 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(ReadVarNumber, Test, ReadVarNumberTests)
 
 } // namespace tests
 } // namespace tlv
+
+namespace tests {
+
+enum class DmifLayout {
+  NONE, ///< packet from a non-DMIF node
+  LEGACY,
+  COMPACT
+};
+
+static std::ostream&
+operator<<(std::ostream& os, DmifLayout layout)
+{
+  switch (layout) {
+    case DmifLayout::NONE:
+      return os << "none";
+    case DmifLayout::LEGACY:
+      return os << "legacy";
+    case DmifLayout::COMPACT:
+      return os << "compact";
+  }
+  return os;
+}
+
+/** \brief encode a packet made by \p makePacket with DMIF fields in \p layout
+ *  \return an unparsed copy of the encoding, as received from a face
+ */
+template<typename F>
+static Block
+encodeDmifPacket(DmifLayout layout, const F& makePacket)
+{
+  dmif::setWireFormat(layout == DmifLayout::COMPACT ? dmif::WireFormat::COMPACT :
+                                                      dmif::WireFormat::LEGACY);
+  Block wire = makePacket().wireEncode();
+  dmif::setWireFormat(dmif::WireFormat::COMPACT);
+
+  if (layout == DmifLayout::NONE) {
+    wire.parse();
+    for (uint32_t type : {tlv::ForwarderId, tlv::ForwardingMode, tlv::ResidualEnergy,
+                          tlv::InitialHop, tlv::IdsList}) {
+      wire.remove(type);
+    }
+    wire.encode();
+  }
+  return Block(wire.wire(), wire.size());
+}
+
+const DmifLayout DMIF_LAYOUTS[] = {DmifLayout::NONE, DmifLayout::LEGACY, DmifLayout::COMPACT};
+
+// Benchmark of Interest::wireDecode with and without DMIF fields.
+// Run this benchmark with:
+//    ./encoding-benchmark -t DecodeDmifInterest
+BOOST_AUTO_TEST_CASE(DecodeDmifInterest)
+{
+  const int N_ITERATIONS = 5000000;
+
+  for (DmifLayout layout : DMIF_LAYOUTS) {
+    Block wire = encodeDmifPacket(layout, [] {
+      Interest interest("/example/testApp/randomData/%FD%00%00%01");
+      interest.setNonce(0x8d1f7b32);
+      interest.setInterestLifetime(2_s);
+      interest.setForwarderId(17);
+      interest.setForwardingMode(ForwardingMode::Directive);
+      return interest;
+    });
+    uint32_t expectedForwarderId = layout == DmifLayout::NONE ? 0 : 17;
+
+    int nCorrects = 0;
+    auto d = timedExecute([&] {
+      for (int i = 0; i < N_ITERATIONS; ++i) {
+        Interest interest(wire);
+        nCorrects += interest.getForwarderId() == expectedForwarderId;
+      }
+    });
+    BOOST_CHECK_EQUAL(nCorrects, N_ITERATIONS);
+    std::cout << "layout=" << layout << " size=" << wire.size() << " " << d << std::endl;
+  }
+}
+
+// Benchmark of Data::wireDecode with and without DMIF fields.
+// Run this benchmark with:
+//    ./encoding-benchmark -t DecodeDmifData
+BOOST_AUTO_TEST_CASE(DecodeDmifData)
+{
+  const int N_ITERATIONS = 2000000;
+
+  for (DmifLayout layout : DMIF_LAYOUTS) {
+    Block wire = encodeDmifPacket(layout, [] {
+      Data data("/example/testApp/randomData/%FD%00%00%01");
+      data.setFreshnessPeriod(10_s);
+      std::vector<uint8_t> content(1024, 0xbb);
+      data.setContent(content.data(), content.size());
+      data.setSignature(SignatureSha256WithRsa());
+      data.setSignatureValue(Block(tlv::SignatureValue, make_shared<Buffer>(256)));
+      data.setResidualEnergy(8500);
+      data.setInitialHop(3);
+      data.setForwarderId(17);
+      data.setIdsList({3, 8, 12, 17});
+      return data;
+    });
+    size_t expectedIdsListSize = layout == DmifLayout::NONE ? 0 : 4;
+
+    int nCorrects = 0;
+    auto d = timedExecute([&] {
+      for (int i = 0; i < N_ITERATIONS; ++i) {
+        Data data(wire);
+        nCorrects += data.getIdsList().size() == expectedIdsListSize;
+      }
+    });
+    BOOST_CHECK_EQUAL(nCorrects, N_ITERATIONS);
+    std::cout << "layout=" << layout << " size=" << wire.size() << " " << d << std::endl;
+  }
+}
+
+} // namespace tests
 } // namespace ndn
@@ -24,6 +24,7 @@
 #define BOOST_TEST_MODULE ndn-cxx Scheduler Benchmark
 
 #include "util/scheduler.hpp"
+#include "util/time-custom-clock.hpp"
 
 #include "boost-test.hpp"
 #include "timed-execute.hpp"
@@ -38,56 +39,120 @@ namespace tests {
 
 using namespace ndn::tests;
 
-BOOST_AUTO_TEST_CASE(ScheduleCancel)
+/** \brief steady clock that follows the ns-3 simulation time, as it does in a simulation
+ */
+class SimulatorSteadyClock : public time::CustomSteadyClock
+{
+public:
+  time::steady_clock::time_point
+  getNow() const final
+  {
+    auto sinceStart = time::nanoseconds(ns3::Simulator::Now().GetNanoSeconds());
+    return time::steady_clock::time_point(sinceStart);
+  }
+
+  std::string
+  getSince() const final
+  {
+    return " since start of simulation";
+  }
+
+  time::steady_clock::duration
+  toWaitDuration(time::steady_clock::duration d) const final
+  {
+    return d;
+  }
+};
+
+class SchedulerBenchmarkFixture
 {
+public:
+  SchedulerBenchmarkFixture()
+  {
+    time::setCustomClocks(make_shared<SimulatorSteadyClock>());
+  }
+
+  ~SchedulerBenchmarkFixture()
+  {
+    ns3::Simulator::Destroy();
+    time::setCustomClocks(nullptr, nullptr);
+  }
+
+public:
   boost::asio::io_service io;
-  Scheduler sched(io);
+};
 
-  const size_t nEvents = 1000000;
-  std::vector<EventId> eventIds(nEvents);
+static const size_t nEvents = 1000000;
 
-  auto d1 = timedExecute([&] {
-    for (size_t i = 0; i < nEvents; ++i) {
-      eventIds[i] = sched.scheduleEvent(1_s, []{});
-    }
-  });
+static const std::vector<std::pair<Scheduler::Backend, std::string>> BACKENDS{
+  {Scheduler::Backend::SIMULATOR, "simulator"},
+  {Scheduler::Backend::TIMER_WHEEL, "timer-wheel"},
+};
 
-  auto d2 = timedExecute([&] {
+BOOST_FIXTURE_TEST_CASE(ScheduleCancel, SchedulerBenchmarkFixture)
+{
+  for (const auto& backend : BACKENDS) {
+    Scheduler sched(io, backend.first);
+    std::vector<EventId> eventIds(nEvents);
+
+    auto d1 = timedExecute([&] {
+      for (size_t i = 0; i < nEvents; ++i) {
+        eventIds[i] = sched.scheduleEvent(1_s, []{});
+      }
+    });
+
+    auto d2 = timedExecute([&] {
+      for (size_t i = 0; i < nEvents; ++i) {
+        sched.cancelEvent(eventIds[i]);
+      }
+    });
+
+    std::cout << backend.second << ": schedule " << nEvents << " events: " << d1 << std::endl;
+    std::cout << backend.second << ": cancel " << nEvents << " events: " << d2 << std::endl;
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(Execute, SchedulerBenchmarkFixture)
+{
+  for (const auto& backend : BACKENDS) {
+    Scheduler sched(io, backend.first);
+    size_t nExpired = 0;
+
+    // all events are outstanding when the simulation starts, and expire over 4 seconds
     for (size_t i = 0; i < nEvents; ++i) {
-      sched.cancelEvent(eventIds[i]);
+      sched.scheduleEvent(1_s + time::microseconds(i * 4000000 / nEvents), [&] { ++nExpired; });
     }
-  });
 
-  std::cout << "schedule " << nEvents << " events: " << d1 << std::endl;
-  std::cout << "cancel " << nEvents << " events: " << d2 << std::endl;
-}
+    auto d = timedExecute([] { ns3::Simulator::Run(); });
 
-BOOST_AUTO_TEST_CASE(Execute)
-{
-  boost::asio::io_service io;
-  Scheduler sched(io);
-
-  const size_t nEvents = 1000000;
-  size_t nExpired = 0;
-
-  // Events should expire at t1, but execution finishes at t2. The difference is the overhead.
-  time::steady_clock::TimePoint t1 = time::steady_clock::now() + 5_s;
-  time::steady_clock::TimePoint t2;
-  // +1ms ensures this extra event is executed last. In case the overhead is less than 1ms,
-  // it will be reported as 1ms.
-  sched.scheduleEvent(t1 - time::steady_clock::now() + 1_ms, [&] {
-    t2 = time::steady_clock::now();
     BOOST_REQUIRE_EQUAL(nExpired, nEvents);
-  });
-
-  for (size_t i = 0; i < nEvents; ++i) {
-    sched.scheduleEvent(t1 - time::steady_clock::now(), [&] { ++nExpired; });
+    std::cout << backend.second << ": execute " << nEvents << " events: " << d << std::endl;
   }
+}
 
-  io.run();
+BOOST_FIXTURE_TEST_CASE(ScheduleCancelExecute, SchedulerBenchmarkFixture)
+{
+  for (const auto& backend : BACKENDS) {
+    Scheduler sched(io, backend.first);
+    size_t nExpired = 0;
+
+    // typical of retransmission timers: every event is rescheduled twice before it expires
+    std::vector<EventId> eventIds(nEvents);
+    auto d = timedExecute([&] {
+      for (size_t round = 0; round < 3; ++round) {
+        for (size_t i = 0; i < nEvents; ++i) {
+          sched.cancelEvent(eventIds[i]);
+          eventIds[i] = sched.scheduleEvent(time::milliseconds(1000 + i % 1000 + round * 100),
+                                            [&] { ++nExpired; });
+        }
+      }
+      ns3::Simulator::Run();
+    });
 
-  BOOST_REQUIRE_EQUAL(nExpired, nEvents);
-  std::cout << "execute " << nEvents << " events: " << (t2 - t1) << std::endl;
+    BOOST_REQUIRE_EQUAL(nExpired, nEvents);
+    std::cout << backend.second << ": schedule and cancel " << 3 * nEvents << " events, execute "
+              << nEvents << " events: " << d << std::endl;
+  }
 }
 
 } // namespace tests
@@ -27,13 +27,17 @@
 namespace ndn {
 namespace tests {
 
+/** \brief measure the wall clock time taken by \p f
+ *
+ *  The base steady clock is used, so that the measurement is not affected by a custom clock.
+ */
 template<typename F>
 time::nanoseconds
 timedExecute(const F& f)
 {
-  auto before = time::steady_clock::now();
+  auto before = boost::chrono::steady_clock::now();
   f();
-  auto after = time::steady_clock::now();
+  auto after = boost::chrono::steady_clock::now();
   return after - before;
 }
 
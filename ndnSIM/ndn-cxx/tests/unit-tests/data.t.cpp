@@ -223,6 +223,27 @@ BOOST_FIXTURE_TEST_CASE(Decode, DataSigningKeyFixture)
   BOOST_CHECK_EQUAL(keyLocator.getName().toUri(), "/test/key/locator");
 
   BOOST_CHECK(security::verifySignature(d, m_pubKey));
+
+  // DATA1 has no DMIF fields
+  BOOST_CHECK_EQUAL(d.getResidualEnergy(), 0);
+  BOOST_CHECK_EQUAL(d.getInitialHop(), 0);
+  BOOST_CHECK_EQUAL(d.getForwarderId(), 0);
+  BOOST_CHECK(d.getIdsList().empty());
+}
+
+BOOST_AUTO_TEST_CASE(DecodeMissingSignatureValue)
+{
+  Block dataBlock(DATA1, sizeof(DATA1));
+  Data d(dataBlock);
+
+  Block withoutValue = dataBlock;
+  withoutValue.parse();
+  withoutValue.remove(tlv::SignatureValue);
+  withoutValue.encode();
+
+  // the SignatureValue of an earlier decode is not kept
+  BOOST_CHECK_THROW(d.wireDecode(withoutValue), tlv::Error);
+  BOOST_CHECK_THROW(Data{withoutValue}, tlv::Error);
 }
 
 BOOST_FIXTURE_TEST_CASE(FullName, IdentityManagementFixture)
@@ -254,6 +275,43 @@ BOOST_FIXTURE_TEST_CASE(FullName, IdentityManagementFixture)
     "sha256digest=28bad4b5275bd392dbb670c75cf0b66f13f7942b21e80f55c0e86b374753a548");
 }
 
+BOOST_AUTO_TEST_CASE(ModifyDmifFields)
+{
+  Data d("/A");
+  d.setSignature(SignatureSha256WithRsa());
+  d.setSignatureValue(Block(tlv::SignatureValue));
+  d.setResidualEnergy(100);
+  d.setInitialHop(2);
+  Block wire1 = d.wireEncode();
+  Name fullName1 = d.getFullName();
+
+  // unchanged Data reuses its encoding
+  d.setResidualEnergy(100);
+  d.setInitialHop(2);
+  BOOST_CHECK(d.wireEncode().getBuffer() == wire1.getBuffer());
+
+  d.setResidualEnergy(90);
+  d.setInitialHop(3);
+  d.setForwarderId(7);
+  BOOST_CHECK(d.hasWire());
+  Block wire2 = d.wireEncode();
+  BOOST_CHECK(wire2.getBuffer() != wire1.getBuffer());
+  BOOST_CHECK_NE(d.getFullName(), fullName1);
+
+  Data d2(wire2);
+  BOOST_CHECK_EQUAL(d2.getName(), "/A");
+  BOOST_CHECK_EQUAL(d2.getResidualEnergy(), 90);
+  BOOST_CHECK_EQUAL(d2.getInitialHop(), 3);
+  BOOST_CHECK_EQUAL(d2.getForwarderId(), 7);
+  BOOST_CHECK_EQUAL(d2.getFullName(), d.getFullName());
+
+  // the earlier encoding is not modified
+  Data d1(wire1);
+  BOOST_CHECK_EQUAL(d1.getResidualEnergy(), 100);
+  BOOST_CHECK_EQUAL(d1.getInitialHop(), 2);
+  BOOST_CHECK_EQUAL(d1.getForwarderId(), 0);
+}
+
 // ---- operators ----
 
 BOOST_AUTO_TEST_CASE(Equality)
@@ -0,0 +1,262 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "dmif-header.hpp"
+#include "data.hpp"
+#include "interest.hpp"
+#include "security/signature-sha256-with-rsa.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace dmif {
+namespace tests {
+
+/** \brief selects a wire format for the lifetime of the fixture
+ */
+class WireFormatFixture
+{
+public:
+  ~WireFormatFixture()
+  {
+    setWireFormat(WireFormat::COMPACT);
+  }
+};
+
+BOOST_AUTO_TEST_SUITE(TestDmifHeader)
+
+BOOST_AUTO_TEST_CASE(EncodeDecodeFull)
+{
+  const uint8_t WIRE[] = {
+    0xc8, 0x0b, // DmifHeader
+          0x3e, // Flags: all fields present, ForwardingMode=2
+          0x07, // ForwarderId
+          0xfd, 0x01, 0x2c, // ResidualEnergy=300
+          0x02, // InitialHop
+          0x04, // IdsList count
+                0x0a, // 5
+                0x06, // +3
+                0x03, // -2
+                0x00 // +0
+  };
+
+  Header h1;
+  h1.forwardingMode = 2;
+  h1.forwarderId = 7;
+  h1.residualEnergy = 300;
+  h1.initialHop = 2;
+  h1.idsList = {5, 8, 6, 6};
+
+  EncodingBuffer encoder;
+  h1.wireEncode(encoder);
+  Block wire1 = encoder.block();
+  BOOST_CHECK_EQUAL_COLLECTIONS(wire1.begin(), wire1.end(), WIRE, WIRE + sizeof(WIRE));
+
+  Header h2(wire1);
+  BOOST_CHECK_EQUAL(h2.forwardingMode, 2);
+  BOOST_CHECK_EQUAL(h2.forwarderId, 7);
+  BOOST_CHECK_EQUAL(h2.residualEnergy, 300);
+  BOOST_CHECK_EQUAL(h2.initialHop, 2);
+  BOOST_CHECK_EQUAL_COLLECTIONS(h2.idsList.begin(), h2.idsList.end(),
+                                h1.idsList.begin(), h1.idsList.end());
+}
+
+BOOST_AUTO_TEST_CASE(OmittedFields)
+{
+  Header h1;
+  h1.forwardingMode = 1;
+  EncodingBuffer encoder;
+  h1.wireEncode(encoder);
+  Block wire = encoder.block();
+  BOOST_CHECK_EQUAL(wire.size(), 3);
+  BOOST_CHECK_EQUAL(wire.value()[0], 0x01);
+
+  Header h2;
+  h2.forwarderId = 9;
+  h2.idsList = {1, 2};
+  h2.wireDecode(wire);
+  BOOST_CHECK_EQUAL(h2.forwardingMode, 1);
+  BOOST_CHECK_EQUAL(h2.forwarderId, 0);
+  BOOST_CHECK_EQUAL(h2.residualEnergy, 0);
+  BOOST_CHECK_EQUAL(h2.initialHop, 0);
+  BOOST_CHECK(h2.idsList.empty());
+}
+
+BOOST_AUTO_TEST_CASE(EscapedMode)
+{
+  Header h1;
+  h1.forwardingMode = 1000;
+  EncodingBuffer encoder;
+  h1.wireEncode(encoder);
+
+  Header h2(encoder.block());
+  BOOST_CHECK_EQUAL(h2.forwardingMode, 1000);
+}
+
+BOOST_AUTO_TEST_CASE(NegativeIds)
+{
+  Header h1;
+  h1.idsList = {-1, std::numeric_limits<int>::max(), std::numeric_limits<int>::min(), 0};
+  EncodingBuffer encoder;
+  h1.wireEncode(encoder);
+
+  Header h2(encoder.block());
+  BOOST_CHECK_EQUAL_COLLECTIONS(h2.idsList.begin(), h2.idsList.end(),
+                                h1.idsList.begin(), h1.idsList.end());
+}
+
+BOOST_AUTO_TEST_CASE(DecodeMalformed)
+{
+  // wrong type
+  const uint8_t WRONG_TYPE[] = {0xc9, 0x01, 0x00};
+  BOOST_CHECK_THROW(Header(Block(WRONG_TYPE, sizeof(WRONG_TYPE))), Header::Error);
+
+  // missing Flags
+  const uint8_t NO_FLAGS[] = {0xc8, 0x00};
+  BOOST_CHECK_THROW(Header(Block(NO_FLAGS, sizeof(NO_FLAGS))), Header::Error);
+
+  // ForwarderId announced but missing
+  const uint8_t NO_FORWARDER_ID[] = {0xc8, 0x01, 0x04};
+  BOOST_CHECK_THROW(Header(Block(NO_FORWARDER_ID, sizeof(NO_FORWARDER_ID))), Header::Error);
+
+  // ResidualEnergy does not fit in 32 bits
+  const uint8_t BIG_ENERGY[] = {0xc8, 0x0a, 0x08, 0xff, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00};
+  BOOST_CHECK_THROW(Header(Block(BIG_ENERGY, sizeof(BIG_ENERGY))), Header::Error);
+
+  // IdsList count exceeds the remaining octets
+  const uint8_t SHORT_IDS[] = {0xc8, 0x04, 0x20, 0x03, 0x02, 0x02};
+  BOOST_CHECK_THROW(Header(Block(SHORT_IDS, sizeof(SHORT_IDS))), Header::Error);
+}
+
+BOOST_AUTO_TEST_CASE(PeekForwarderId)
+{
+  Interest interest("/A");
+  interest.setNonce(1);
+  interest.setForwarderId(300);
+  interest.setForwardingMode(1000);
+  Block wire = interest.wireEncode();
+  wire.parse();
+
+  uint32_t forwarderId = 0;
+  BOOST_CHECK(peekForwarderId(wire, forwarderId));
+  BOOST_CHECK_EQUAL(forwarderId, 300);
+
+  interest.setForwarderId(0);
+  wire = interest.wireEncode();
+  wire.parse();
+  BOOST_CHECK(!peekForwarderId(wire, forwarderId));
+}
+
+BOOST_FIXTURE_TEST_SUITE(LegacyWireFormat, WireFormatFixture)
+
+BOOST_AUTO_TEST_CASE(Interest)
+{
+  setWireFormat(WireFormat::LEGACY);
+  ndn::Interest i1("/A");
+  i1.setNonce(1);
+  i1.setForwarderId(5);
+  i1.setForwardingMode(2);
+  Block wire1 = i1.wireEncode();
+  wire1.parse();
+  BOOST_CHECK(wire1.find(tlv::DmifHeader) == wire1.elements_end());
+  BOOST_CHECK(wire1.find(tlv::ForwarderId) != wire1.elements_end());
+
+  uint32_t forwarderId = 0;
+  BOOST_CHECK(peekForwarderId(wire1, forwarderId));
+  BOOST_CHECK_EQUAL(forwarderId, 5);
+
+  setWireFormat(WireFormat::COMPACT);
+  ndn::Interest i2(wire1);
+  BOOST_CHECK_EQUAL(i2.getForwarderId(), 5);
+  BOOST_CHECK_EQUAL(i2.getForwardingMode(), 2);
+
+  // a legacy encoding is rewritten in its own format
+  i2.setForwarderId(6);
+  Block wire2 = i2.wireEncode();
+  BOOST_CHECK_EQUAL(wire2.size(), wire1.size());
+  BOOST_CHECK_EQUAL(ndn::Interest(wire2).getForwarderId(), 6);
+
+  // while a new Interest uses the compact format
+  ndn::Interest i3("/A");
+  i3.setNonce(1);
+  i3.setForwarderId(5);
+  i3.setForwardingMode(2);
+  BOOST_CHECK_EQUAL(i3.wireEncode().size() + 12, wire1.size());
+}
+
+BOOST_AUTO_TEST_CASE(Data)
+{
+  setWireFormat(WireFormat::LEGACY);
+  ndn::Data d1("/A");
+  d1.setSignature(SignatureSha256WithRsa());
+  d1.setSignatureValue(Block(tlv::SignatureValue));
+  d1.setResidualEnergy(100);
+  d1.setInitialHop(2);
+  d1.setForwarderId(7);
+  d1.setIdsList({3, 1, 4});
+  Block wire1 = d1.wireEncode();
+  wire1.parse();
+  BOOST_CHECK(wire1.find(tlv::DmifHeader) == wire1.elements_end());
+
+  setWireFormat(WireFormat::COMPACT);
+  ndn::Data d2(wire1);
+  BOOST_CHECK_EQUAL(d2.getResidualEnergy(), 100);
+  BOOST_CHECK_EQUAL(d2.getInitialHop(), 2);
+  BOOST_CHECK_EQUAL(d2.getForwarderId(), 7);
+  std::vector<int> ids = d2.getIdsList();
+  std::vector<int> expectedIds{3, 1, 4};
+  BOOST_CHECK_EQUAL_COLLECTIONS(ids.begin(), ids.end(), expectedIds.begin(), expectedIds.end());
+
+  ndn::Data d3(d2);
+  d3.setIdsList({3, 1, 4, 1});
+  Block wire3 = d3.wireEncode();
+  wire3.parse();
+  BOOST_CHECK(wire3.find(tlv::DmifHeader) != wire3.elements_end());
+  BOOST_CHECK_LT(wire3.size(), wire1.size());
+  BOOST_CHECK_EQUAL(ndn::Data(wire3).getIdsList().size(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(RewriteField)
+{
+  setWireFormat(WireFormat::LEGACY);
+  ndn::Interest interest("/A");
+  interest.setNonce(1);
+  interest.setForwarderId(5);
+  auto buffer = make_shared<Buffer>(interest.wireEncode().wire(), interest.wireEncode().size());
+  Block wire(buffer);
+  wire.parse();
+
+  BOOST_CHECK(rewriteLegacyField(*buffer, wire, tlv::ForwarderId, 9));
+  BOOST_CHECK_EQUAL(ndn::Interest(wire).getForwarderId(), 9);
+  BOOST_CHECK_EQUAL(wire.size(), interest.wireEncode().size());
+
+  // missing element, or a value that is not 4 octets long
+  BOOST_CHECK(!rewriteLegacyField(*buffer, wire, tlv::InitialHop, 1));
+  BOOST_CHECK(!rewriteLegacyField(*buffer, wire, tlv::Name, 1));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // LegacyWireFormat
+
+BOOST_AUTO_TEST_SUITE_END() // TestDmifHeader
+
+} // namespace tests
+} // namespace dmif
+} // namespace ndn
@@ -160,6 +160,25 @@ BOOST_AUTO_TEST_CASE(DecodeBadNonce)
   BOOST_CHECK_THROW(i.wireDecode(b), tlv::Error);
 }
 
+BOOST_AUTO_TEST_CASE(DecodeNoDmifFields) // Interest from a non-DMIF node
+{
+  Block b(tlv::Interest);
+  b.push_back(Name("/EdKhwCfOu").wireEncode());
+  b.push_back(makeBinaryBlock(tlv::Nonce, "FISH", 4));
+  b.encode();
+
+  Interest i;
+  i.setForwarderId(3);
+  i.wireDecode(b);
+  BOOST_CHECK_EQUAL(i.getName(), "/EdKhwCfOu");
+  BOOST_CHECK_EQUAL(i.getForwarderId(), 0);
+  BOOST_CHECK_EQUAL(i.getForwardingMode(), static_cast<uint32_t>(ForwardingMode::Flooding));
+
+  b.push_back(makeBinaryBlock(tlv::ForwarderId, "AB", 2));
+  b.encode();
+  BOOST_CHECK_THROW(i.wireDecode(b), tlv::Error);
+}
+
 // ---- matching ----
 
 BOOST_AUTO_TEST_CASE(MatchesData)
@@ -359,6 +378,38 @@ BOOST_AUTO_TEST_CASE(ModifyForwardingHint)
   BOOST_CHECK_EQUAL(i.getForwardingHint(), DelegationList({{1, "/A"}, {2, "/B"}}));
 }
 
+BOOST_AUTO_TEST_CASE(ModifyDmifFields)
+{
+  Interest i("/A");
+  i.setNonce(1);
+  i.setForwarderId(5);
+  i.setForwardingMode(ForwardingMode::Flooding);
+  Block wire1 = i.wireEncode();
+
+  // unchanged Interest reuses its encoding
+  BOOST_CHECK(i.wireEncode().getBuffer() == wire1.getBuffer());
+  i.setForwarderId(5);
+  BOOST_CHECK(i.wireEncode().getBuffer() == wire1.getBuffer());
+
+  i.setForwarderId(9);
+  i.setForwardingMode(ForwardingMode::Directive);
+  BOOST_CHECK(i.hasWire());
+  Block wire2 = i.wireEncode();
+  BOOST_CHECK(wire2.getBuffer() != wire1.getBuffer());
+  BOOST_CHECK_EQUAL(wire2.size(), wire1.size());
+
+  Interest i2(wire2);
+  BOOST_CHECK_EQUAL(i2.getName(), "/A");
+  BOOST_CHECK_EQUAL(i2.getNonce(), 1);
+  BOOST_CHECK_EQUAL(i2.getForwarderId(), 9);
+  BOOST_CHECK_EQUAL(i2.getForwardingMode(), static_cast<uint32_t>(ForwardingMode::Directive));
+
+  // the earlier encoding is not modified
+  Interest i1(wire1);
+  BOOST_CHECK_EQUAL(i1.getForwarderId(), 5);
+  BOOST_CHECK_EQUAL(i1.getForwardingMode(), static_cast<uint32_t>(ForwardingMode::Flooding));
+}
+
 // ---- operators ----
 
 BOOST_AUTO_TEST_CASE(Equality)
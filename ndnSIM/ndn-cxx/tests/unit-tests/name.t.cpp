@@ -22,6 +22,7 @@
 #include "name.hpp"
 
 #include "boost-test.hpp"
+#include <set>
 #include <unordered_map>
 
 namespace ndn {
@@ -429,6 +430,47 @@ BOOST_AUTO_TEST_CASE(UnorderedMap)
   BOOST_CHECK_EQUAL(map[name3], 3);
 }
 
+BOOST_AUTO_TEST_CASE(PrefixHashes)
+{
+  Name name("/A/B/C");
+  Name::PrefixHashes hashes = name.getPrefixHashes();
+  BOOST_REQUIRE_EQUAL(hashes.size(), 4);
+  BOOST_CHECK_EQUAL(hashes[0], 0);
+  BOOST_CHECK_EQUAL(hashes[3], std::hash<Name>()(name));
+  BOOST_CHECK_NE(Name("/AB").getPrefixHashes().back(), Name("/A/B").getPrefixHashes().back());
+
+  // prefixes share the hashes of the full name
+  Name prefix = name.getPrefix(2);
+  BOOST_REQUIRE_EQUAL(prefix.getPrefixHashes().size(), 3);
+  BOOST_CHECK_EQUAL(prefix.getPrefixHashes()[2], hashes[2]);
+  BOOST_CHECK_EQUAL(Name("/A/B").getPrefixHashes()[2], hashes[2]);
+
+  // append extends a computed sequence
+  prefix.append("C");
+  BOOST_CHECK_EQUAL_COLLECTIONS(prefix.getPrefixHashes().begin(), prefix.getPrefixHashes().end(),
+                                hashes.begin(), hashes.end());
+
+  // other modifiers discard it
+  prefix.clear();
+  BOOST_CHECK_EQUAL(prefix.getPrefixHashes().size(), 1);
+  prefix.wireDecode(Name("/A/B/D").wireEncode());
+  BOOST_CHECK_EQUAL(prefix.getPrefixHashes()[2], hashes[2]);
+  BOOST_CHECK_NE(prefix.getPrefixHashes()[3], hashes[3]);
+}
+
+BOOST_AUTO_TEST_CASE(PrefixHashHighBits)
+{
+  // names that differ in one byte spread over the top 7 bits of their hashes
+  std::set<size_t> topBits;
+  for (int i = 0; i < 256; ++i) {
+    uint8_t value = static_cast<uint8_t>(i);
+    Name name("/seq");
+    name.append(name::Component(&value, 1));
+    topBits.insert(name.getPrefixHashes().back() >> (sizeof(size_t) * 8 - 7));
+  }
+  BOOST_CHECK_GE(topBits.size(), 64);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestName
 
 } // namespace tests
@@ -0,0 +1,240 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/detail/timer-wheel.hpp"
+
+#include "boost-test.hpp"
+#include "../../unit-test-time-fixture.hpp"
+
+#include <map>
+#include <random>
+
+namespace ndn {
+namespace util {
+namespace detail {
+namespace tests {
+
+using namespace ndn::tests;
+
+class Entry : public TimerWheelEntry
+{
+public:
+  Entry(time::steady_clock::TimePoint expiry, int id)
+    : TimerWheelEntry(expiry)
+    , id(id)
+  {
+  }
+
+public:
+  int id;
+};
+
+class TimerWheelFixture : public UnitTestTimeFixture
+{
+public:
+  shared_ptr<Entry>
+  insert(time::nanoseconds after, int id)
+  {
+    auto entry = make_shared<Entry>(time::steady_clock::now() + after, id);
+    wheel.insert(entry);
+    return entry;
+  }
+
+  /** \brief advance the clock from one wakeup to the next until \p total has elapsed,
+   *         and pop every expired entry
+   *  \return ids of popped entries, in the order they were popped
+   */
+  std::vector<int>
+  run(time::nanoseconds total)
+  {
+    std::vector<int> ids;
+    auto end = time::steady_clock::now() + total;
+    while (true) {
+      auto now = time::steady_clock::now();
+      while (auto entry = wheel.popExpired(now)) {
+        BOOST_CHECK(entry->getExpiry() <= now);
+        BOOST_CHECK(!entry->isPending());
+        ids.push_back(static_pointer_cast<Entry>(entry)->id);
+      }
+
+      auto next = wheel.getNextExpiry();
+      BOOST_CHECK(next > now);
+      if (next > end) {
+        break;
+      }
+      steadyClock->advance(next - now);
+    }
+    steadyClock->advance(end - time::steady_clock::now());
+    return ids;
+  }
+
+public:
+  TimerWheel wheel;
+};
+
+BOOST_AUTO_TEST_SUITE(Util)
+BOOST_AUTO_TEST_SUITE(Detail)
+BOOST_FIXTURE_TEST_SUITE(TestTimerWheel, TimerWheelFixture)
+
+BOOST_AUTO_TEST_CASE(Empty)
+{
+  BOOST_CHECK(wheel.empty());
+  BOOST_CHECK(wheel.getNextExpiry() == time::steady_clock::TimePoint::max());
+  BOOST_CHECK(wheel.popExpired(time::steady_clock::now()) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(ExpiryOrder)
+{
+  // delays span every level of the wheel and the overflow list
+  insert(time::days(60), 7);
+  insert(90_min, 6);
+  insert(300_s, 5);
+  insert(1500_ms, 4);
+  insert(2_ms, 2);
+  insert(2_ms, 3);
+  insert(500_us, 1);
+  insert(0_ms, 0);
+  BOOST_CHECK_EQUAL(wheel.size(), 8);
+
+  std::vector<int> ids = run(time::days(61));
+  std::vector<int> expectedIds{0, 1, 2, 3, 4, 5, 6, 7};
+  BOOST_CHECK_EQUAL_COLLECTIONS(ids.begin(), ids.end(), expectedIds.begin(), expectedIds.end());
+  BOOST_CHECK(wheel.empty());
+}
+
+BOOST_AUTO_TEST_CASE(ExactExpiry)
+{
+  auto entry = insert(1234567_us, 1);
+  BOOST_CHECK(wheel.popExpired(entry->getExpiry() - 1_ns) == nullptr);
+  BOOST_CHECK(wheel.popExpired(entry->getExpiry()) == entry);
+  BOOST_CHECK(wheel.empty());
+}
+
+BOOST_AUTO_TEST_CASE(Cancel)
+{
+  auto e1 = insert(10_ms, 1);
+  auto e2 = insert(10_ms, 2);
+  auto e3 = insert(10_s, 3);
+  auto e4 = insert(time::days(60), 4);
+  BOOST_CHECK_EQUAL(wheel.size(), 4);
+
+  wheel.cancel(*e2);
+  wheel.cancel(*e3);
+  wheel.cancel(*e4);
+  BOOST_CHECK(!e2->isPending());
+  BOOST_CHECK_EQUAL(wheel.size(), 1);
+
+  // cancelling again has no effect
+  wheel.cancel(*e2);
+  BOOST_CHECK_EQUAL(wheel.size(), 1);
+
+  std::vector<int> ids = run(time::days(61));
+  BOOST_REQUIRE_EQUAL(ids.size(), 1);
+  BOOST_CHECK_EQUAL(ids.front(), 1);
+  BOOST_CHECK(wheel.getNextExpiry() == time::steady_clock::TimePoint::max());
+}
+
+BOOST_AUTO_TEST_CASE(CancelDue)
+{
+  auto e1 = insert(1_ms, 1);
+  auto e2 = insert(1_ms, 2);
+  steadyClock->advance(1_ms);
+  BOOST_CHECK(wheel.popExpired(time::steady_clock::now()) == e1);
+
+  wheel.cancel(*e2);
+  BOOST_CHECK(wheel.empty());
+  BOOST_CHECK(wheel.popExpired(time::steady_clock::now()) == nullptr);
+
+  // once empty, the wheel can be reused
+  auto e3 = insert(5_ms, 3);
+  BOOST_CHECK(wheel.getNextExpiry() <= e3->getExpiry());
+  std::vector<int> ids = run(10_ms);
+  BOOST_REQUIRE_EQUAL(ids.size(), 1);
+  BOOST_CHECK_EQUAL(ids.front(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(Clear)
+{
+  auto e1 = insert(0_ms, 1);
+  auto e2 = insert(10_ms, 2);
+  auto e3 = insert(10_s, 3);
+  wheel.cancel(*e3);
+
+  auto pending = wheel.clear();
+  BOOST_CHECK_EQUAL(pending.size(), 2);
+  BOOST_CHECK(std::find(pending.begin(), pending.end(), e1) != pending.end());
+  BOOST_CHECK(std::find(pending.begin(), pending.end(), e2) != pending.end());
+  BOOST_CHECK(!e1->isPending());
+  BOOST_CHECK(!e2->isPending());
+  BOOST_CHECK(wheel.empty());
+  BOOST_CHECK(run(1_min).empty());
+}
+
+BOOST_AUTO_TEST_CASE(InsertWhileRunning)
+{
+  // entries inserted after the wheel has advanced are placed relative to the current tick
+  insert(200_ms, 1);
+  insert(70_s, 2);
+  BOOST_CHECK_EQUAL(run(100_ms).size(), 0);
+
+  insert(50_ms, 0);
+  insert(69_s, 3);
+  std::vector<int> ids = run(2_min);
+  std::vector<int> expectedIds{0, 1, 3, 2};
+  BOOST_CHECK_EQUAL_COLLECTIONS(ids.begin(), ids.end(), expectedIds.begin(), expectedIds.end());
+}
+
+BOOST_AUTO_TEST_CASE(Random)
+{
+  std::multimap<std::pair<time::steady_clock::TimePoint, int>, shared_ptr<Entry>> expected;
+  std::vector<shared_ptr<Entry>> entries;
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int64_t> delayDist(0, 20000000);
+  std::bernoulli_distribution cancelDist(0.3);
+
+  for (int i = 0; i < 5000; ++i) {
+    auto entry = insert(time::microseconds(delayDist(rng)), i);
+    entries.push_back(entry);
+    if (cancelDist(rng)) {
+      wheel.cancel(*entry);
+    }
+    else {
+      expected.emplace(std::make_pair(entry->getExpiry(), i), entry);
+    }
+  }
+  BOOST_CHECK_EQUAL(wheel.size(), expected.size());
+
+  std::vector<int> ids = run(30_s);
+  std::vector<int> expectedIds;
+  for (const auto& p : expected) {
+    expectedIds.push_back(p.first.second);
+  }
+  BOOST_CHECK_EQUAL_COLLECTIONS(ids.begin(), ids.end(), expectedIds.begin(), expectedIds.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestTimerWheel
+BOOST_AUTO_TEST_SUITE_END() // Detail
+BOOST_AUTO_TEST_SUITE_END() // Util
+
+} // namespace tests
+} // namespace detail
+} // namespace util
+} // namespace ndn
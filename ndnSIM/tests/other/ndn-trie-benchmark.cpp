@@ -0,0 +1,184 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-trie-benchmark.cpp
+
+#include "ns3/core-module.h"
+
+#include "ns3/ndnSIM/model/cs/ndn-content-store.hpp"
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
+#include "ns3/ndnSIM/utils/trie/compact-trie.hpp"
+#include "ns3/ndnSIM/utils/trie/lru-policy.hpp"
+#include "ns3/ndnSIM/utils/trie/trie-with-policy.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+
+namespace ns3 {
+
+/**
+ * This benchmark measures the memory used per entry and the lookup rate of the two trie
+ * backends of the old content store (ContentStoreImpl), trie and compact_trie, with LRU policy.
+ *
+ * Names are generated before the measurement, so the memory of the names themselves is not
+ * counted.  Each backend should be measured in a separate run, so that memory freed by one
+ * does not hide the allocations of the other:
+ *
+ *     ./waf --run "ndn-trie-benchmark --backend=compact --entries=1000000"
+ *     ./waf --run "ndn-trie-benchmark --backend=trie --entries=1000000"
+ *
+ * With --names=flat, names are /prefix/<sequence number>. With --names=deep (default), they
+ * are /site-<i>/app/object-<j>/<segment>, for 64 sites and 1024 objects per site.
+ *
+ * With --stores=N, the entries are spread over N containers, as with one small content store
+ * per node of a large topology:
+ *
+ *     ./waf --run "ndn-trie-benchmark --backend=compact --entries=100000 --stores=10000"
+ */
+class TrieBenchmark {
+public:
+  int
+  run(int argc, char* argv[]);
+
+private:
+  template<template<typename, typename, typename> class Trie>
+  void
+  measure(std::ostream& os);
+
+  ndn::Name
+  makeName(size_t i) const;
+
+private:
+  std::string m_backend = "compact";
+  std::string m_names = "deep";
+  size_t m_nEntries = 100000;
+  size_t m_nLookups = 1000000;
+  size_t m_nStores = 1;
+  std::vector<ndn::Name> m_entries;
+};
+
+ndn::Name
+TrieBenchmark::makeName(size_t i) const
+{
+  ndn::Name name;
+  if (m_names == "flat") {
+    name.append("prefix").appendSequenceNumber(i);
+  }
+  else {
+    name.append("site-" + std::to_string(i % 64))
+      .append("app")
+      .append("object-" + std::to_string((i / 64) % 1024))
+      .appendSegment(i / 65536);
+  }
+  return name;
+}
+
+template<template<typename, typename, typename> class Trie>
+void
+TrieBenchmark::measure(std::ostream& os)
+{
+  typedef ndn::ndnSIM::trie_with_policy<ndn::Name, ndn::ndnSIM::pointer_payload_traits<size_t>,
+                                        ndn::ndnSIM::lru_policy_traits, Trie> Container;
+
+  // payload is not owned by the container and is shared by all entries
+  static size_t payload = 0;
+
+  int64_t initialMemory = MemUsage::Get();
+  std::vector<std::unique_ptr<Container>> stores(m_nStores);
+  for (auto& store : stores) {
+    store.reset(new Container);
+    store->getPolicy().set_max_size(0);
+  }
+
+  // entry i goes to store i % m_nStores
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < m_entries.size(); ++i) {
+    stores[i % m_nStores]->insert(m_entries[i], &payload);
+  }
+  std::chrono::duration<double> insertTime = std::chrono::steady_clock::now() - begin;
+  int64_t memory = MemUsage::Get() - initialMemory;
+
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<size_t> dist(0, m_entries.size() - 1);
+  std::vector<size_t> order(m_nLookups);
+  for (size_t& i : order) {
+    i = dist(rng);
+  }
+
+  size_t nFound = 0;
+  begin = std::chrono::steady_clock::now();
+  for (size_t i : order) {
+    Container& store = *stores[i % m_nStores];
+    nFound += store.deepest_prefix_match(m_entries[i]) != store.end();
+  }
+  std::chrono::duration<double> lookupTime = std::chrono::steady_clock::now() - begin;
+
+  size_t nEntries = 0;
+  for (const auto& store : stores) {
+    nEntries += store->getPolicy().size();
+  }
+
+  os << "Stores:\t" << m_nStores << "\n"
+     << "Entries:\t" << nEntries << "\n"
+     << "Memory per entry:\t" << static_cast<double>(memory) / m_entries.size() << " bytes\n"
+     << "Memory per store:\t" << static_cast<double>(memory) / m_nStores << " bytes\n"
+     << "Inserts per second:\t" << m_entries.size() / insertTime.count() << "\n"
+     << "Lookups per second:\t" << m_nLookups / lookupTime.count() << " (" << nFound
+     << " found)\n";
+}
+
+int
+TrieBenchmark::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("backend", "Trie backend (trie or compact)", m_backend);
+  cmd.AddValue("names", "Name structure (flat or deep)", m_names);
+  cmd.AddValue("entries", "Number of entries", m_nEntries);
+  cmd.AddValue("lookups", "Number of lookups", m_nLookups);
+  cmd.AddValue("stores", "Number of containers the entries are spread over", m_nStores);
+  cmd.Parse(argc, argv);
+  m_nStores = std::max<size_t>(m_nStores, 1);
+
+  m_entries.reserve(m_nEntries);
+  for (size_t i = 0; i < m_nEntries; ++i) {
+    m_entries.push_back(makeName(i));
+    m_entries.back().wireEncode(); // as names of received Data packets
+  }
+
+  std::cout << "Backend:\t" << m_backend << "\nNames:\t" << m_names << "\n";
+  if (m_backend == "trie") {
+    measure<ndn::ndnSIM::trie>(std::cout);
+  }
+  else {
+    measure<ndn::ndnSIM::compact_trie>(std::cout);
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::TrieBenchmark benchmark;
+  return benchmark.run(argc, argv);
+}
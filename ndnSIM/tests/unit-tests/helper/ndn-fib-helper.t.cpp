@@ -18,6 +18,7 @@
  **/
 
 #include "helper/ndn-fib-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
 
 #include "../tests-common.hpp"
 
@@ -97,6 +98,29 @@ BOOST_AUTO_TEST_CASE(Helper4)
   FibHelper::AddRoute(getNode("1"), Name("/prefix"), getNode("2"), 10);
 }
 
+// static void
+// UpdateRoutes(const RouteUpdateBatch& batch);
+BOOST_AUTO_TEST_CASE(Batch)
+{
+  auto prefix = make_shared<Name>("/prefix");
+  auto other = make_shared<Name>("/other");
+  FibHelper::UpdateRoutes({
+      {getNode("1"), prefix, getFace("1", "2"), 5, false},
+      {getNode("1"), other, getFace("1", "2"), 1, false},
+      {getNode("1"), make_shared<Name>("/other"), getFace("1", "2"), 0, true},
+      {getNode("1"), prefix, getFace("1", "2"), 2, false}
+    });
+
+  nfd::Fib& fib = getNode("1")->GetObject<L3Protocol>()->getForwarder()->getFib();
+  BOOST_CHECK(fib.findExactMatch("/other") == nullptr);
+
+  const nfd::fib::Entry* entry = fib.findExactMatch("/prefix");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_REQUIRE_EQUAL(entry->getNextHops().size(), 1);
+  BOOST_CHECK_EQUAL(entry->getNextHops().front().getFace().getId(), getFace("1", "2")->getId());
+  BOOST_CHECK_EQUAL(entry->getNextHops().front().getCost(), 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // AddRoute
 
 BOOST_AUTO_TEST_SUITE_END() // HelperNdnFibHelper
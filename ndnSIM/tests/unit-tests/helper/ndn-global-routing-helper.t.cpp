@@ -18,6 +18,7 @@
  **/
 
 #include "helper/ndn-global-routing-helper.hpp"
+#include "helper/ndn-link-control-helper.hpp"
 
 #include "model/ndn-global-router.hpp"
 #include "model/ndn-l3-protocol.hpp"
@@ -32,9 +33,14 @@
 #include "ns3/point-to-point-module.h"
 #include "ns3/point-to-point-layout-module.h"
 
+#include "helper/boost-graph-ndn-global-routing-helper.hpp"
+
 #include "../tests-common.hpp"
 
 #include <boost/filesystem.hpp>
+#include <boost/graph/dijkstra_shortest_paths.hpp>
+
+#include <set>
 
 namespace ns3 {
 namespace ndn {
@@ -53,6 +59,32 @@ public:
   {
     boost::filesystem::remove(TEST_TOPO_TXT);
   }
+
+  /** \brief names of the nodes on the other side of the next hops of \p prefix on \p nodeName
+   */
+  static std::set<std::string>
+  getNextHopNodes(const std::string& nodeName, const Name& prefix)
+  {
+    Ptr<Node> node = Names::Find<Node>(nodeName);
+    const nfd::fib::Entry* entry = node->GetObject<L3Protocol>()->getForwarder()->getFib()
+                                     .findExactMatch(prefix);
+    std::set<std::string> nodes;
+    if (entry == nullptr) {
+      return nodes;
+    }
+
+    for (const auto& nextHop : entry->getNextHops()) {
+      auto transport = dynamic_cast<NetDeviceTransport*>(nextHop.getFace().getTransport());
+      if (transport == nullptr)
+        continue;
+      Ptr<Channel> channel = transport->GetNetDevice()->GetChannel();
+      Ptr<Node> other = channel->GetDevice(0)->GetNode();
+      if (other == node)
+        other = channel->GetDevice(1)->GetNode();
+      nodes.insert(Names::FindName(other));
+    }
+    return nodes;
+  }
 };
 
 BOOST_FIXTURE_TEST_SUITE(HelperGlobalRoutingHelper, GlobalRoutingHelperFixture)
@@ -147,6 +179,137 @@ BOOST_AUTO_TEST_CASE(CalculateRouteCase2)
   }
 }
 
+BOOST_AUTO_TEST_CASE(IncrementalUpdates)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A3  NA  1 1 1\n"
+        << "B3  NA  80  -40 1\n"
+        << "C3  NA  80  40  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A3      B3  10Mbps    1 1ms 100\n"
+        << "A3      C3  10Mbps    10  1ms 100\n"
+        << "B3      C3  10Mbps    1 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", Names::Find<Node>("C3"));
+
+  ndn::GlobalRoutingHelper::SetRouteCalculationThreads(2);
+  ndn::GlobalRoutingHelper::EnableIncrementalUpdates();
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  using Nodes = std::set<std::string>;
+  BOOST_CHECK(getNextHopNodes("A3", "/prefix") == Nodes{"B3"});
+  BOOST_CHECK(getNextHopNodes("B3", "/prefix") == Nodes{"C3"});
+
+  ndn::LinkControlHelper::FailLinkByName("A3", "B3");
+  BOOST_CHECK(getNextHopNodes("A3", "/prefix") == Nodes{"C3"});
+  BOOST_CHECK(getNextHopNodes("B3", "/prefix") == Nodes{"C3"});
+
+  ndn::LinkControlHelper::FailLinkByName("A3", "C3");
+  BOOST_CHECK(getNextHopNodes("A3", "/prefix").empty());
+
+  ndn::LinkControlHelper::UpLinkByName("A3", "B3");
+  ndn::LinkControlHelper::UpLinkByName("A3", "C3");
+  BOOST_CHECK(getNextHopNodes("A3", "/prefix") == Nodes{"B3"});
+  BOOST_CHECK(getNextHopNodes("B3", "/prefix") == Nodes{"C3"});
+}
+
+BOOST_AUTO_TEST_CASE(EqualCostTies)
+{
+  // all links of a grid have the same metric, so most prefixes have several shortest paths
+  {
+    PointToPointHelper p2p;
+    PointToPointGridHelper grid(4, 4, p2p);
+    grid.BoundingBox(100, 100, 200, 200);
+  }
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    ndnGlobalRoutingHelper.AddOrigins("/prefix/" + std::to_string((*node)->GetId()), *node);
+  }
+
+  ndn::GlobalRoutingHelper::SetRouteCalculationThreads(2);
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  // the next hop of each route is the one chosen by boost::dijkstra_shortest_paths
+  boost::NdnGlobalRouterGraph graph;
+  size_t nRoutes = 0;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
+    boost::DistancesMap distances;
+    dijkstra_shortest_paths(graph, source,
+                            distance_map(boost::ref(distances))
+                              .distance_inf(boost::WeightInf)
+                              .distance_zero(boost::WeightZero)
+                              .distance_compare(boost::WeightCompare())
+                              .distance_combine(boost::WeightCombine()));
+
+    const nfd::Fib& fib = (*node)->GetObject<L3Protocol>()->getForwarder()->getFib();
+    for (const auto& dist : distances) {
+      if (dist.first == source || std::get<0>(dist.second) == nullptr) {
+        continue;
+      }
+
+      for (const auto& prefix : dist.first->GetLocalPrefixes()) {
+        const nfd::fib::Entry* entry = fib.findExactMatch(*prefix);
+        BOOST_REQUIRE(entry != nullptr);
+        BOOST_REQUIRE_EQUAL(entry->getNextHops().size(), 1);
+        const nfd::fib::NextHop& nextHop = entry->getNextHops().front();
+        BOOST_CHECK_EQUAL(&nextHop.getFace(), std::get<0>(dist.second).get());
+        BOOST_CHECK_EQUAL(nextHop.getCost(), std::get<1>(dist.second));
+        ++nRoutes;
+      }
+    }
+  }
+  BOOST_CHECK_EQUAL(nRoutes, 16 * 15);
+}
+
+BOOST_AUTO_TEST_CASE(IncrementalUpdatesReleasedOnDestroy)
+{
+  std::weak_ptr<Face> face;
+  {
+    NodeContainer nodes;
+    nodes.Create(2);
+    PointToPointHelper p2p;
+    NetDeviceContainer devices = p2p.Install(nodes);
+
+    ndn::StackHelper ndnHelper;
+    ndnHelper.InstallAll();
+
+    ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+    ndnGlobalRoutingHelper.InstallAll();
+    ndnGlobalRoutingHelper.AddOrigins("/prefix", nodes.Get(1));
+
+    ndn::GlobalRoutingHelper::EnableIncrementalUpdates();
+    ndn::GlobalRoutingHelper::CalculateRoutes();
+
+    face = nodes.Get(0)->GetObject<L3Protocol>()->getFaceByNetDevice(devices.Get(0));
+    BOOST_REQUIRE(!face.expired());
+  }
+
+  // the shortest paths kept for incremental updates do not keep nodes and faces alive
+  Simulator::Destroy();
+  BOOST_CHECK(face.expired());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -0,0 +1,68 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/bf-controller.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(ModelBfController, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(DuplicateInterest)
+{
+  BFController controller;
+  controller.startInterestTimer();
+
+  controller.checkInterest("/a", 1);
+  BOOST_CHECK(controller.shouldFloodInterest());
+
+  // same name and nonce within the window
+  controller.checkInterest("/a", 1);
+  BOOST_CHECK(!controller.shouldFloodInterest());
+
+  controller.checkInterest("/a", 2);
+  BOOST_CHECK(controller.shouldFloodInterest());
+
+  controller.checkInterest("", 1);
+  BOOST_CHECK(!controller.shouldFloodInterest());
+}
+
+BOOST_AUTO_TEST_CASE(InterestAfterWindow)
+{
+  BFController controller;
+  controller.startInterestTimer();
+  controller.checkInterest("/a", 1);
+
+  bool shouldFloodAfterWindow = false;
+  Simulator::Schedule(controller.m_interestWindow + MilliSeconds(1), [&] {
+      controller.checkInterest("/a", 1);
+      shouldFloodAfterWindow = controller.shouldFloodInterest();
+    });
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+
+  BOOST_CHECK(shouldFloodAfterWindow);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/bf-dedup-table.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(ModelBfDedupTable, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Insert)
+{
+  BFDedupTable table;
+  BOOST_CHECK(!table.contains({"/a", 1}));
+
+  BOOST_CHECK(table.insert({"/a", 1}, MilliSeconds(100)));
+  BOOST_CHECK(table.contains({"/a", 1}));
+  BOOST_CHECK(!table.contains({"/a", 2}));
+  BOOST_CHECK(!table.contains({"/b", 1}));
+  BOOST_CHECK_EQUAL(table.size(), 1);
+
+  table.clear();
+  BOOST_CHECK(!table.contains({"/a", 1}));
+  BOOST_CHECK_EQUAL(table.size(), 0);
+  BOOST_CHECK_EQUAL(table.pendingExpiries(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Duplicate)
+{
+  BFDedupTable table;
+  BOOST_CHECK(table.insert({"/a", 1}, MilliSeconds(100)));
+  BOOST_CHECK(!table.insert({"/a", 1}, MilliSeconds(100)));
+  BOOST_CHECK(table.insert({"/a", 2}, MilliSeconds(100)));
+  BOOST_CHECK_EQUAL(table.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(Expiry)
+{
+  BFDedupTable table;
+  table.insert({"/a", 1}, MilliSeconds(100));
+  table.insert({"/b", 1}, MilliSeconds(300));
+
+  bool isContainedAt50 = false;
+  bool isContainedAt150 = true;
+  size_t sizeAt150 = 0;
+  bool isFreshAt150 = false;
+  bool isRefreshedAt350 = false;
+  size_t sizeAt500 = 1;
+
+  Simulator::Schedule(MilliSeconds(50), [&] { isContainedAt50 = table.contains({"/a", 1}); });
+  Simulator::Schedule(MilliSeconds(150), [&] {
+      isContainedAt150 = table.contains({"/a", 1});
+      sizeAt150 = table.size();
+      // an expired key is accepted again and gets a new window
+      isFreshAt150 = table.insert({"/a", 1}, MilliSeconds(250));
+    });
+  Simulator::Schedule(MilliSeconds(350), [&] { isRefreshedAt350 = table.contains({"/a", 1}); });
+  Simulator::Schedule(MilliSeconds(500), [&] { sizeAt500 = table.size(); });
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+
+  BOOST_CHECK(isContainedAt50);
+  BOOST_CHECK(!isContainedAt150);
+  BOOST_CHECK_EQUAL(sizeAt150, 1); // swept at 100ms
+  BOOST_CHECK(isFreshAt150);
+  BOOST_CHECK(isRefreshedAt350);
+  BOOST_CHECK_EQUAL(sizeAt500, 0);
+  BOOST_CHECK_EQUAL(table.pendingExpiries(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Capacity)
+{
+  BFDedupTable table(3);
+  table.insert({"/a", 1}, Seconds(1));
+  table.insert({"/b", 1}, Seconds(1));
+  table.insert({"/c", 1}, Seconds(1));
+  // seeing /a again makes /b the least recently seen
+  table.insert({"/a", 1}, Seconds(1));
+  table.insert({"/d", 1}, Seconds(1));
+
+  BOOST_CHECK_EQUAL(table.size(), 3);
+  BOOST_CHECK(table.contains({"/a", 1}));
+  BOOST_CHECK(!table.contains({"/b", 1}));
+  BOOST_CHECK(table.contains({"/c", 1}));
+  BOOST_CHECK(table.contains({"/d", 1}));
+}
+
+BOOST_AUTO_TEST_CASE(ExpiryHeapIsBounded)
+{
+  BFDedupTable table(8);
+  for (uint32_t i = 0; i < 1000; ++i) {
+    // refreshes and evictions both leave stale heap items behind
+    table.insert({"/a", 1}, Seconds(1));
+    table.insert({"/n", i}, Seconds(1));
+    BOOST_REQUIRE_LE(table.pendingExpiries(), 2 * table.capacity());
+  }
+  BOOST_CHECK_EQUAL(table.size(), 8);
+  BOOST_CHECK(table.contains({"/a", 1}));
+  BOOST_CHECK(table.contains({"/n", 999}));
+  BOOST_CHECK(!table.contains({"/n", 990}));
+
+  Simulator::Stop(Seconds(2));
+  Simulator::Run();
+  BOOST_CHECK_EQUAL(table.size(), 0);
+  BOOST_CHECK_EQUAL(table.pendingExpiries(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -155,6 +155,28 @@ BOOST_AUTO_TEST_CASE(PrintLpPacket)
   }
 }
 
+BOOST_AUTO_TEST_CASE(Deserialize)
+{
+  Data data("/other/prefix");
+  data.setContent(std::make_shared< ::ndn::Buffer>(1024));
+  ndn::StackHelper::getKeyChain().sign(data);
+  lp::Packet lpPacket(data.wireEncode());
+  Block wire = lpPacket.wireEncode();
+
+  Ptr<Packet> packet = Create<Packet>();
+  packet->AddHeader(BlockHeader(nfd::face::Transport::Packet(Block(wire))));
+
+  BlockHeader header;
+  BOOST_CHECK_EQUAL(packet->PeekHeader(header), wire.size());
+  BOOST_CHECK_EQUAL_COLLECTIONS(header.getBlock().begin(), header.getBlock().end(),
+                                wire.begin(), wire.end());
+  BOOST_CHECK_EQUAL(packet->GetSize(), wire.size()); // PeekHeader leaves the packet intact
+
+  // truncated frame
+  Ptr<Packet> truncated = Create<Packet>(wire.wire(), wire.size() - 1);
+  BOOST_CHECK_THROW(truncated->PeekHeader(header), ::ndn::tlv::Error);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
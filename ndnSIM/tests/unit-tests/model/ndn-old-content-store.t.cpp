@@ -18,11 +18,25 @@
  **/
 
 
+#include "ns3/ndnSIM/NFD/daemon/face/face.hpp"
+#include "ns3/ndnSIM/apps/ndn-app.hpp"
+
+#include <ndn-cxx/lp/tags.hpp>
+
+#include <set>
+
 #include "../tests-common.hpp"
 
 namespace ns3 {
 namespace ndn {
 
+static void
+recordData(std::vector<const Data*>* received, shared_ptr<const Data> data, Ptr<App>,
+           shared_ptr<Face>)
+{
+  received->push_back(data.get());
+}
+
 BOOST_FIXTURE_TEST_SUITE(ModelNdnOldContentStore, ScenarioHelperWithCleanupFixture)
 
 BOOST_AUTO_TEST_CASE(RandomPolicy)
@@ -67,6 +81,60 @@ BOOST_AUTO_TEST_CASE(RandomPolicy)
   BOOST_CHECK(entries["1"] != entries["2"]); // this test has a small chance of failing
 }
 
+BOOST_AUTO_TEST_CASE(HitsDoNotRetagCachedData)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::QueueBase::MaxPackets", UintegerValue(20));
+
+  getStackHelper().SetOldContentStore("ns3::ndn::cs::Lru", "MaxSize", "100");
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  // the second consumer asks for the same Data, which node 1 serves from its CS
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}, {"MaxSeq", "10"}},
+          "0s", "2s"},
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}, {"MaxSeq", "10"}},
+          "3s", "5s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  std::vector<const Data*> hits;
+  getNode("1")->GetApplication(1)->TraceConnectWithoutContext("ReceivedDatas",
+                                                              MakeBoundCallback(&recordData, &hits));
+
+  Simulator::Stop(Seconds(6));
+  Simulator::Run();
+
+  // cached Data carries no tags of the delivery that filled the CS
+  auto cs = getNode("1")->GetObject<ContentStore>();
+  std::set<const Data*> cached;
+  for (auto it = cs->Begin(); it != cs->End(); it = cs->Next(it)) {
+    shared_ptr<const Data> data = it->GetData();
+    BOOST_CHECK(data->getTag<lp::IncomingFaceIdTag>() == nullptr);
+    BOOST_CHECK(data->getTag<lp::HopCountTag>() == nullptr);
+    cached.insert(data.get());
+  }
+  BOOST_CHECK_EQUAL(cached.size(), 10);
+
+  // and every hit delivers the cached instance itself: no Data is allocated for a hit
+  BOOST_CHECK_EQUAL(hits.size(), 10);
+  for (const Data* data : hits) {
+    BOOST_CHECK(cached.count(data) == 1);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
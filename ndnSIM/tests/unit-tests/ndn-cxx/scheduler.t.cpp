@@ -0,0 +1,210 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ndn-cxx/util/scheduler.hpp>
+
+#include "ns3/ndnSIM/NFD/core/scheduler.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class TimerWheelSchedulerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  TimerWheelSchedulerFixture()
+    : scheduler(io, ::ndn::Scheduler::Backend::TIMER_WHEEL)
+  {
+    createTopology({{"A", "B"}});
+    nodeA = getNode("A")->GetId();
+    nodeB = getNode("B")->GetId();
+  }
+
+  /** \brief schedule an event that records the context it runs in
+   *
+   *  Called in the context of \p node. All events expire at the same time.
+   */
+  void
+  scheduleFromNode(uint32_t node)
+  {
+    events.push_back(scheduler.scheduleEvent(::ndn::time::milliseconds(100), [this, node] {
+      ranEvents.push_back(std::make_pair(node, Simulator::GetContext()));
+    }));
+  }
+
+  /** \brief schedule an event that cancels the event at index \p victim, or all events
+   */
+  void
+  scheduleCancelFromNode(uint32_t node, int victim)
+  {
+    events.push_back(scheduler.scheduleEvent(::ndn::time::milliseconds(100), [this, node, victim] {
+      ranEvents.push_back(std::make_pair(node, Simulator::GetContext()));
+      if (victim < 0) {
+        scheduler.cancelAllEvents();
+      }
+      else {
+        scheduler.cancelEvent(events.at(victim));
+      }
+    }));
+  }
+
+public:
+  boost::asio::io_service io;
+  ::ndn::Scheduler scheduler;
+  uint32_t nodeA;
+  uint32_t nodeB;
+  std::vector<::ndn::EventId> events;
+  /// (node that scheduled the event, context in which it ran)
+  std::vector<std::pair<uint32_t, uint32_t>> ranEvents;
+};
+
+BOOST_FIXTURE_TEST_SUITE(NdnCxxTimerWheelScheduler, TimerWheelSchedulerFixture)
+
+BOOST_AUTO_TEST_CASE(EventContext)
+{
+  Simulator::ScheduleWithContext(nodeA, Seconds(1), &TimerWheelSchedulerFixture::scheduleFromNode,
+                                 this, nodeA);
+  Simulator::ScheduleWithContext(nodeB, Seconds(1), &TimerWheelSchedulerFixture::scheduleFromNode,
+                                 this, nodeB);
+  Simulator::ScheduleWithContext(nodeA, Seconds(1), &TimerWheelSchedulerFixture::scheduleFromNode,
+                                 this, nodeA);
+
+  Simulator::Stop(Seconds(2));
+  Simulator::Run();
+
+  // each event runs in the context of the node that scheduled it, in the order of scheduling
+  BOOST_REQUIRE_EQUAL(ranEvents.size(), 3);
+  BOOST_CHECK_EQUAL(ranEvents[0].first, nodeA);
+  BOOST_CHECK_EQUAL(ranEvents[0].second, nodeA);
+  BOOST_CHECK_EQUAL(ranEvents[1].first, nodeB);
+  BOOST_CHECK_EQUAL(ranEvents[1].second, nodeB);
+  BOOST_CHECK_EQUAL(ranEvents[2].first, nodeA);
+  BOOST_CHECK_EQUAL(ranEvents[2].second, nodeA);
+}
+
+BOOST_AUTO_TEST_CASE(CancelDispatched)
+{
+  // the event of node B, and every event after it, is dispatched to run in its own context;
+  // the event at index 2 is cancelled after it has been dispatched
+  Simulator::ScheduleWithContext(nodeA, Seconds(1), &TimerWheelSchedulerFixture::scheduleFromNode,
+                                 this, nodeA);
+  Simulator::ScheduleWithContext(nodeB, Seconds(1),
+                                 &TimerWheelSchedulerFixture::scheduleCancelFromNode,
+                                 this, nodeB, 2);
+  Simulator::ScheduleWithContext(nodeA, Seconds(1), &TimerWheelSchedulerFixture::scheduleFromNode,
+                                 this, nodeA);
+  Simulator::ScheduleWithContext(nodeA, Seconds(1), &TimerWheelSchedulerFixture::scheduleFromNode,
+                                 this, nodeA);
+
+  Simulator::Stop(Seconds(2));
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(ranEvents.size(), 3);
+  BOOST_CHECK_EQUAL(ranEvents[1].second, nodeB);
+  BOOST_CHECK_EQUAL(ranEvents[2].second, nodeA);
+}
+
+BOOST_AUTO_TEST_CASE(CancelAllDispatched)
+{
+  Simulator::ScheduleWithContext(nodeA, Seconds(1), &TimerWheelSchedulerFixture::scheduleFromNode,
+                                 this, nodeA);
+  Simulator::ScheduleWithContext(nodeB, Seconds(1),
+                                 &TimerWheelSchedulerFixture::scheduleCancelFromNode,
+                                 this, nodeB, -1);
+  Simulator::ScheduleWithContext(nodeA, Seconds(1), &TimerWheelSchedulerFixture::scheduleFromNode,
+                                 this, nodeA);
+
+  Simulator::Stop(Seconds(2));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(ranEvents.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(BackToBackSimulations)
+{
+  int nFirstRuns = 0;
+  int nSecondRuns = 0;
+  Time secondRanAt;
+
+  scheduler.scheduleEvent(::ndn::time::seconds(5), [&] { ++nFirstRuns; });
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+  Simulator::Destroy();
+
+  // an event pending when the simulator was destroyed is dropped, like an ns-3 event,
+  // and the next simulation in the process starts with an empty wheel
+  scheduler.scheduleEvent(::ndn::time::milliseconds(500), [&] {
+    ++nSecondRuns;
+    secondRanAt = Simulator::Now();
+  });
+  Simulator::Stop(Seconds(10));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(nFirstRuns, 0);
+  BOOST_CHECK_EQUAL(nSecondRuns, 1);
+  BOOST_CHECK_EQUAL(secondRanAt, MilliSeconds(500));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+class NfdGlobalTimerWheelFixture : public CleanupFixture
+{
+public:
+  NfdGlobalTimerWheelFixture()
+  {
+    nfd::scheduler::resetGlobalScheduler();
+    nfd::scheduler::setGlobalSchedulerBackend(::ndn::Scheduler::Backend::TIMER_WHEEL);
+  }
+
+  ~NfdGlobalTimerWheelFixture()
+  {
+    nfd::scheduler::setGlobalSchedulerBackend(::ndn::Scheduler::Backend::SIMULATOR);
+    nfd::scheduler::resetGlobalScheduler();
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(NfdGlobalScheduler, NfdGlobalTimerWheelFixture)
+
+BOOST_AUTO_TEST_CASE(BackToBackSimulations)
+{
+  int nFirstRuns = 0;
+  int nSecondRuns = 0;
+
+  nfd::scheduler::ScopedEventId firstEvent = nfd::scheduler::schedule(::ndn::time::seconds(5),
+                                                                      [&] { ++nFirstRuns; });
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+  Simulator::Destroy();
+
+  nfd::scheduler::schedule(::ndn::time::milliseconds(500), [&] { ++nSecondRuns; });
+  Simulator::Stop(Seconds(10));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(nFirstRuns, 0);
+  BOOST_CHECK_EQUAL(nSecondRuns, 1);
+
+  // cancelling an event of the first simulation has no effect on the second one
+  firstEvent.cancel();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
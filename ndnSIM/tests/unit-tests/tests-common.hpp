@@ -22,6 +22,7 @@
 
 #include "ns3/core-module.h"
 #include "model/ndn-global-router.hpp"
+#include "helper/ndn-global-routing-helper.hpp"
 #include "helper/ndn-scenario-helper.hpp"
 
 #include "boost-test.hpp"
@@ -37,6 +38,8 @@ public:
     Simulator::Destroy();
     Names::Clear();
     GlobalRouter::clear();
+    GlobalRoutingHelper::EnableIncrementalUpdates(false);
+    GlobalRoutingHelper::SetRouteCalculationThreads(0);
   }
 };
 
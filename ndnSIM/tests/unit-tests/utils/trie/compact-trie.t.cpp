@@ -0,0 +1,233 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/cs/ndn-content-store.hpp"
+#include "utils/trie/compact-trie.hpp"
+#include "utils/trie/lru-policy.hpp"
+#include "utils/trie/trie-with-policy.hpp"
+
+#include <deque>
+#include <random>
+#include <set>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+template<template<typename, typename, typename> class Trie>
+using NameTrie = trie_with_policy<Name, pointer_payload_traits<Name>, lru_policy_traits, Trie>;
+
+class CompactTrieFixture
+{
+public:
+  CompactTrieFixture()
+  {
+    container.getPolicy().set_max_size(0);
+  }
+
+  void
+  insert(const Name& name)
+  {
+    names.push_back(name);
+    container.insert(name, &names.back());
+  }
+
+  template<class Container>
+  static std::set<Name>
+  getEntries(Container& container)
+  {
+    std::set<Name> entries;
+    typename Container::parent_trie::recursive_iterator item(container.getTrie()), end(0);
+    for (; item != end; item++) {
+      if (item->payload() != nullptr)
+        entries.insert(*item->payload());
+    }
+    return entries;
+  }
+
+public:
+  std::deque<Name> names;
+  NameTrie<compact_trie> container;
+};
+
+struct IsNotExcluded
+{
+  bool
+  operator()(const name::Component& component) const
+  {
+    return component != name::Component("excluded");
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTrieCompactTrie, CompactTrieFixture)
+
+BOOST_AUTO_TEST_CASE(LookupInsideLabel)
+{
+  insert("/a/b/c/d");
+  insert("/a/b/c/e");
+
+  BOOST_CHECK(container.find_exact("/a/b") == container.end());
+  BOOST_CHECK(container.find_exact("/a/b/c") == container.end());
+  BOOST_CHECK(container.find_exact("/a/b/x") == container.end());
+  BOOST_CHECK(container.longest_prefix_match("/a/b/c") == container.end());
+
+  auto item = container.deepest_prefix_match("/a/b");
+  BOOST_REQUIRE(item != container.end());
+  BOOST_CHECK(Name("/a/b").isPrefixOf(*item->payload()));
+  BOOST_CHECK(container.deepest_prefix_match("/a/x") == container.end());
+
+  // lookup stopping inside of the label /a/b/c checks the predicate for component "b"
+  BOOST_CHECK(container.deepest_prefix_match_if_next_level("/a", IsNotExcluded()) !=
+              container.end());
+  insert("/excluded/b");
+  BOOST_CHECK(container.deepest_prefix_match_if_next_level("/", IsNotExcluded()) !=
+              container.end());
+  container.erase("/a/b/c/d");
+  container.erase("/a/b/c/e");
+  BOOST_CHECK(container.deepest_prefix_match_if_next_level("/", IsNotExcluded()) ==
+              container.end());
+  BOOST_CHECK(container.deepest_prefix_match("/") != container.end());
+
+  insert("/a/b");
+  item = container.find_exact("/a/b");
+  BOOST_REQUIRE(item != container.end());
+  BOOST_CHECK_EQUAL(*item->payload(), "/a/b");
+  BOOST_CHECK_EQUAL(*container.longest_prefix_match("/a/b/c/d")->payload(), "/a/b");
+}
+
+BOOST_AUTO_TEST_CASE(Erase)
+{
+  insert("/a/b/c");
+  insert("/a/b");
+  insert("/a/x/y");
+  insert("/a");
+
+  auto item = container.find_exact("/a/b/c");
+  container.erase("/a/b");
+  container.erase("/a");
+  // remaining nodes with payload are not moved
+  BOOST_CHECK(container.find_exact("/a/b/c") == item);
+  BOOST_CHECK_EQUAL(container.getPolicy().size(), 2);
+  BOOST_CHECK(getEntries(container) == std::set<Name>({"/a/b/c", "/a/x/y"}));
+
+  container.erase("/a/x/y");
+  BOOST_CHECK(getEntries(container) == std::set<Name>({"/a/b/c"}));
+  BOOST_CHECK(container.find_exact("/a/b/c") == item);
+
+  container.erase(item);
+  BOOST_CHECK(getEntries(container).empty());
+  BOOST_CHECK(container.deepest_prefix_match("/") == container.end());
+}
+
+BOOST_AUTO_TEST_CASE(ManyChildren)
+{
+  const int N_ENTRIES = 1000;
+  for (int i = 0; i < N_ENTRIES; ++i) {
+    insert(Name("/prefix").appendSequenceNumber(i));
+  }
+  BOOST_CHECK_EQUAL(getEntries(container).size(), N_ENTRIES);
+
+  for (int i = 0; i < N_ENTRIES; i += 2) {
+    container.erase(Name("/prefix").appendSequenceNumber(i));
+  }
+  for (int i = 0; i < N_ENTRIES; ++i) {
+    auto item = container.find_exact(Name("/prefix").appendSequenceNumber(i));
+    BOOST_CHECK_EQUAL(item != container.end(), i % 2 == 1);
+  }
+  BOOST_CHECK_EQUAL(getEntries(container).size(), N_ENTRIES / 2);
+
+  for (int i = 1; i < N_ENTRIES - 2; i += 2) {
+    container.erase(Name("/prefix").appendSequenceNumber(i));
+  }
+  BOOST_CHECK(getEntries(container) ==
+              std::set<Name>({Name("/prefix").appendSequenceNumber(N_ENTRIES - 1)}));
+}
+
+BOOST_AUTO_TEST_CASE(SmallStoreMemory)
+{
+  size_t firstChunkSize = detail::arena::FIRST_CHUNK_SIZE;
+  size_t maxChunkSize = detail::arena::MAX_CHUNK_SIZE;
+
+  insert("/prefix/A");
+  BOOST_CHECK_EQUAL(container.getTrie().get_allocated_size(), firstChunkSize);
+
+  for (int i = 0; i < 100; ++i) {
+    insert(Name("/prefix").appendSequenceNumber(i));
+  }
+  BOOST_CHECK_LT(container.getTrie().get_allocated_size(), maxChunkSize);
+}
+
+BOOST_AUTO_TEST_CASE(SameAsTrie)
+{
+  static const char* COMPONENTS[] = {"a", "b", "c", "excluded", ""};
+
+  std::mt19937 rng(0);
+  auto makeName = [&rng] {
+    Name name;
+    for (size_t length = rng() % 5; length > 0; --length) {
+      if (rng() % 4 == 0)
+        name.appendNumber(rng() % 100);
+      else
+        name.append(COMPONENTS[rng() % 5]);
+    }
+    return name;
+  };
+
+  NameTrie<trie> reference;
+  reference.getPolicy().set_max_size(0);
+
+  for (int i = 0; i < 10000; ++i) {
+    Name name = makeName();
+    switch (rng() % 4) {
+    case 0:
+      names.push_back(name);
+      BOOST_CHECK_EQUAL(container.insert(name, &names.back()).second,
+                        reference.insert(name, &names.back()).second);
+      break;
+    case 1:
+      container.erase(name);
+      reference.erase(name);
+      break;
+    case 2:
+      BOOST_CHECK_EQUAL(container.find_exact(name) == container.end(),
+                        reference.find_exact(name) == reference.end());
+      BOOST_CHECK_EQUAL(container.longest_prefix_match(name) == container.end(),
+                        reference.longest_prefix_match(name) == reference.end());
+      break;
+    case 3:
+      BOOST_CHECK_EQUAL(container.deepest_prefix_match(name) == container.end(),
+                        reference.deepest_prefix_match(name) == reference.end());
+      BOOST_CHECK_EQUAL(container.deepest_prefix_match_if_next_level(name, IsNotExcluded()) ==
+                          container.end(),
+                        reference.deepest_prefix_match_if_next_level(name, IsNotExcluded()) ==
+                          reference.end());
+      break;
+    }
+  }
+
+  BOOST_CHECK(getEntries(container) == getEntries(reference));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndnSIM
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+# -*- Mode: python; py-indent-offset: 4; indent-tabs-mode: nil; coding: utf-8; -*-
+
+"""
+Decoder for the binary DMIF forwarding trace written by DmifTrace.cpp.
+
+Run a scenario with DMIF_TRACE=<file> to produce the trace, then convert it:
+
+    dmif-trace-decode.py trace.bin --format csv -o trace.csv
+    dmif-trace-decode.py trace.bin --format columns -o trace-columns/
+
+The "columns" format writes one raw little-endian array per field plus a
+schema.json describing the dtypes, which numpy/pandas can memory-map directly.
+numpy is used when available and is much faster on large traces; the decoder
+falls back to the struct module otherwise.
+"""
+
+import argparse, json, os, struct, sys
+
+MAGIC = b'DMIFTR01'
+HEADER = struct.Struct('<8sII')
+RECORD = struct.Struct('<qQQIIBB6x')
+
+FIELDS = [
+    ('time', '<i8'),
+    ('nameHash', '<u8'),
+    ('faceId', '<u8'),
+    ('nodeId', '<u4'),
+    ('forwarderId', '<u4'),
+    ('event', 'u1'),
+    ('mode', 'u1'),
+]
+
+EVENTS = {
+    1: 'InterestCsMiss',
+    2: 'DirectiveNotForUs',
+    3: 'PitHitDrop',
+    4: 'ModeNotSetDrop',
+    5: 'ModeSet',
+    6: 'OutgoingInterest',
+    7: 'IncomingData',
+    8: 'OutgoingData',
+    9: 'FibMatch',
+    10: 'FibMiss',
+}
+
+MODES = {0: '', 1: 'Flooding', 2: 'Directive'}
+
+
+def readHeader(f):
+    magic, recordSize, _ = HEADER.unpack(f.read(HEADER.size))
+    if magic != MAGIC:
+        sys.exit('not a DMIF trace (bad magic)')
+    if recordSize != RECORD.size:
+        sys.exit('unsupported record size %d (expected %d)' % (recordSize, RECORD.size))
+
+
+def loadNumpy(path):
+    import numpy
+    dtype = numpy.dtype({'names': [n for n, _ in FIELDS] + ['reserved'],
+                         'formats': [t for _, t in FIELDS] + ['V6']})
+    assert dtype.itemsize == RECORD.size
+    return numpy.fromfile(path, dtype=dtype, offset=HEADER.size)
+
+
+def iterChunks(f):
+    while True:
+        chunk = f.read(RECORD.size * 65536)
+        if not chunk:
+            return
+        usable = len(chunk) - len(chunk) % RECORD.size
+        yield list(RECORD.iter_unpack(chunk[:usable]))
+
+
+def iterStruct(f):
+    for chunk in iterChunks(f):
+        for record in chunk:
+            yield record
+
+
+def writeCsv(path, out, useNames):
+    header = ','.join(n for n, _ in FIELDS)
+    try:
+        records = loadNumpy(path)
+        rows = zip(*[records[n].tolist() for n, _ in FIELDS])
+    except ImportError:
+        f = open(path, 'rb')
+        f.seek(HEADER.size)
+        rows = iterStruct(f)
+
+    out.write(header + '\n')
+    for time, nameHash, faceId, nodeId, forwarderId, event, mode in rows:
+        if useNames:
+            event = EVENTS.get(event, event)
+            mode = MODES.get(mode, mode)
+        out.write('%d,%d,%d,%d,%d,%s,%s\n' % (time, nameHash, faceId, nodeId, forwarderId, event, mode))
+
+
+def columnFileName(name):
+    return '%s.bin' % name
+
+
+def writeColumnsNumpy(path, outDir):
+    import numpy
+    records = loadNumpy(path)
+    for name, _ in FIELDS:
+        numpy.ascontiguousarray(records[name]).tofile(os.path.join(outDir, columnFileName(name)))
+    return int(len(records))
+
+
+def writeColumnsStruct(path, outDir):
+    # one struct format character per field, in RECORD order
+    codes = [RECORD.format[i + 1] for i in range(len(FIELDS))]
+    outputs = [open(os.path.join(outDir, columnFileName(name)), 'wb') for name, _ in FIELDS]
+    rows = 0
+    with open(path, 'rb') as f:
+        f.seek(HEADER.size)
+        for chunk in iterChunks(f):
+            rows += len(chunk)
+            for i, column in enumerate(zip(*chunk)):
+                outputs[i].write(struct.pack('<%d%s' % (len(column), codes[i]), *column))
+    for out in outputs:
+        out.close()
+    return rows
+
+
+def writeColumns(path, outDir):
+    os.makedirs(outDir, exist_ok=True)
+    try:
+        rows = writeColumnsNumpy(path, outDir)
+    except ImportError:
+        rows = writeColumnsStruct(path, outDir)
+
+    schema = {'rows': rows, 'columns': []}
+    for name, dtype in FIELDS:
+        schema['columns'].append({'name': name, 'dtype': dtype, 'file': columnFileName(name)})
+    schema['events'] = EVENTS
+    schema['modes'] = MODES
+    with open(os.path.join(outDir, 'schema.json'), 'w') as f:
+        json.dump(schema, f, indent=2)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode a binary DMIF forwarding trace')
+    parser.add_argument('trace', help='trace file written by DmifTrace')
+    parser.add_argument('--format', choices=['csv', 'columns'], default='csv')
+    parser.add_argument('--numeric', action='store_true',
+                        help='write event and mode as numbers in CSV output')
+    parser.add_argument('-o', '--output', default='-',
+                        help='output file (csv) or directory (columns); default stdout')
+    args = parser.parse_args()
+
+    with open(args.trace, 'rb') as f:
+        readHeader(f)
+
+    if args.format == 'columns':
+        if args.output == '-':
+            sys.exit('--format columns needs an output directory')
+        writeColumns(args.trace, args.output)
+    elif args.output == '-':
+        writeCsv(args.trace, sys.stdout, not args.numeric)
+    else:
+        with open(args.output, 'w') as out:
+            writeCsv(args.trace, out, not args.numeric)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,1009 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef COMPACT_TRIE_H_
+#define COMPACT_TRIE_H_
+
+/// @cond include_hidden
+
+#include "trie.hpp"
+#include "detail/arena.hpp"
+
+#include <boost/assert.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <cstring>
+#include <tuple>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+template<class T, class NonConstT>
+class compact_trie_iterator;
+
+template<class Trie>
+class compact_trie_position;
+
+/**
+ * @brief Path-compressed trie, a drop-in replacement of trie for large containers
+ *
+ * Compared to trie:
+ * - a chain of nodes that have neither payload nor siblings is kept as a single node, whose
+ *   label holds all components of the chain in TLV wire format;
+ * - children are kept in an array of (hash, node) slots, sorted by hash while there are up to
+ *   SORTED_CAPACITY of them and used as an open-addressing hash table otherwise;
+ * - nodes, labels, and child arrays are allocated from an arena owned by the root.
+ *
+ * A node without payload has at least two children (except for the root), so a node is never
+ * removed or moved while it has a payload, and iterators to such nodes remain valid as in trie.
+ * As a lookup can stop in the middle of a label, find() returns the last reached point as a
+ * compact_trie_position instead of a node.
+ */
+template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+class compact_trie : boost::noncopyable {
+public:
+  typedef typename FullKey::value_type Key;
+
+  typedef compact_trie* iterator;
+  typedef const compact_trie* const_iterator;
+
+  typedef compact_trie_iterator<compact_trie, compact_trie> recursive_iterator;
+  typedef compact_trie_iterator<const compact_trie, compact_trie> const_recursive_iterator;
+
+  typedef compact_trie_position<compact_trie> position;
+
+  typedef PayloadTraits payload_traits;
+
+  /**
+   * @brief Create an empty trie
+   *
+   * The arguments are accepted for compatibility with trie and are ignored: the root has an
+   * empty label and child tables are sized automatically.
+   */
+  explicit compact_trie(const Key& /*key*/ = Key(), size_t /*bucketSize*/ = 1,
+                        size_t /*bucketIncrement*/ = 1)
+    : payload_(PayloadTraits::empty_payload)
+    , arena_(new detail::arena)
+    , children_(nullptr)
+    , label_(nullptr)
+    , nChildren_(0)
+    , labelSize_(0)
+    , hash_(0)
+    , capacityLog_(0)
+    , isRoot_(true)
+  {
+  }
+
+  inline ~compact_trie()
+  {
+    payload_ = PayloadTraits::empty_payload; // necessary for smart pointers...
+    if (isRoot_) {
+      clear();
+      delete arena_;
+    }
+  }
+
+  /**
+   * @brief Remove all children of the node
+   */
+  void
+  clear()
+  {
+    detail::arena& arena = get_arena();
+    for (uint32_t i = 0, capacity = get_capacity(); i < capacity; ++i) {
+      if (children_[i].node != nullptr)
+        destroy_subtree(children_[i].node, arena);
+    }
+    arena.deallocate(children_, get_capacity() * sizeof(child_slot));
+    children_ = nullptr;
+    nChildren_ = 0;
+  }
+
+  inline std::pair<iterator, bool>
+  insert(const FullKey& key, typename PayloadTraits::insert_type payload)
+  {
+    detail::arena& arena = get_arena();
+    compact_trie* trieNode = this;
+
+    for (size_t i = 0, nComponents = key.size(); i < nComponents;) {
+      uint32_t hash = hash_component(key[i]);
+      compact_trie* child = trieNode->find_child(hash, key[i]);
+      if (child == nullptr) {
+        child = create_node(arena, trieNode);
+        child->set_label(arena, key, i, nComponents);
+        child->hash_ = hash;
+        trieNode->insert_child(child, arena);
+        trieNode = child;
+        break;
+      }
+
+      uint32_t offset = child->match_label(key, i);
+      if (offset < child->labelSize_) {
+        child = child->split(offset, arena);
+      }
+      trieNode = child;
+    }
+
+    if (trieNode->payload_ == PayloadTraits::empty_payload) {
+      trieNode->payload_ = payload;
+      return std::make_pair(trieNode, true);
+    }
+    else
+      return std::make_pair(trieNode, false);
+  }
+
+  /**
+   * @brief Removes payload (if it exists) and prunes the trie
+   *
+   * The node itself is destroyed if it is left with less than two children.
+   */
+  inline iterator
+  erase()
+  {
+    payload_ = PayloadTraits::empty_payload;
+    return prune();
+  }
+
+  /**
+   * @brief Do exactly as erase, but without erasing the payload
+   *
+   * A node without payload is removed if it has no children, or merged into its only child.
+   *
+   * @returns the node that takes the place of this node in the trie
+   */
+  inline iterator
+  prune()
+  {
+    if (isRoot_ || payload_ != PayloadTraits::empty_payload || nChildren_ > 1)
+      return this;
+
+    detail::arena& arena = get_arena();
+    compact_trie* parent = parent_;
+
+    if (nChildren_ == 0) {
+      parent->erase_child(this, arena);
+      destroy_node(this, arena);
+      return parent->prune();
+    }
+
+    // the only child absorbs the label of this node and takes its place
+    compact_trie* child = children_[get_next_child_index(0)].node;
+    uint8_t* label = static_cast<uint8_t*>(arena.allocate(labelSize_ + child->labelSize_));
+    std::memcpy(label, label_, labelSize_);
+    std::memcpy(label + labelSize_, child->label_, child->labelSize_);
+    arena.deallocate(const_cast<uint8_t*>(child->label_), child->labelSize_);
+    child->label_ = label;
+    child->labelSize_ += labelSize_;
+    child->hash_ = hash_;
+    child->parent_ = parent;
+    parent->replace_child(this, child);
+
+    arena.deallocate(children_, get_capacity() * sizeof(child_slot));
+    children_ = nullptr;
+    nChildren_ = 0;
+    destroy_node(this, arena);
+    return child;
+  }
+
+  /**
+   * @brief Perform the longest prefix match
+   * @param key the key for which to perform the longest prefix match
+   *
+   * @return ->second is true if the whole key has been matched, ->third is the point where
+   *         the match has stopped
+   */
+  inline std::tuple<iterator, bool, position>
+  find(const FullKey& key)
+  {
+    return find_if(key, any_payload());
+  }
+
+  /**
+   * @brief Perform the longest prefix match satisfying predicate
+   * @param key the key for which to perform the longest prefix match
+   *
+   * @return ->second is true if the whole key has been matched, ->third is the point where
+   *         the match has stopped
+   */
+  template<class Predicate>
+  inline std::tuple<iterator, bool, position>
+  find_if(const FullKey& key, Predicate pred)
+  {
+    compact_trie* trieNode = this;
+    iterator foundNode = (payload_ != PayloadTraits::empty_payload && pred(payload_)) ? this : 0;
+
+    for (size_t i = 0, nComponents = key.size(); i < nComponents;) {
+      compact_trie* child = trieNode->find_child(hash_component(key[i]), key[i]);
+      if (child == nullptr)
+        return std::make_tuple(foundNode, false, position(trieNode));
+
+      uint32_t offset = child->match_label(key, i);
+      if (offset < child->labelSize_) {
+        // either the key has ended inside of the label, or they differ
+        return std::make_tuple(foundNode, i == nComponents, position(child, offset));
+      }
+
+      trieNode = child;
+      if (trieNode->payload_ != PayloadTraits::empty_payload && pred(trieNode->payload_)) {
+        foundNode = trieNode;
+      }
+    }
+
+    return std::make_tuple(foundNode, true, position(trieNode));
+  }
+
+  /**
+   * @brief Find next payload of the sub-trie
+   * @returns end() or a valid iterator pointing to the trie leaf (order is not defined, enumeration
+   * )
+   */
+  inline iterator
+  find()
+  {
+    if (payload_ != PayloadTraits::empty_payload)
+      return this;
+
+    for (uint32_t i = 0, capacity = get_capacity(); i < capacity; ++i) {
+      if (children_[i].node != nullptr) {
+        iterator value = children_[i].node->find();
+        if (value != 0)
+          return value;
+      }
+    }
+
+    return 0;
+  }
+
+  /**
+   * @brief Find next payload of the sub-trie satisfying the predicate
+   * @param pred predicate
+   * @returns end() or a valid iterator pointing to the trie leaf (order is not defined, enumeration
+   * )
+   */
+  template<class Predicate>
+  inline iterator
+  find_if(Predicate pred)
+  {
+    if (payload_ != PayloadTraits::empty_payload && pred(payload_))
+      return this;
+
+    for (uint32_t i = 0, capacity = get_capacity(); i < capacity; ++i) {
+      if (children_[i].node != nullptr) {
+        iterator value = children_[i].node->find_if(pred);
+        if (value != 0)
+          return value;
+      }
+    }
+
+    return 0;
+  }
+
+  /**
+   * @brief Find next payload of the sub-trie satisfying the predicate
+   * @param pred predicate
+   *
+   * This version check predicate only for the next level children
+   *
+   * @returns end() or a valid iterator pointing to the trie leaf (order is not defined, enumeration
+   *)
+   */
+  template<class Predicate>
+  inline iterator
+  find_if_next_level(Predicate pred)
+  {
+    for (uint32_t i = 0, capacity = get_capacity(); i < capacity; ++i) {
+      if (children_[i].node != nullptr && pred(children_[i].node->key())) {
+        return children_[i].node->find();
+      }
+    }
+
+    return 0;
+  }
+
+  iterator
+  end()
+  {
+    return 0;
+  }
+
+  const_iterator
+  end() const
+  {
+    return 0;
+  }
+
+  typename PayloadTraits::const_return_type
+  payload() const
+  {
+    return payload_;
+  }
+
+  typename PayloadTraits::return_type
+  payload()
+  {
+    return payload_;
+  }
+
+  void
+  set_payload(typename PayloadTraits::insert_type payload)
+  {
+    payload_ = payload;
+  }
+
+  /**
+   * @brief Get the first name component of the node label (empty for the root)
+   */
+  Key
+  key() const
+  {
+    return get_component(0);
+  }
+
+  /**
+   * @brief Get the number of bytes held by the arena of the trie
+   */
+  size_t
+  get_allocated_size() const
+  {
+    return get_arena().get_allocated_size();
+  }
+
+private:
+  struct child_slot {
+    uint32_t hash;
+    compact_trie* node;
+  };
+
+  struct node_tag {
+  };
+
+  struct any_payload {
+    template<class Payload>
+    bool
+    operator()(const Payload&) const
+    {
+      return true;
+    }
+  };
+
+  static const uint32_t SORTED_CAPACITY = 8;
+  static const uint32_t MIN_TABLE_CAPACITY = 32;
+
+  compact_trie(node_tag, compact_trie* parent)
+    : payload_(PayloadTraits::empty_payload)
+    , parent_(parent)
+    , children_(nullptr)
+    , label_(nullptr)
+    , nChildren_(0)
+    , labelSize_(0)
+    , hash_(0)
+    , capacityLog_(0)
+    , isRoot_(false)
+  {
+  }
+
+  detail::arena&
+  get_arena() const
+  {
+    const compact_trie* trieNode = this;
+    while (!trieNode->isRoot_)
+      trieNode = trieNode->parent_;
+    return *trieNode->arena_;
+  }
+
+  static compact_trie*
+  create_node(detail::arena& arena, compact_trie* parent)
+  {
+    return new (arena.allocate(sizeof(compact_trie))) compact_trie(node_tag(), parent);
+  }
+
+  static void
+  destroy_node(compact_trie* trieNode, detail::arena& arena)
+  {
+    arena.deallocate(trieNode->children_, trieNode->get_capacity() * sizeof(child_slot));
+    arena.deallocate(const_cast<uint8_t*>(trieNode->label_), trieNode->labelSize_);
+    trieNode->~compact_trie();
+    arena.deallocate(trieNode, sizeof(compact_trie));
+  }
+
+  static void
+  destroy_subtree(compact_trie* trieNode, detail::arena& arena)
+  {
+    for (uint32_t i = 0, capacity = trieNode->get_capacity(); i < capacity; ++i) {
+      if (trieNode->children_[i].node != nullptr)
+        destroy_subtree(trieNode->children_[i].node, arena);
+    }
+    destroy_node(trieNode, arena);
+  }
+
+  ////////////////////////////////////////////////
+  // Labels
+  ////////////////////////////////////////////////
+
+  static uint32_t
+  hash_component(uint64_t type, const uint8_t* value, size_t valueSize)
+  {
+    // FNV-1a, followed by the finalizer of MurmurHash3 to spread the low bits,
+    // which index the child table
+    uint32_t hash = 2166136261u;
+    hash = (hash ^ static_cast<uint32_t>(type)) * 16777619u;
+    for (size_t i = 0; i < valueSize; ++i) {
+      hash = (hash ^ value[i]) * 16777619u;
+    }
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    hash ^= hash >> 16;
+    return hash;
+  }
+
+  static uint32_t
+  hash_component(const Key& component)
+  {
+    return hash_component(component.type(), component.value(), component.value_size());
+  }
+
+  /**
+   * @brief Compare the label component at @p begin with @p component
+   * @param [inout] begin position in the label, moved past the component if it matches
+   */
+  static bool
+  match_component(const uint8_t*& begin, const uint8_t* end, const Key& component)
+  {
+    const uint8_t* pos = begin;
+    uint64_t type = ::ndn::tlv::readVarNumber(pos, end);
+    uint64_t length = ::ndn::tlv::readVarNumber(pos, end);
+    if (type != component.type() || length != component.value_size() ||
+        (length > 0 && std::memcmp(pos, component.value(), length) != 0))
+      return false;
+
+    begin = pos + length;
+    return true;
+  }
+
+  static uint8_t*
+  write_var_number(uint8_t* pos, uint64_t number)
+  {
+    size_t nBytes = 0;
+    if (number < 253) {
+      *pos++ = static_cast<uint8_t>(number);
+      return pos;
+    }
+    else if (number <= 0xFFFF) {
+      *pos++ = 253;
+      nBytes = 2;
+    }
+    else if (number <= 0xFFFFFFFF) {
+      *pos++ = 254;
+      nBytes = 4;
+    }
+    else {
+      *pos++ = 255;
+      nBytes = 8;
+    }
+
+    for (size_t i = nBytes; i > 0; --i) {
+      *pos++ = static_cast<uint8_t>(number >> (8 * (i - 1)));
+    }
+    return pos;
+  }
+
+  /**
+   * @brief Set label of a new node to components [first, last) of @p key
+   */
+  void
+  set_label(detail::arena& arena, const FullKey& key, size_t first, size_t last)
+  {
+    size_t size = 0;
+    for (size_t i = first; i < last; ++i) {
+      size += ::ndn::tlv::sizeOfVarNumber(key[i].type()) +
+              ::ndn::tlv::sizeOfVarNumber(key[i].value_size()) + key[i].value_size();
+    }
+
+    uint8_t* label = static_cast<uint8_t*>(arena.allocate(size));
+    uint8_t* pos = label;
+    for (size_t i = first; i < last; ++i) {
+      pos = write_var_number(pos, key[i].type());
+      pos = write_var_number(pos, key[i].value_size());
+      if (key[i].value_size() > 0) {
+        std::memcpy(pos, key[i].value(), key[i].value_size());
+        pos += key[i].value_size();
+      }
+    }
+
+    label_ = label;
+    labelSize_ = size;
+  }
+
+  /**
+   * @brief Match the label against components of @p key starting from @p i
+   * @param [inout] i index of the first component to match, advanced past the matched ones
+   * @return number of label bytes that have been matched
+   */
+  uint32_t
+  match_label(const FullKey& key, size_t& i) const
+  {
+    const uint8_t* pos = label_;
+    const uint8_t* end = label_ + labelSize_;
+    for (size_t nComponents = key.size(); pos != end && i < nComponents; ++i) {
+      if (!match_component(pos, end, key[i]))
+        break;
+    }
+    return pos - label_;
+  }
+
+  /**
+   * @brief Decode the label component at byte @p offset
+   */
+  Key
+  get_component(uint32_t offset) const
+  {
+    if (offset >= labelSize_)
+      return Key();
+
+    const uint8_t* pos = label_ + offset;
+    const uint8_t* end = label_ + labelSize_;
+    ::ndn::tlv::readVarNumber(pos, end);
+    uint64_t length = ::ndn::tlv::readVarNumber(pos, end);
+    return Key(Block(label_ + offset, pos + length - (label_ + offset)));
+  }
+
+  uint32_t
+  hash_label() const
+  {
+    const uint8_t* pos = label_;
+    const uint8_t* end = label_ + labelSize_;
+    uint64_t type = ::ndn::tlv::readVarNumber(pos, end);
+    uint64_t length = ::ndn::tlv::readVarNumber(pos, end);
+    return hash_component(type, pos, length);
+  }
+
+  /**
+   * @brief Split the label at @p offset, inserting a new node for the first part of the label
+   * @return the new node, which is the only child of the old parent and the parent of this node
+   */
+  compact_trie*
+  split(uint32_t offset, detail::arena& arena)
+  {
+    compact_trie* parent = parent_;
+    compact_trie* middle = create_node(arena, parent);
+    uint8_t* head = static_cast<uint8_t*>(arena.allocate(offset));
+    std::memcpy(head, label_, offset);
+    middle->label_ = head;
+    middle->labelSize_ = offset;
+    middle->hash_ = hash_;
+    parent->replace_child(this, middle);
+
+    uint8_t* tail = static_cast<uint8_t*>(arena.allocate(labelSize_ - offset));
+    std::memcpy(tail, label_ + offset, labelSize_ - offset);
+    arena.deallocate(const_cast<uint8_t*>(label_), labelSize_);
+    label_ = tail;
+    labelSize_ -= offset;
+    hash_ = hash_label();
+    parent_ = middle;
+    middle->insert_child(this, arena);
+
+    return middle;
+  }
+
+  ////////////////////////////////////////////////
+  // Children
+  ////////////////////////////////////////////////
+
+  uint32_t
+  get_capacity() const
+  {
+    return children_ == nullptr ? 0 : (1u << capacityLog_);
+  }
+
+  bool
+  is_hash_table() const
+  {
+    return get_capacity() > SORTED_CAPACITY;
+  }
+
+  compact_trie*
+  find_child(uint32_t hash, const Key& component) const
+  {
+    if (nChildren_ == 0)
+      return nullptr;
+
+    if (!is_hash_table()) {
+      for (uint32_t i = 0; i < nChildren_ && children_[i].hash <= hash; ++i) {
+        if (children_[i].hash == hash && children_[i].node->starts_with(component))
+          return children_[i].node;
+      }
+      return nullptr;
+    }
+
+    uint32_t mask = get_capacity() - 1;
+    for (uint32_t i = hash & mask; children_[i].node != nullptr; i = (i + 1) & mask) {
+      if (children_[i].hash == hash && children_[i].node->starts_with(component))
+        return children_[i].node;
+    }
+    return nullptr;
+  }
+
+  bool
+  starts_with(const Key& component) const
+  {
+    const uint8_t* pos = label_;
+    return match_component(pos, label_ + labelSize_, component);
+  }
+
+  uint32_t
+  get_child_index(const compact_trie* child) const
+  {
+    if (!is_hash_table()) {
+      uint32_t i = 0;
+      while (children_[i].node != child)
+        ++i;
+      return i;
+    }
+
+    uint32_t mask = get_capacity() - 1;
+    uint32_t i = child->hash_ & mask;
+    while (children_[i].node != child)
+      i = (i + 1) & mask;
+    return i;
+  }
+
+  /**
+   * @brief Get index of the first occupied child slot at or after @p i
+   * @return index of the slot, or capacity if there is none
+   */
+  uint32_t
+  get_next_child_index(uint32_t i) const
+  {
+    uint32_t capacity = get_capacity();
+    while (i < capacity && children_[i].node == nullptr)
+      ++i;
+    return i;
+  }
+
+  void
+  insert_child(compact_trie* child, detail::arena& arena)
+  {
+    uint32_t capacity = get_capacity();
+    if (capacity <= SORTED_CAPACITY && nChildren_ == capacity) {
+      resize_children(capacity == 0 ? 1 : (capacity == SORTED_CAPACITY ? MIN_TABLE_CAPACITY
+                                                                         : capacity * 2),
+                      arena);
+    }
+    else if (capacity > SORTED_CAPACITY && (nChildren_ + 1) * 4 > capacity * 3) {
+      resize_children(capacity * 2, arena);
+    }
+
+    if (!is_hash_table()) {
+      uint32_t i = nChildren_;
+      for (; i > 0 && children_[i - 1].hash > child->hash_; --i) {
+        children_[i] = children_[i - 1];
+      }
+      children_[i].hash = child->hash_;
+      children_[i].node = child;
+    }
+    else {
+      insert_into_table(children_, get_capacity() - 1, child->hash_, child);
+    }
+    ++nChildren_;
+  }
+
+  void
+  erase_child(compact_trie* child, detail::arena& arena)
+  {
+    uint32_t i = get_child_index(child);
+    --nChildren_;
+
+    if (!is_hash_table()) {
+      for (; i < nChildren_; ++i) {
+        children_[i] = children_[i + 1];
+      }
+      children_[nChildren_].node = nullptr;
+    }
+    else {
+      // backward-shift deletion, so that no probe sequence is broken
+      uint32_t mask = get_capacity() - 1;
+      for (uint32_t j = (i + 1) & mask; children_[j].node != nullptr; j = (j + 1) & mask) {
+        uint32_t home = children_[j].hash & mask;
+        bool canMove = (i <= j) ? (home <= i || home > j) : (home <= i && home > j);
+        if (canMove) {
+          children_[i] = children_[j];
+          i = j;
+        }
+      }
+      children_[i].node = nullptr;
+    }
+
+    if (nChildren_ == 0) {
+      arena.deallocate(children_, get_capacity() * sizeof(child_slot));
+      children_ = nullptr;
+    }
+    else if (is_hash_table() && nChildren_ <= SORTED_CAPACITY / 2) {
+      resize_children(SORTED_CAPACITY, arena);
+    }
+  }
+
+  void
+  replace_child(const compact_trie* oldChild, compact_trie* newChild)
+  {
+    children_[get_child_index(oldChild)].node = newChild;
+  }
+
+  static void
+  insert_into_table(child_slot* table, uint32_t mask, uint32_t hash, compact_trie* child)
+  {
+    uint32_t i = hash & mask;
+    while (table[i].node != nullptr)
+      i = (i + 1) & mask;
+    table[i].hash = hash;
+    table[i].node = child;
+  }
+
+  void
+  resize_children(uint32_t capacity, detail::arena& arena)
+  {
+    child_slot* children = static_cast<child_slot*>(arena.allocate(capacity * sizeof(child_slot)));
+    for (uint32_t i = 0; i < capacity; ++i) {
+      children[i].hash = 0;
+      children[i].node = nullptr;
+    }
+
+    uint32_t oldCapacity = get_capacity();
+    if (capacity > SORTED_CAPACITY) {
+      for (uint32_t i = 0; i < oldCapacity; ++i) {
+        if (children_[i].node != nullptr)
+          insert_into_table(children, capacity - 1, children_[i].hash, children_[i].node);
+      }
+    }
+    else {
+      uint32_t n = 0;
+      for (uint32_t i = 0; i < oldCapacity; ++i) {
+        if (children_[i].node != nullptr)
+          children[n++] = children_[i];
+      }
+      std::sort(children, children + n, [] (const child_slot& a, const child_slot& b) {
+        return a.hash < b.hash;
+      });
+    }
+
+    arena.deallocate(children_, oldCapacity * sizeof(child_slot));
+    children_ = children;
+    capacityLog_ = 0;
+    while ((1u << capacityLog_) < capacity)
+      ++capacityLog_;
+  }
+
+  template<class T, class NonConstT>
+  friend class compact_trie_iterator;
+
+  template<class T>
+  friend class compact_trie_position;
+
+public:
+  PolicyHook policy_hook_;
+
+private:
+  ////////////////////////////////////////////////
+  // Actual data
+  ////////////////////////////////////////////////
+
+  typename PayloadTraits::storage_type payload_;
+  union {
+    compact_trie* parent_;  ///< @brief parent node (all nodes but the root)
+    detail::arena* arena_; ///< @brief allocator of the whole trie (the root)
+  };
+  child_slot* children_;
+  const uint8_t* label_; ///< @brief name components of the node, in TLV wire format
+
+  uint32_t nChildren_;
+  uint32_t labelSize_;
+  uint32_t hash_;       ///< @brief hash of the first label component
+  uint8_t capacityLog_; ///< @brief log2 of the number of child slots
+  bool isRoot_;
+};
+
+/**
+ * @brief Point inside of a compact_trie where a lookup has stopped
+ *
+ * The point is either a node, or a position inside of the node label (in which case it has no
+ * payload, but everything under the node is also under the point). Mimics the node interface
+ * that trie_with_policy needs from the result of find().
+ */
+template<class Trie>
+class compact_trie_position {
+public:
+  typedef typename Trie::iterator iterator;
+  typedef typename Trie::payload_traits payload_traits;
+
+  compact_trie_position()
+    : node_(0)
+    , offset_(0)
+  {
+  }
+
+  explicit compact_trie_position(iterator node)
+    : node_(node)
+    , offset_(node->labelSize_)
+  {
+  }
+
+  compact_trie_position(iterator node, uint32_t offset)
+    : node_(node)
+    , offset_(offset)
+  {
+  }
+
+  /**
+   * @brief Convert to the node, only valid if is_node() or payload() is not empty
+   */
+  operator iterator() const
+  {
+    BOOST_ASSERT(node_ == 0 || is_node());
+    return node_;
+  }
+
+  const compact_trie_position* operator->() const
+  {
+    return this;
+  }
+
+  friend bool
+  operator==(const compact_trie_position& position, iterator node)
+  {
+    return position.node_ == node;
+  }
+
+  friend bool
+  operator!=(const compact_trie_position& position, iterator node)
+  {
+    return position.node_ != node;
+  }
+
+  bool
+  is_node() const
+  {
+    return offset_ == node_->labelSize_;
+  }
+
+  typename payload_traits::return_type
+  payload() const
+  {
+    if (!is_node())
+      return payload_traits::empty_payload;
+    return node_->payload();
+  }
+
+  iterator
+  find() const
+  {
+    return node_->find();
+  }
+
+  template<class Predicate>
+  iterator
+  find_if(Predicate pred) const
+  {
+    return node_->find_if(pred);
+  }
+
+  template<class Predicate>
+  iterator
+  find_if_next_level(Predicate pred) const
+  {
+    if (is_node())
+      return node_->find_if_next_level(pred);
+
+    if (pred(node_->get_component(offset_)))
+      return node_->find();
+    return 0;
+  }
+
+private:
+  iterator node_;
+  uint32_t offset_;
+};
+
+template<class Trie, class NonConstTrie> // hack for boost < 1.47
+class compact_trie_iterator {
+public:
+  compact_trie_iterator()
+    : trie_(0)
+  {
+  }
+  compact_trie_iterator(typename Trie::iterator item)
+    : trie_(item)
+  {
+  }
+  compact_trie_iterator(Trie& item)
+    : trie_(&item)
+  {
+  }
+
+  Trie& operator*()
+  {
+    return *trie_;
+  }
+  const Trie& operator*() const
+  {
+    return *trie_;
+  }
+  Trie* operator->()
+  {
+    return trie_;
+  }
+  const Trie* operator->() const
+  {
+    return trie_;
+  }
+  bool
+  operator==(const compact_trie_iterator& other) const
+  {
+    return (trie_ == other.trie_);
+  }
+  bool
+  operator!=(const compact_trie_iterator& other) const
+  {
+    return !(*this == other);
+  }
+
+  compact_trie_iterator<Trie, NonConstTrie>&
+  operator++(int)
+  {
+    uint32_t i = trie_->get_next_child_index(0);
+    if (i < trie_->get_capacity())
+      trie_ = trie_->children_[i].node;
+    else
+      trie_ = goUp();
+    return *this;
+  }
+
+  compact_trie_iterator<Trie, NonConstTrie>&
+  operator++()
+  {
+    (*this)++;
+    return *this;
+  }
+
+private:
+  Trie*
+  goUp()
+  {
+    while (!trie_->isRoot_) {
+      Trie* parent = trie_->parent_;
+      uint32_t i = parent->get_next_child_index(parent->get_child_index(trie_) + 1);
+      if (i < parent->get_capacity())
+        return parent->children_[i].node;
+      trie_ = parent;
+    }
+    return 0;
+  }
+
+private:
+  Trie* trie_;
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // COMPACT_TRIE_H_
@@ -0,0 +1,165 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef ARENA_H_
+#define ARENA_H_
+
+/// @cond include_hidden
+
+#include <boost/noncopyable.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+namespace detail {
+
+/**
+ * @brief Memory pool for the small blocks of a single container
+ *
+ * Blocks are carved out of chunks and recycled through free lists, one per size class, so
+ * that the nodes of a container are packed together and no per-block malloc header is paid.
+ * Blocks larger than MAX_SMALL_SIZE go directly to operator new.  Chunks are returned to the
+ * system only when the arena is destroyed.
+ *
+ * The first chunk is FIRST_CHUNK_SIZE bytes, and each following chunk is twice as large as
+ * the previous one, up to MAX_CHUNK_SIZE, so that a container with a few entries, such as a
+ * small content store, does not hold a large chunk.
+ */
+class arena : boost::noncopyable {
+public:
+  static const size_t GRANULE = 16;
+  static const size_t MAX_SMALL_SIZE = 512;
+  static const size_t FIRST_CHUNK_SIZE = 2 * 1024;
+  static const size_t MAX_CHUNK_SIZE = 64 * 1024;
+
+  arena()
+    : current_(nullptr)
+    , end_(nullptr)
+    , nextChunkSize_(FIRST_CHUNK_SIZE)
+    , nAllocatedBytes_(0)
+  {
+    std::fill(freeLists_, freeLists_ + N_SIZE_CLASSES, nullptr);
+  }
+
+  void*
+  allocate(size_t size)
+  {
+    if (size > MAX_SMALL_SIZE) {
+      nAllocatedBytes_ += size;
+      return ::operator new(size);
+    }
+
+    size_t sizeClass = get_size_class(size);
+    free_block* block = freeLists_[sizeClass];
+    if (block != nullptr) {
+      freeLists_[sizeClass] = block->next;
+      return block;
+    }
+
+    size = (sizeClass + 1) * GRANULE;
+    if (static_cast<size_t>(end_ - current_) < size) {
+      add_chunk();
+    }
+    void* p = current_;
+    current_ += size;
+    return p;
+  }
+
+  void
+  deallocate(void* p, size_t size)
+  {
+    if (p == nullptr)
+      return;
+
+    if (size > MAX_SMALL_SIZE) {
+      nAllocatedBytes_ -= size;
+      ::operator delete(p);
+      return;
+    }
+
+    size_t sizeClass = get_size_class(size);
+    free_block* block = static_cast<free_block*>(p);
+    block->next = freeLists_[sizeClass];
+    freeLists_[sizeClass] = block;
+  }
+
+  /**
+   * @brief Get the number of bytes obtained from the system
+   */
+  size_t
+  get_allocated_size() const
+  {
+    return nAllocatedBytes_;
+  }
+
+private:
+  static size_t
+  get_size_class(size_t size)
+  {
+    return size == 0 ? 0 : (size - 1) / GRANULE;
+  }
+
+  void
+  add_chunk()
+  {
+    // the rest of the current chunk is too small for the block, but may serve smaller ones
+    size_t rest = static_cast<size_t>(end_ - current_);
+    if (rest >= GRANULE) {
+      deallocate(current_, rest);
+    }
+
+    size_t size = nextChunkSize_;
+    chunks_.emplace_back(new uint8_t[size]);
+    nAllocatedBytes_ += size;
+    current_ = chunks_.back().get();
+    end_ = current_ + size;
+    nextChunkSize_ = size * 2 < MAX_CHUNK_SIZE ? size * 2 : MAX_CHUNK_SIZE;
+  }
+
+private:
+  struct free_block {
+    free_block* next;
+  };
+
+  static const size_t N_SIZE_CLASSES = MAX_SMALL_SIZE / GRANULE;
+  static_assert(FIRST_CHUNK_SIZE >= MAX_SMALL_SIZE, "a chunk must fit the largest small block");
+
+  std::vector<std::unique_ptr<uint8_t[]>> chunks_;
+  uint8_t* current_;
+  uint8_t* end_;
+  size_t nextChunkSize_;
+  free_block* freeLists_[N_SIZE_CLASSES];
+  size_t nAllocatedBytes_;
+};
+
+} // detail
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // ARENA_H_
@@ -28,16 +28,22 @@ namespace ns3 {
 namespace ndn {
 namespace ndnSIM {
 
-template<typename FullKey, typename PayloadTraits, typename PolicyTraits>
+/**
+ * @brief Trie with a policy that controls which entries are kept
+ *
+ * @tparam Trie backend, either trie or compact_trie
+ */
+template<typename FullKey, typename PayloadTraits, typename PolicyTraits,
+         template<typename, typename, typename> class Trie = trie>
 class trie_with_policy {
 public:
-  typedef trie<FullKey, PayloadTraits, typename PolicyTraits::policy_hook_type> parent_trie;
+  typedef Trie<FullKey, PayloadTraits, typename PolicyTraits::policy_hook_type> parent_trie;
 
   typedef typename parent_trie::iterator iterator;
   typedef typename parent_trie::const_iterator const_iterator;
 
   typedef typename PolicyTraits::
-    template policy<trie_with_policy<FullKey, PayloadTraits, PolicyTraits>, parent_trie,
+    template policy<trie_with_policy<FullKey, PayloadTraits, PolicyTraits, Trie>, parent_trie,
                     typename PolicyTraits::template container_hook<parent_trie>::type>::type
       policy_container;
 
@@ -70,7 +76,8 @@ public:
   inline void
   erase(const FullKey& key)
   {
-    iterator foundItem, lastItem;
+    iterator foundItem;
+    typename parent_trie::position lastItem;
     bool reachLast;
     std::tie(foundItem, reachLast, lastItem) = trie_.find(key);
 
@@ -117,7 +124,8 @@ public:
   inline iterator
   find_exact(const FullKey& key)
   {
-    iterator foundItem, lastItem;
+    iterator foundItem;
+    typename parent_trie::position lastItem;
     bool reachLast;
     std::tie(foundItem, reachLast, lastItem) = trie_.find(key);
 
@@ -133,7 +141,8 @@ public:
   inline iterator
   longest_prefix_match(const FullKey& key)
   {
-    iterator foundItem, lastItem;
+    iterator foundItem;
+    typename parent_trie::position lastItem;
     bool reachLast;
     std::tie(foundItem, reachLast, lastItem) = trie_.find(key);
     if (foundItem != trie_.end()) {
@@ -149,7 +158,8 @@ public:
   inline iterator
   longest_prefix_match_if(const FullKey& key, Predicate pred)
   {
-    iterator foundItem, lastItem;
+    iterator foundItem;
+    typename parent_trie::position lastItem;
     bool reachLast;
     std::tie(foundItem, reachLast, lastItem) = trie_.find_if(key, pred);
     if (foundItem != trie_.end()) {
@@ -174,7 +184,8 @@ public:
   inline iterator
   deepest_prefix_match(const FullKey& key)
   {
-    iterator foundItem, lastItem;
+    iterator foundItem;
+    typename parent_trie::position lastItem;
     bool reachLast;
     std::tie(foundItem, reachLast, lastItem) = trie_.find(key);
 
@@ -184,7 +195,10 @@ public:
 
     if (reachLast) {
       if (foundItem == trie_.end()) {
-        foundItem = lastItem->find(); // should be something
+        foundItem = lastItem->find(); // nothing only if the whole trie is empty
+        if (foundItem == trie_.end()) {
+          return trie_.end();
+        }
       }
       policy_.lookup(s_iterator_to(foundItem));
       return foundItem;
@@ -201,7 +215,8 @@ public:
   inline iterator
   deepest_prefix_match_if(const FullKey& key, Predicate pred)
   {
-    iterator foundItem, lastItem;
+    iterator foundItem;
+    typename parent_trie::position lastItem;
     bool reachLast;
     std::tie(foundItem, reachLast, lastItem) = trie_.find(key);
 
@@ -232,7 +247,8 @@ public:
   inline iterator
   deepest_prefix_match_if_next_level(const FullKey& key, Predicate pred)
   {
-    iterator foundItem, lastItem;
+    iterator foundItem;
+    typename parent_trie::position lastItem;
     bool reachLast;
     std::tie(foundItem, reachLast, lastItem) = trie_.find(key);
 
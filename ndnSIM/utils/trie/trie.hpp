@@ -140,6 +140,8 @@ public:
   typedef trie_point_iterator<trie> point_iterator;
   typedef trie_point_iterator<const trie> const_point_iterator;
 
+  typedef iterator position; ///< @brief where find() stops, always a node
+
   typedef PayloadTraits payload_traits;
 
   inline trie(const Key& key, size_t bucketSize = 1, size_t bucketIncrement = 1)